@@ -704,11 +704,12 @@ _bfd_get_elt_at_filepos (bfd *archive, file_ptr filepos,
 	    }
 	  n_bfd->proxy_origin = bfd_tell (archive);
 
-	  /* Copy BFD_COMPRESS, BFD_DECOMPRESS and BFD_COMPRESS_GABI
-	     flags.  */
+	  /* Copy BFD_COMPRESS, BFD_DECOMPRESS, BFD_COMPRESS_GABI and
+	     BFD_COMPRESS_ZSTD flags.  */
 	  n_bfd->flags |= archive->flags & (BFD_COMPRESS
 					    | BFD_DECOMPRESS
-					    | BFD_COMPRESS_GABI);
+					    | BFD_COMPRESS_GABI
+					    | BFD_COMPRESS_ZSTD);
 
 	  return n_bfd;
 	}
@@ -764,10 +765,12 @@ _bfd_get_elt_at_filepos (bfd *archive, file_ptr filepos,
 
   n_bfd->arelt_data = new_areldata;
 
-  /* Copy BFD_COMPRESS, BFD_DECOMPRESS and BFD_COMPRESS_GABI flags.  */
+  /* Copy BFD_COMPRESS, BFD_DECOMPRESS, BFD_COMPRESS_GABI and
+     BFD_COMPRESS_ZSTD flags.  */
   n_bfd->flags |= archive->flags & (BFD_COMPRESS
 				    | BFD_DECOMPRESS
-				    | BFD_COMPRESS_GABI);
+				    | BFD_COMPRESS_GABI
+				    | BFD_COMPRESS_ZSTD);
 
   /* Copy is_linker_input.  */
   n_bfd->is_linker_input = archive->is_linker_input;
@@ -2271,6 +2274,177 @@ _bfd_write_archive_contents (bfd *arch)
   return false;
 }
 
+/* Whether to warn about LTO objects that need the plugin.  Only the
+   first such object is reported.  */
+static bool report_plugin_err = true;
+
+/* Return TRUE if SYM belongs in an archive symbol map.  */
+
+static bool
+armap_symbol_p (const asymbol *sym)
+{
+  flagword flags = sym->flags;
+  asection *sec = sym->section;
+
+  return (((flags & (BSF_GLOBAL
+		     | BSF_WEAK
+		     | BSF_INDIRECT
+		     | BSF_GNU_UNIQUE)) != 0
+	   || bfd_is_com_section (sec))
+	  && ! bfd_is_und_section (sec));
+}
+
+/*
+FUNCTION
+	bfd_get_armap_names
+
+SYNOPSIS
+	long bfd_get_armap_names
+	  (bfd *member, char **names, size_t *size);
+
+DESCRIPTION
+	Read the symbol table of @var{member}, an element of an
+	archive that is being written, and set *@var{names} to a
+	malloc'd buffer of *@var{size} bytes holding the names of the
+	symbols that belong in the archive symbol map, one after
+	another and each terminated by a NUL.  Return the number of
+	names, which is zero for elements that are not objects, or -1
+	on error.
+*/
+
+long
+bfd_get_armap_names (bfd *current, char **names, size_t *size)
+{
+  asymbol **syms;
+  long storage;
+  long symcount;
+  long src_count;
+  long count = 0;
+  char *buf = NULL;
+  size_t len = 0;
+  size_t max = 0;
+
+  *names = NULL;
+  *size = 0;
+  if (!bfd_check_format (current, bfd_object)
+      || (bfd_get_file_flags (current) & HAS_SYMS) == 0)
+    return 0;
+
+  if (current->lto_slim_object && report_plugin_err)
+    {
+      report_plugin_err = false;
+      _bfd_error_handler
+	(_("%pB: plugin needed to handle lto object"),
+	 current);
+    }
+
+  storage = bfd_get_symtab_upper_bound (current);
+  if (storage < 0)
+    return -1;
+
+  if (storage != 0)
+    {
+      syms = (asymbol **) bfd_malloc (storage);
+      if (syms == NULL)
+	return -1;
+      symcount = bfd_canonicalize_symtab (current, syms);
+      if (symcount < 0)
+	{
+	  free (syms);
+	  return -1;
+	}
+
+      /* Now map over all the symbols, picking out the ones we
+	 want.  */
+      for (src_count = 0; src_count < symcount; src_count++)
+	{
+	  const char *name = syms[src_count]->name;
+	  size_t namelen;
+
+	  if (!armap_symbol_p (syms[src_count]))
+	    continue;
+
+	  if (name != NULL
+	      && name[0] == '_'
+	      && name[1] == '_'
+	      && strcmp (name + (name[2] == '_'), "__gnu_lto_slim") == 0
+	      && report_plugin_err)
+	    {
+	      report_plugin_err = false;
+	      _bfd_error_handler
+		(_("%pB: plugin needed to handle lto object"),
+		 current);
+	    }
+
+	  namelen = strlen (name) + 1;
+	  if (len + namelen > max)
+	    {
+	      char *new_buf;
+
+	      max = max * 2 + namelen;
+	      new_buf = (char *) bfd_realloc (buf, max);
+	      if (new_buf == NULL)
+		{
+		  free (buf);
+		  free (syms);
+		  return -1;
+		}
+	      buf = new_buf;
+	    }
+	  memcpy (buf + len, name, namelen);
+	  len += namelen;
+	  ++count;
+	}
+      free (syms);
+    }
+
+  /* Now ask the BFD to free up any cached information, so we
+     don't fill all of memory with symbol tables.  */
+  if (! bfd_free_cached_info (current))
+    {
+      free (buf);
+      return -1;
+    }
+
+  *names = buf;
+  *size = len;
+  return count;
+}
+
+/*
+FUNCTION
+	bfd_set_armap_names
+
+SYNOPSIS
+	bool bfd_set_armap_names
+	  (bfd *member, const char *names, size_t size, long count);
+
+DESCRIPTION
+	Record the @var{count} names in @var{names}, as returned by
+	<<bfd_get_armap_names>> for @var{member}, so that they are
+	used for the symbol map of the archive containing @var{member}
+	when it is written rather than reading the symbol table of
+	@var{member} again.  This allows the names to be found for
+	many elements at once, in other processes.
+*/
+
+bool
+bfd_set_armap_names (bfd *member, const char *names, size_t size,
+		     long count)
+{
+  char *copy;
+
+  copy = (char *) bfd_malloc (size + 1);
+  if (copy == NULL)
+    return false;
+  memcpy (copy, names, size);
+  copy[size] = '\0';
+  free (member->armap_names);
+  member->armap_names = copy;
+  member->armap_count = count;
+  return true;
+}
+
 /* Note that the namidx for the first symbol is 0.  */
 
 bool
@@ -2283,11 +2457,9 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   unsigned int orl_max = 1024;		/* Fine initial default.  */
   unsigned int orl_count = 0;
   int stridx = 0;
-  asymbol **syms = NULL;
-  long syms_max = 0;
+  char *names = NULL;
   bool ret;
   size_t amt;
-  static bool report_plugin_err = true;
 
   /* Dunno if this is the best place for this info...  */
   if (elength != 0)
@@ -2315,104 +2487,57 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
        current != NULL;
        current = current->archive_next, elt_no++)
     {
-      if (bfd_check_format (current, bfd_object)
-	  && (bfd_get_file_flags (current) & HAS_SYMS) != 0)
-	{
-	  long storage;
-	  long symcount;
-	  long src_count;
+      const char *name;
+      long count;
+      long i;
+      size_t size;
 
-	  if (current->lto_slim_object && report_plugin_err)
-	    {
-	      report_plugin_err = false;
-	      _bfd_error_handler
-		(_("%pB: plugin needed to handle lto object"),
-		 current);
-	    }
-
-	  storage = bfd_get_symtab_upper_bound (current);
-	  if (storage < 0)
+      if (current->armap_names != NULL)
+	{
+	  name = current->armap_names;
+	  count = current->armap_count;
+	}
+      else
+	{
+	  free (names);
+	  count = bfd_get_armap_names (current, &names, &size);
+	  if (count < 0)
 	    goto error_return;
+	  name = names;
+	}
+
+      for (i = 0; i < count; i++)
+	{
+	  bfd_size_type namelen;
+	  struct orl *new_map;
 
-	  if (storage != 0)
+	  /* This symbol will go into the archive header.  */
+	  if (orl_count == orl_max)
 	    {
-	      if (storage > syms_max)
-		{
-		  free (syms);
-		  syms_max = storage;
-		  syms = (asymbol **) bfd_malloc (syms_max);
-		  if (syms == NULL)
-		    goto error_return;
-		}
-	      symcount = bfd_canonicalize_symtab (current, syms);
-	      if (symcount < 0)
+	      orl_max *= 2;
+	      amt = orl_max * sizeof (struct orl);
+	      new_map = (struct orl *) bfd_realloc (map, amt);
+	      if (new_map == NULL)
 		goto error_return;
 
-	      /* Now map over all the symbols, picking out the ones we
-		 want.  */
-	      for (src_count = 0; src_count < symcount; src_count++)
-		{
-		  flagword flags = (syms[src_count])->flags;
-		  asection *sec = syms[src_count]->section;
-
-		  if (((flags & (BSF_GLOBAL
-				 | BSF_WEAK
-				 | BSF_INDIRECT
-				 | BSF_GNU_UNIQUE)) != 0
-		       || bfd_is_com_section (sec))
-		      && ! bfd_is_und_section (sec))
-		    {
-		      bfd_size_type namelen;
-		      struct orl *new_map;
-
-		      /* This symbol will go into the archive header.  */
-		      if (orl_count == orl_max)
-			{
-			  orl_max *= 2;
-			  amt = orl_max * sizeof (struct orl);
-			  new_map = (struct orl *) bfd_realloc (map, amt);
-			  if (new_map == NULL)
-			    goto error_return;
-
-			  map = new_map;
-			}
-
-		      if (syms[src_count]->name != NULL
-			  && syms[src_count]->name[0] == '_'
-			  && syms[src_count]->name[1] == '_'
-			  && strcmp (syms[src_count]->name
-				     + (syms[src_count]->name[2] == '_'),
-				     "__gnu_lto_slim") == 0
-			  && report_plugin_err)
-			{
-			  report_plugin_err = false;
-			  _bfd_error_handler
-			    (_("%pB: plugin needed to handle lto object"),
-			     current);
-			}
-		      namelen = strlen (syms[src_count]->name);
-		      amt = sizeof (char *);
-		      map[orl_count].name = (char **) bfd_alloc (arch, amt);
-		      if (map[orl_count].name == NULL)
-			goto error_return;
-		      *(map[orl_count].name) = (char *) bfd_alloc (arch,
-								   namelen + 1);
-		      if (*(map[orl_count].name) == NULL)
-			goto error_return;
-		      strcpy (*(map[orl_count].name), syms[src_count]->name);
-		      map[orl_count].u.abfd = current;
-		      map[orl_count].namidx = stridx;
-
-		      stridx += namelen + 1;
-		      ++orl_count;
-		    }
-		}
+	      map = new_map;
 	    }
 
-	  /* Now ask the BFD to free up any cached information, so we
-	     don't fill all of memory with symbol tables.  */
-	  if (! bfd_free_cached_info (current))
+	  namelen = strlen (name);
+	  amt = sizeof (char *);
+	  map[orl_count].name = (char **) bfd_alloc (arch, amt);
+	  if (map[orl_count].name == NULL)
 	    goto error_return;
+	  *(map[orl_count].name) = (char *) bfd_alloc (arch, namelen + 1);
+	  if (*(map[orl_count].name) == NULL)
+	    goto error_return;
+	  strcpy (*(map[orl_count].name), name);
+	  map[orl_count].u.abfd = current;
+	  map[orl_count].namidx = stridx;
+
+	  stridx += namelen + 1;
+	  ++orl_count;
+	  name += namelen + 1;
 	}
     }
 
@@ -2420,7 +2545,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   ret = BFD_SEND (arch, write_armap,
 		  (arch, elength, map, orl_count, stridx));
 
-  free (syms);
+  free (names);
   free (map);
   if (first_name != NULL)
     bfd_release (arch, first_name);
@@ -2428,7 +2553,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   return ret;
 
  error_return:
-  free (syms);
+  free (names);
   free (map);
   if (first_name != NULL)
     bfd_release (arch, first_name);
@@ -357,13 +357,23 @@ extern void bfd_hash_traverse
 extern unsigned long bfd_hash_set_default_size (unsigned long);
 
 /* Types of compressed DWARF debug sections.  We currently support
-   zlib.  */
+   zlib and zstd.  */
 enum compressed_debug_section_type
 {
   COMPRESS_DEBUG_NONE = 0,
   COMPRESS_DEBUG = 1 << 0,
   COMPRESS_DEBUG_GNU_ZLIB = COMPRESS_DEBUG | 1 << 1,
-  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2
+  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2,
+  COMPRESS_DEBUG_ZSTD = COMPRESS_DEBUG | 1 << 3
+};
+
+/* Compression algorithms of compressed sections.  The values match
+   the ELFCOMPRESS_* values of the ELF compression header.  */
+enum compression_type
+{
+  ch_none = 0,
+  ch_compress_zlib = 1,
+  ch_compress_zstd = 2
 };
 
 /* This structure is used to keep track of stabs in sections
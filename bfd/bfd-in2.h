@@ -364,13 +364,23 @@ extern void bfd_hash_traverse
 extern unsigned long bfd_hash_set_default_size (unsigned long);
 
 /* Types of compressed DWARF debug sections.  We currently support
-   zlib.  */
+   zlib and zstd.  */
 enum compressed_debug_section_type
 {
   COMPRESS_DEBUG_NONE = 0,
   COMPRESS_DEBUG = 1 << 0,
   COMPRESS_DEBUG_GNU_ZLIB = COMPRESS_DEBUG | 1 << 1,
-  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2
+  COMPRESS_DEBUG_GABI_ZLIB = COMPRESS_DEBUG | 1 << 2,
+  COMPRESS_DEBUG_ZSTD = COMPRESS_DEBUG | 1 << 3
+};
+
+/* Compression algorithms of compressed sections.  The values match
+   the ELFCOMPRESS_* values of the ELF compression header.  */
+enum compression_type
+{
+  ch_none = 0,
+  ch_compress_zlib = 1,
+  ch_compress_zstd = 2
 };
 
 /* This structure is used to keep track of stabs in sections
@@ -6626,17 +6636,21 @@ struct bfd
   /* Put pathnames into archives (non-POSIX).  */
 #define BFD_ARCHIVE_FULL_PATH  0x100000
 
+  /* Compress sections in this BFD with SHF_COMPRESSED zstd.  */
+#define BFD_COMPRESS_ZSTD      0x200000
+
   /* Flags bits to be saved in bfd_preserve_save.  */
 #define BFD_FLAGS_SAVED \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
    | BFD_PLUGIN | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON \
-   | BFD_USE_ELF_STT_COMMON)
+   | BFD_USE_ELF_STT_COMMON | BFD_COMPRESS_ZSTD)
 
   /* Flags bits which are for BFD use only.  */
 #define BFD_FLAGS_FOR_BFD_USE_MASK \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
    | BFD_PLUGIN | BFD_TRADITIONAL_FORMAT | BFD_DETERMINISTIC_OUTPUT \
-   | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON | BFD_USE_ELF_STT_COMMON)
+   | BFD_COMPRESS_GABI | BFD_CONVERT_ELF_COMMON | BFD_USE_ELF_STT_COMMON \
+   | BFD_COMPRESS_ZSTD)
 
   /* The format which belongs to the BFD. (object, core, etc.)  */
   ENUM_BITFIELD (bfd_format) format : 3;
@@ -6823,6 +6837,14 @@ struct bfd
 
   /* For input BFDs, the build ID, if the object has one. */
   const struct bfd_build_id *build_id;
+
+  /* Section contents mapped by bfd_map_section_contents.  */
+  struct bfd_section_mapping *section_mappings;
+
+  /* For archive elements, the names set by bfd_set_armap_names
+     and their number.  */
+  char *armap_names;
+  long armap_count;
 };
 
 static inline const char *
@@ -7254,6 +7276,7 @@ void bfd_update_compression_header
 
 bool bfd_check_compression_header
    (bfd *abfd, bfd_byte *contents, asection *sec,
+    enum compression_type *ch_type,
     bfd_size_type *uncompressed_size,
     unsigned int *uncompressed_alignment_power);
 
@@ -7274,6 +7297,12 @@ bool bfd_set_archive_head (bfd *output, bfd *new_head);
 
 bfd *bfd_openr_next_archived_file (bfd *archive, bfd *previous);
 
+long bfd_get_armap_names
+   (bfd *member, char **names, size_t *size);
+
+bool bfd_set_armap_names
+   (bfd *member, const char *names, size_t size, long count);
+
 /* Extracted from corefile.c.  */
 const char *bfd_core_file_failing_command (bfd *abfd);
 
@@ -7925,11 +7954,18 @@ bool bfd_get_full_section_contents
 void bfd_cache_section_contents
    (asection *sec, void *contents);
 
+bool bfd_map_section_contents
+   (bfd *abfd, asection *section, bfd_byte **buf);
+
+void bfd_unmap_section_contents
+   (bfd *abfd, asection *section, bfd_byte *buf);
+
 bool bfd_is_section_compressed_with_header
    (bfd *abfd, asection *section,
     int *compression_header_size_p,
     bfd_size_type *uncompressed_size_p,
-    unsigned int *uncompressed_alignment_power_p);
+    unsigned int *uncompressed_alignment_power_p,
+    enum compression_type *ch_type_p);
 
 bool bfd_is_section_compressed
    (bfd *abfd, asection *section);
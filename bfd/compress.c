@@ -20,14 +20,22 @@
 
 #include "sysdep.h"
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "bfd.h"
 #include "libbfd.h"
 #include "safe-ctype.h"
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 #define MAX_COMPRESSION_HEADER_SIZE 24
 
 static bool
-decompress_contents (bfd_byte *compressed_buffer,
+decompress_contents (enum compression_type ch_type,
+		     bfd_byte *compressed_buffer,
 		     bfd_size_type compressed_size,
 		     bfd_byte *uncompressed_buffer,
 		     bfd_size_type uncompressed_size)
@@ -35,6 +43,18 @@ decompress_contents (bfd_byte *compressed_buffer,
   z_stream strm;
   int rc;
 
+  if (ch_type == ch_compress_zstd)
+    {
+#ifdef HAVE_ZSTD
+      /* ZSTD_decompress copes with several concatenated frames.  */
+      size_t ret = ZSTD_decompress (uncompressed_buffer, uncompressed_size,
+				    compressed_buffer, compressed_size);
+      return !ZSTD_isError (ret) && ret == uncompressed_size;
+#else
+      return false;
+#endif
+    }
+
   /* It is possible the section consists of several compressed
      buffers concatenated together, so we uncompress in a loop.  */
   /* PR 18313: The state field in the z_stream structure is supposed
@@ -68,9 +88,52 @@ decompress_contents (bfd_byte *compressed_buffer,
   return inflateEnd (&strm) == Z_OK && rc == Z_OK && strm.avail_out == 0;
 }
 
+/* Compress UNCOMPRESSED_SIZE bytes at UNCOMPRESSED_BUFFER with
+   CH_TYPE into COMPRESSED_BUFFER, which has room for *COMPRESSED_SIZE
+   bytes.  Set *COMPRESSED_SIZE to the compressed size on success.  */
+
+static bool
+compress_contents (enum compression_type ch_type,
+		   bfd_byte *compressed_buffer,
+		   uLong *compressed_size,
+		   bfd_byte *uncompressed_buffer,
+		   bfd_size_type uncompressed_size)
+{
+  if (ch_type == ch_compress_zstd)
+    {
+#ifdef HAVE_ZSTD
+      size_t ret = ZSTD_compress (compressed_buffer, *compressed_size,
+				  uncompressed_buffer, uncompressed_size,
+				  ZSTD_CLEVEL_DEFAULT);
+      if (ZSTD_isError (ret))
+	return false;
+      *compressed_size = ret;
+      return true;
+#else
+      return false;
+#endif
+    }
+
+  return compress ((Bytef *) compressed_buffer, compressed_size,
+		   (const Bytef *) uncompressed_buffer,
+		   uncompressed_size) == Z_OK;
+}
+
+/* Return the compression algorithm to use for sections of ABFD.
+   zstd is only used with the SHF_COMPRESSED format.  */
+
+static enum compression_type
+bfd_compression_type (bfd *abfd)
+{
+  if ((abfd->flags & (BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD))
+      == (BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD))
+    return ch_compress_zstd;
+  return ch_compress_zlib;
+}
+
 /* Compress data of the size specified in @var{uncompressed_size}
-   and pointed to by @var{uncompressed_buffer} using zlib and store
-   as the contents field.  This function assumes the contents
+   and pointed to by @var{uncompressed_buffer} using zlib or zstd and
+   store as the contents field.  This function assumes the contents
    field was allocated using bfd_malloc() or equivalent.
 
    Return the uncompressed size if the full section contents is
@@ -89,18 +152,50 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
   int orig_compression_header_size;
   bfd_size_type orig_uncompressed_size;
   unsigned int orig_uncompressed_alignment_pow;
+  enum compression_type orig_ch_type;
+  enum compression_type ch_type = bfd_compression_type (abfd);
   int header_size = bfd_get_compression_header_size (abfd, NULL);
   bool compressed
     = bfd_is_section_compressed_with_header (abfd, sec,
 					     &orig_compression_header_size,
 					     &orig_uncompressed_size,
-					     &orig_uncompressed_alignment_pow);
+					     &orig_uncompressed_alignment_pow,
+					     &orig_ch_type);
 
   /* Either ELF compression header or the 12-byte, "ZLIB" + 8-byte size,
      overhead in .zdebug* section.  */
   if (!header_size)
      header_size = 12;
 
+  /* Changing the compression algorithm means decompressing the
+     section and compressing it again.  */
+  if (compressed
+      && orig_compression_header_size >= 0
+      && orig_ch_type != ch_type)
+    {
+      int orig_header_size = (orig_compression_header_size != 0
+			      ? orig_compression_header_size : 12);
+
+      buffer = (bfd_byte *) bfd_malloc (orig_uncompressed_size);
+      if (buffer == NULL)
+	return 0;
+      if (!decompress_contents (orig_ch_type,
+				uncompressed_buffer + orig_header_size,
+				uncompressed_size - orig_header_size,
+				buffer, orig_uncompressed_size))
+	{
+	  bfd_set_error (bfd_error_bad_value);
+	  free (buffer);
+	  return 0;
+	}
+      free (uncompressed_buffer);
+      uncompressed_buffer = buffer;
+      uncompressed_size = orig_uncompressed_size;
+      sec->size = uncompressed_size;
+      bfd_set_section_alignment (sec, orig_uncompressed_alignment_pow);
+      compressed = false;
+    }
+
   if (compressed)
     {
       /* We shouldn't decompress unsupported compressed section.  */
@@ -127,6 +222,10 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
       /* Add the header size.  */
       compressed_size = zlib_size + header_size;
     }
+#ifdef HAVE_ZSTD
+  else if (ch_type == ch_compress_zstd)
+    compressed_size = ZSTD_compressBound (uncompressed_size) + header_size;
+#endif
   else
     compressed_size = compressBound (uncompressed_size) + header_size;
 
@@ -150,7 +249,8 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
       sec->size = orig_uncompressed_size;
       if (decompress)
 	{
-	  if (!decompress_contents (uncompressed_buffer
+	  if (!decompress_contents (orig_ch_type,
+				    uncompressed_buffer
 				    + orig_compression_header_size,
 				    zlib_size, buffer, buffer_size))
 	    {
@@ -175,10 +275,10 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec,
     }
   else
     {
-      if (compress ((Bytef*) buffer + header_size,
-		    &compressed_size,
-		    (const Bytef*) uncompressed_buffer,
-		    uncompressed_size) != Z_OK)
+      compressed_size -= header_size;
+      if (!compress_contents (ch_type, buffer + header_size,
+			      &compressed_size, uncompressed_buffer,
+			      uncompressed_size))
 	{
 	  bfd_release (abfd, buffer);
 	  bfd_set_error (bfd_error_bad_value);
@@ -237,6 +337,9 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
   bfd_size_type save_rawsize;
   bfd_byte *compressed_buffer;
   unsigned int compression_header_size;
+  enum compression_type ch_type;
+  bfd_size_type uncompressed_size;
+  unsigned int uncompressed_alignment_power;
 
   if (abfd->direction != write_direction && sec->rawsize != 0)
     sz = sec->rawsize;
@@ -326,12 +429,20 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
 	goto fail_compressed;
 
       compression_header_size = bfd_get_compression_header_size (abfd, sec);
+      ch_type = ch_compress_zlib;
       if (compression_header_size == 0)
 	/* Set header size to the zlib header size if it is a
 	   SHF_COMPRESSED section.  */
 	compression_header_size = 12;
-      if (!decompress_contents (compressed_buffer + compression_header_size,
-				sec->compressed_size - compression_header_size, p, sz))
+      else if (!bfd_check_compression_header (abfd, compressed_buffer, sec,
+					      &ch_type, &uncompressed_size,
+					      &uncompressed_alignment_power))
+	ch_type = ch_none;
+      if (ch_type == ch_none
+	  || !decompress_contents (ch_type,
+				   compressed_buffer + compression_header_size,
+				   sec->compressed_size - compression_header_size,
+				   p, sz))
 	{
 	  bfd_set_error (bfd_error_bad_value);
 	  if (p != *ptr)
@@ -365,6 +476,44 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
     }
 }
 
+/* A read-only mapping of section contents handed out by
+   bfd_map_section_contents.  These are chained off the owning BFD.  */
+
+struct bfd_section_mapping
+{
+  struct bfd_section_mapping *next;
+
+  /* The section, and its contents within the mapping.  */
+  asection *section;
+  bfd_byte *contents;
+
+  /* The page aligned mapping, as returned by bfd_mmap.  */
+  void *map_addr;
+  bfd_size_type map_len;
+
+  /* The number of users of CONTENTS, counting the section itself
+     if the contents were passed to bfd_cache_section_contents.  */
+  unsigned int refcount;
+};
+
+/* Sections smaller than this many pages are read into a malloc'd
+   buffer rather than mapped, so as not to waste address space on
+   mostly empty pages.  */
+#define SECTION_MAPPING_MIN_PAGES 4
+
+/* Return the live mapping of SEC's contents, or NULL.  */
+
+static struct bfd_section_mapping *
+find_section_mapping (const asection *sec)
+{
+  struct bfd_section_mapping *m;
+
+  for (m = sec->owner->section_mappings; m != NULL; m = m->next)
+    if (m->section == sec)
+      return m;
+  return NULL;
+}
+
 /*
 FUNCTION
 	bfd_cache_section_contents
@@ -375,18 +524,185 @@ SYNOPSIS
 
 DESCRIPTION
 	Stash @var(contents) so any following reads of @var(sec) do
-	not need to decompress again.
+	not need to decompress again.  @var(contents) may be a buffer
+	returned by <<bfd_map_section_contents>>, in which case the
+	mapping is kept until the BFD is closed.
 */
 
 void
 bfd_cache_section_contents (asection *sec, void *contents)
 {
+  struct bfd_section_mapping *m;
+
   if (sec->compress_status == DECOMPRESS_SECTION_SIZED)
     sec->compress_status = COMPRESS_SECTION_DONE;
+  /* Mapped contents must stay mapped for as long as they are cached,
+     so the section takes a reference of its own.  */
+  if (sec->contents != contents
+      && (m = find_section_mapping (sec)) != NULL
+      && m->contents == contents)
+    m->refcount++;
   sec->contents = contents;
   sec->flags |= SEC_IN_MEMORY;
 }
 
+/*
+FUNCTION
+	bfd_map_section_contents
+
+SYNOPSIS
+	bool bfd_map_section_contents
+	  (bfd *abfd, asection *section, bfd_byte **buf);
+
+DESCRIPTION
+	Like <<bfd_malloc_and_get_section>>, but where possible set
+	*@var{buf} to point into a read-only memory mapping of the file
+	rather than to a malloc'd copy of the contents.  Only large,
+	uncompressed sections of file-backed BFDs opened for reading
+	are mapped; anything else is read into a malloc'd buffer as
+	usual.  If @var{section} already has contents in memory, see
+	<<bfd_cache_section_contents>>, those are returned instead.
+
+	Mappings are reference counted, so that repeated calls for the
+	same section share one mapping.  The contents must not be
+	modified, and must be released with
+	<<bfd_unmap_section_contents>> rather than <<free>>.  Any
+	mappings still live when @var{abfd} is closed are released then.
+*/
+
+bool
+bfd_map_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **buf)
+{
+#ifdef HAVE_MMAP
+  static bfd_size_type pagesize;
+  struct bfd_section_mapping *m;
+  bfd_size_type sz;
+  ufile_ptr filesize;
+  void *map_addr;
+  bfd_size_type map_len;
+  void *data;
+
+  *buf = NULL;
+  if (abfd->direction != read_direction
+      || (abfd->flags & BFD_IN_MEMORY) != 0)
+    return bfd_malloc_and_get_section (abfd, sec, buf);
+
+  m = find_section_mapping (sec);
+  if (m != NULL)
+    {
+      m->refcount++;
+      *buf = m->contents;
+      return true;
+    }
+
+  if ((sec->flags & SEC_IN_MEMORY) != 0 && sec->contents != NULL)
+    {
+      *buf = sec->contents;
+      return true;
+    }
+
+  if (pagesize == 0)
+    pagesize = getpagesize ();
+
+  sz = sec->rawsize != 0 ? sec->rawsize : sec->size;
+  filesize = bfd_get_file_size (abfd);
+  if (sec->compress_status != COMPRESS_SECTION_NONE
+      || (sec->flags & (SEC_HAS_CONTENTS | SEC_CONSTRUCTOR)) != SEC_HAS_CONTENTS
+      /* Only the generic reader takes the contents straight from
+	 the file at the section's file position.  */
+      || (abfd->xvec->_bfd_get_section_contents
+	  != _bfd_generic_get_section_contents)
+      || sz < SECTION_MAPPING_MIN_PAGES * pagesize
+      || filesize == 0
+      || (ufile_ptr) sec->filepos > filesize
+      || sz > filesize - sec->filepos)
+    return bfd_malloc_and_get_section (abfd, sec, buf);
+
+  m = (struct bfd_section_mapping *) bfd_malloc (sizeof (*m));
+  if (m == NULL)
+    return false;
+  data = bfd_mmap (abfd, NULL, sz, PROT_READ, MAP_PRIVATE, sec->filepos,
+		   &map_addr, &map_len);
+  if (data == MAP_FAILED)
+    {
+      /* Not every iovec supports mapping, so just read instead.  */
+      free (m);
+      return bfd_malloc_and_get_section (abfd, sec, buf);
+    }
+
+  m->section = sec;
+  m->contents = (bfd_byte *) data;
+  m->map_addr = map_addr;
+  m->map_len = map_len;
+  m->refcount = 1;
+  m->next = abfd->section_mappings;
+  abfd->section_mappings = m;
+  *buf = m->contents;
+  return true;
+#else
+  return bfd_malloc_and_get_section (abfd, sec, buf);
+#endif
+}
+
+/*
+FUNCTION
+	bfd_unmap_section_contents
+
+SYNOPSIS
+	void bfd_unmap_section_contents
+	  (bfd *abfd, asection *section, bfd_byte *buf);
+
+DESCRIPTION
+	Release contents @var{buf} of @var{section} obtained from
+	<<bfd_map_section_contents>>.  The mapping is removed when its
+	last user releases it; a malloc'd buffer is freed, unless it
+	has since been passed to <<bfd_cache_section_contents>>.
+*/
+
+void
+bfd_unmap_section_contents (bfd *abfd, sec_ptr sec, bfd_byte *buf)
+{
+  struct bfd_section_mapping **pm, *m;
+
+  if (buf == NULL)
+    return;
+
+  for (pm = &abfd->section_mappings; (m = *pm) != NULL; pm = &m->next)
+    if (m->section == sec && m->contents == buf)
+      {
+	if (--m->refcount == 0)
+	  {
+#ifdef HAVE_MMAP
+	    munmap (m->map_addr, m->map_len);
+#endif
+	    *pm = m->next;
+	    free (m);
+	  }
+	return;
+      }
+
+  if (buf != sec->contents)
+    free (buf);
+}
+
+/* Release all section contents mappings of ABFD, on closing it.  */
+
+void
+_bfd_free_section_mappings (bfd *abfd)
+{
+  struct bfd_section_mapping *m, *next;
+
+  for (m = abfd->section_mappings; m != NULL; m = next)
+    {
+      next = m->next;
+#ifdef HAVE_MMAP
+      munmap (m->map_addr, m->map_len);
+#endif
+      free (m);
+    }
+  abfd->section_mappings = NULL;
+}
+
 /*
 FUNCTION
 	bfd_is_section_compressed_with_header
@@ -396,14 +712,16 @@ SYNOPSIS
 	  (bfd *abfd, asection *section,
 	  int *compression_header_size_p,
 	  bfd_size_type *uncompressed_size_p,
-	  unsigned int *uncompressed_alignment_power_p);
+	  unsigned int *uncompressed_alignment_power_p,
+	  enum compression_type *ch_type_p);
 
 DESCRIPTION
 	Return @code{TRUE} if @var{section} is compressed.  Compression
 	header size is returned in @var{compression_header_size_p},
-	uncompressed size is returned in @var{uncompressed_size_p}
-	and the uncompressed data alignement power is returned in
-	@var{uncompressed_align_pow_p}.  If compression is
+	uncompressed size is returned in @var{uncompressed_size_p},
+	the uncompressed data alignement power is returned in
+	@var{uncompressed_align_pow_p} and the compression algorithm
+	is returned in @var{ch_type_p}.  If compression is
 	unsupported, compression header size is returned with -1
 	and uncompressed size is returned with 0.
 */
@@ -412,7 +730,8 @@ bool
 bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
 				       int *compression_header_size_p,
 				       bfd_size_type *uncompressed_size_p,
-				       unsigned int *uncompressed_align_pow_p)
+				       unsigned int *uncompressed_align_pow_p,
+				       enum compression_type *ch_type_p)
 {
   bfd_byte header[MAX_COMPRESSION_HEADER_SIZE];
   int compression_header_size;
@@ -421,6 +740,7 @@ bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
   bool compressed;
 
   *uncompressed_align_pow_p = 0;
+  *ch_type_p = ch_none;
 
   compression_header_size = bfd_get_compression_header_size (abfd, sec);
   if (compression_header_size > MAX_COMPRESSION_HEADER_SIZE)
@@ -448,7 +768,7 @@ bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
     {
       if (compression_header_size != 0)
 	{
-	  if (!bfd_check_compression_header (abfd, header, sec,
+	  if (!bfd_check_compression_header (abfd, header, sec, ch_type_p,
 					     uncompressed_size_p,
 					     uncompressed_align_pow_p))
 	    compression_header_size = -1;
@@ -461,7 +781,10 @@ bfd_is_section_compressed_with_header (bfd *abfd, sec_ptr sec,
 	       && ISPRINT (header[4]))
 	compressed = false;
       else
-	*uncompressed_size_p = bfd_getb64 (header + 4);
+	{
+	  *uncompressed_size_p = bfd_getb64 (header + 4);
+	  *ch_type_p = ch_compress_zlib;
+	}
     }
 
   /* Restore compress_status.  */
@@ -488,10 +811,12 @@ bfd_is_section_compressed (bfd *abfd, sec_ptr sec)
   int compression_header_size;
   bfd_size_type uncompressed_size;
   unsigned int uncompressed_align_power;
+  enum compression_type ch_type;
   return (bfd_is_section_compressed_with_header (abfd, sec,
 						 &compression_header_size,
 						 &uncompressed_size,
-						 &uncompressed_align_power)
+						 &uncompressed_align_power,
+						 &ch_type)
 	  && compression_header_size >= 0
 	  && uncompressed_size > 0);
 }
@@ -521,6 +846,7 @@ bfd_init_section_decompress_status (bfd *abfd, sec_ptr sec)
   int header_size;
   bfd_size_type uncompressed_size;
   unsigned int uncompressed_alignment_power = 0;
+  enum compression_type ch_type;
   z_stream strm;
 
   compression_header_size = bfd_get_compression_header_size (abfd, sec);
@@ -549,13 +875,24 @@ bfd_init_section_decompress_status (bfd *abfd, sec_ptr sec)
 	}
       uncompressed_size = bfd_getb64 (header + 4);
     }
-  else if (!bfd_check_compression_header (abfd, header, sec,
+  else if (!bfd_check_compression_header (abfd, header, sec, &ch_type,
 					  &uncompressed_size,
 					  &uncompressed_alignment_power))
     {
       bfd_set_error (bfd_error_wrong_format);
       return false;
     }
+#ifndef HAVE_ZSTD
+  else if (ch_type == ch_compress_zstd)
+    {
+      _bfd_error_handler
+	/* xgettext:c-format */
+	(_("%pB(%pA): zstd compressed section, but BFD was built without zstd support"),
+	 abfd, sec);
+      bfd_set_error (bfd_error_wrong_format);
+      return false;
+    }
+#endif
 
   /* PR28530, reject sizes unsupported by decompress_contents.  */
   strm.avail_in = sec->size;
@@ -699,6 +699,13 @@ struct elf_link_hash_table
   /* Small local sym cache.  */
   struct sym_cache sym_cache;
 
+  /* Sections marked by _bfd_elf_gc_mark whose references have yet to
+     be followed.  GC_WORKLIST is non-NULL only while the outermost
+     _bfd_elf_gc_mark call is running.  */
+  struct elf_gc_work *gc_worklist;
+  size_t gc_worklist_count;
+  size_t gc_worklist_alloc;
+
   /* Short-cuts to get to dynamic linker sections.  */
   asection *sgot;
   asection *sgotplt;
@@ -1717,6 +1724,13 @@ struct elf_backend_data
   /* True if the 64-bit Linux PRPSINFO structure's `pr_uid' and `pr_gid'
      members use a 16-bit data type.  */
   unsigned linux_prpsinfo64_ugid16 : 1;
+
+  /* True if elf_backend_relocate_section may be called for several
+     input sections at once, from different threads.  It must then
+     only modify the section contents and relocs it is given, report
+     problems through the link callbacks or _bfd_error_handler, and
+     never return 2 for a final link that does not emit relocs.  */
+  unsigned can_relocate_in_parallel : 1;
 };
 
 /* Information about reloc sections associated with a bfd_elf_section_data
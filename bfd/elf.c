@@ -1203,11 +1203,13 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
       int compression_header_size;
       bfd_size_type uncompressed_size;
       unsigned int uncompressed_align_power;
+      enum compression_type ch_type;
       bool compressed
 	= bfd_is_section_compressed_with_header (abfd, newsect,
 						 &compression_header_size,
 						 &uncompressed_size,
-						 &uncompressed_align_power);
+						 &uncompressed_align_power,
+						 &ch_type);
       if (compressed)
 	{
 	  /* Compressed section.  Check if we should decompress.  */
@@ -1225,7 +1227,9 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
 	      && uncompressed_size > 0
 	      && (!compressed
 		  || ((compression_header_size > 0)
-		      != ((abfd->flags & BFD_COMPRESS_GABI) != 0))))
+		      != ((abfd->flags & BFD_COMPRESS_GABI) != 0))
+		  || ((ch_type == ch_compress_zstd)
+		      != ((abfd->flags & BFD_COMPRESS_ZSTD) != 0))))
 	    action = compress;
 	  else
 	    return true;
@@ -532,6 +532,7 @@ brew_elf_check_relocs(
 
 #define elf_backend_can_gc_sections      1
 #define elf_backend_rela_normal          1
+#define elf_backend_can_relocate_in_parallel 1
 
 #define bfd_elf32_bfd_reloc_type_lookup  brew_reloc_type_lookup
 #define bfd_elf32_bfd_reloc_name_lookup  brew_reloc_name_lookup
@@ -8695,8 +8695,55 @@ struct elf_final_link_info
   size_t filesym_count;
   /* Local symbol hash table.  */
   struct bfd_hash_table local_hash_table;
+  /* True if the relocation of input sections may be deferred, to be
+     done in parallel by elf_link_relocate_deferred.  */
+  bool parallel_relocate;
+  /* The deferred sections.  */
+  struct elf_reloc_job *reloc_jobs;
+  size_t reloc_job_count;
+  size_t reloc_job_alloc;
+  /* Total size of the section contents held by RELOC_JOBS.  */
+  bfd_size_type reloc_job_size;
+  /* While the deferred sections are relocated, the index in RELOC_JOBS
+     of the first section of each input BFD, followed by
+     RELOC_JOB_COUNT.  */
+  size_t *reloc_job_groups;
+  /* Copies of the local symbols of the input BFD being processed, and
+     of their sections, shared by its deferred sections.  */
+  Elf_Internal_Sym *reloc_job_syms;
+  asection **reloc_job_sections;
 };
 
+/* An input section whose relocation elf_link_input_bfd has deferred,
+   so that many sections can be relocated in parallel.  Everything
+   relocate_section needs is private to the job, except for the local
+   symbols, which are shared by the jobs of one input BFD.  Those jobs
+   also share the sections of the input BFD, which relocate_section
+   may write to, for instance the kept_section of a merged section
+   set by _bfd_elf_rela_local_sym, so they are run in turn by a single
+   thread.  */
+
+struct elf_reloc_job
+{
+  bfd *input_bfd;
+  asection *section;
+  bfd_byte *contents;
+  Elf_Internal_Rela *relocs;
+  Elf_Internal_Sym *local_syms;
+  asection **local_sections;
+  /* Which of the above were allocated for this job.  */
+  bool free_contents;
+  bool free_relocs;
+  bool free_syms;
+  /* The value returned by relocate_section.  */
+  int ret;
+};
+
+/* Once this much section contents is held by deferred sections, they
+   are relocated and written out before moving on to the next input
+   BFD.  */
+#define ELF_RELOC_JOB_LIMIT (64 * 1024 * 1024)
+
 struct local_hash_entry
 {
   /* Base hash table entry structure.  */
@@ -10992,6 +11039,207 @@ _bfd_elf_check_kept_section (asection *sec, struct bfd_link_info *info)
   return kept;
 }
 
+/* Defer the relocation of section O of INPUT_BFD, whose contents and
+   relocs have been read into CONTENTS and RELOCS and whose local
+   symbols are ISYMBUF[0..LOCSYMCOUNT-1].  Anything that lives in the
+   buffers of FLINFO, which are reused for the next section, is
+   copied.  */
+
+static bool
+elf_link_defer_relocate (struct elf_final_link_info *flinfo,
+			 bfd *input_bfd, asection *o, bfd_byte *contents,
+			 Elf_Internal_Rela *relocs, Elf_Internal_Sym *isymbuf,
+			 size_t locsymcount)
+{
+  struct elf_reloc_job *job;
+  bfd_size_type size;
+
+  if (flinfo->reloc_job_count == flinfo->reloc_job_alloc)
+    {
+      size_t alloc = flinfo->reloc_job_alloc * 2 + 16;
+
+      job = (struct elf_reloc_job *) bfd_realloc (flinfo->reloc_jobs,
+						  alloc * sizeof (*job));
+      if (job == NULL)
+	return false;
+      flinfo->reloc_jobs = job;
+      flinfo->reloc_job_alloc = alloc;
+    }
+
+  job = flinfo->reloc_jobs + flinfo->reloc_job_count;
+  memset (job, 0, sizeof (*job));
+  job->input_bfd = input_bfd;
+  job->section = o;
+
+  size = o->rawsize > o->size ? o->rawsize : o->size;
+  job->contents = contents;
+  if (contents == flinfo->contents)
+    {
+      job->contents = (bfd_byte *) bfd_malloc (size);
+      if (job->contents == NULL)
+	return false;
+      memcpy (job->contents, contents, size);
+      job->free_contents = true;
+    }
+
+  job->relocs = relocs;
+  if (relocs == flinfo->internal_relocs)
+    {
+      bfd_size_type amt = o->reloc_count * sizeof (Elf_Internal_Rela);
+
+      job->relocs = (Elf_Internal_Rela *) bfd_malloc (amt);
+      if (job->relocs == NULL)
+	{
+	  if (job->free_contents)
+	    free (job->contents);
+	  return false;
+	}
+      memcpy (job->relocs, relocs, amt);
+      job->free_relocs = true;
+    }
+
+  if (flinfo->reloc_job_syms == NULL && locsymcount != 0)
+    {
+      Elf_Internal_Sym *syms;
+      asection **sections;
+
+      syms = (Elf_Internal_Sym *) bfd_malloc (locsymcount * sizeof (*syms));
+      sections = (asection **) bfd_malloc (locsymcount * sizeof (*sections));
+      if (syms == NULL || sections == NULL)
+	{
+	  free (syms);
+	  free (sections);
+	  if (job->free_contents)
+	    free (job->contents);
+	  if (job->free_relocs)
+	    free (job->relocs);
+	  return false;
+	}
+      memcpy (syms, isymbuf, locsymcount * sizeof (*syms));
+      memcpy (sections, flinfo->sections, locsymcount * sizeof (*sections));
+      flinfo->reloc_job_syms = syms;
+      flinfo->reloc_job_sections = sections;
+      job->free_syms = true;
+    }
+  job->local_syms = flinfo->reloc_job_syms;
+  job->local_sections = flinfo->reloc_job_sections;
+
+  flinfo->reloc_job_count++;
+  flinfo->reloc_job_size += size;
+  return true;
+}
+
+/* Relocate the deferred sections of the I'th input BFD of DATA, an
+   elf_final_link_info, in the order in which they were deferred.
+   This runs on a thread of the linker's choosing.  */
+
+static void
+elf_link_relocate_job (void *data, size_t i)
+{
+  struct elf_final_link_info *flinfo = (struct elf_final_link_info *) data;
+  size_t *groups = flinfo->reloc_job_groups;
+  struct elf_reloc_job *job = flinfo->reloc_jobs + groups[i];
+  struct elf_reloc_job *end = flinfo->reloc_jobs + groups[i + 1];
+  const struct elf_backend_data *bed
+    = get_elf_backend_data (flinfo->output_bfd);
+
+  for (; job < end; job++)
+    job->ret = (*bed->elf_backend_relocate_section) (flinfo->output_bfd,
+						     flinfo->info,
+						     job->input_bfd,
+						     job->section,
+						     job->contents,
+						     job->relocs,
+						     job->local_syms,
+						     job->local_sections);
+}
+
+/* Free the deferred sections of FLINFO.  */
+
+static void
+elf_link_free_reloc_jobs (struct elf_final_link_info *flinfo)
+{
+  struct elf_reloc_job *job, *end;
+
+  end = flinfo->reloc_jobs + flinfo->reloc_job_count;
+  for (job = flinfo->reloc_jobs; job < end; job++)
+    {
+      if (job->free_contents)
+	free (job->contents);
+      if (job->free_relocs)
+	free (job->relocs);
+      if (job->free_syms)
+	{
+	  free (job->local_syms);
+	  free (job->local_sections);
+	}
+    }
+  flinfo->reloc_job_count = 0;
+  flinfo->reloc_job_size = 0;
+  flinfo->reloc_job_syms = NULL;
+  flinfo->reloc_job_sections = NULL;
+}
+
+/* Relocate the sections deferred by elf_link_input_bfd in parallel,
+   then write them out in the order in which they were deferred, so
+   that the output does not depend on the number of threads.  */
+
+static bool
+elf_link_relocate_deferred (struct elf_final_link_info *flinfo)
+{
+  bfd *output_bfd = flinfo->output_bfd;
+  struct elf_reloc_job *job, *end;
+  size_t *groups;
+  size_t i, ngroups;
+  bool ret = true;
+
+  if (flinfo->reloc_job_count == 0)
+    return true;
+
+  /* The sections of each input BFD were deferred one after the
+     other.  */
+  groups = (size_t *) bfd_malloc ((flinfo->reloc_job_count + 1)
+				  * sizeof (*groups));
+  if (groups == NULL)
+    {
+      elf_link_free_reloc_jobs (flinfo);
+      return false;
+    }
+  ngroups = 0;
+  job = flinfo->reloc_jobs;
+  for (i = 0; i < flinfo->reloc_job_count; i++)
+    if (i == 0 || job[i].input_bfd != job[i - 1].input_bfd)
+      groups[ngroups++] = i;
+  groups[ngroups] = flinfo->reloc_job_count;
+
+  flinfo->reloc_job_groups = groups;
+  flinfo->info->callbacks->parallel_for (flinfo->info, elf_link_relocate_job,
+					 flinfo, ngroups);
+  flinfo->reloc_job_groups = NULL;
+  free (groups);
+
+  end = flinfo->reloc_jobs + flinfo->reloc_job_count;
+  for (job = flinfo->reloc_jobs; job < end; job++)
+    {
+      asection *o = job->section;
+      file_ptr offset;
+
+      BFD_ASSERT (job->ret != 2);
+      offset = (file_ptr) o->output_offset;
+      offset *= bfd_octets_per_byte (output_bfd, o);
+      if (!job->ret
+	  || !bfd_set_section_contents (output_bfd, o->output_section,
+					job->contents, offset, o->size))
+	{
+	  ret = false;
+	  break;
+	}
+    }
+
+  elf_link_free_reloc_jobs (flinfo);
+  return ret;
+}
+
 /* Link an input file into the linker output file.  This function
    handles all the sections and relocations of the input file at once.
    This is so that we only have to read the local symbols once, and
@@ -11030,6 +11278,11 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
   if ((input_bfd->flags & DYNAMIC) != 0)
     return true;
 
+  /* Sections of this BFD deferred for parallel relocation need their
+     own copy of its local symbols.  */
+  flinfo->reloc_job_syms = NULL;
+  flinfo->reloc_job_sections = NULL;
+
   symtab_hdr = &elf_tdata (input_bfd)->symtab_hdr;
   if (elf_bad_symtab (input_bfd))
     {
@@ -11377,6 +11630,19 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 	  Elf_Internal_Rela *rel, *relend;
 	  int action_discarded;
 	  int ret;
+	  bool defer;
+
+	  /* Sections that are simply relocated and copied to the output
+	     may have that done in parallel with other sections.  The
+	     strings of the local symbols are read now, as reading them
+	     is not thread safe.  */
+	  defer = (flinfo->parallel_relocate
+		   && o->sec_info_type == SEC_INFO_TYPE_NONE
+		   && (o->flags & (SEC_EXCLUDE | SEC_ELF_REVERSE_COPY)) == 0
+		   && (locsymcount == 0
+		       || bfd_elf_string_from_elf_section (input_bfd,
+							   symtab_hdr->sh_link,
+							   0) != NULL));
 
 	  /* Get the swapped relocs.  */
 	  internal_relocs
@@ -11490,6 +11756,12 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 			  (unsigned long) rel->r_info,
 			  (unsigned long) rel->r_offset);
 #endif
+		  /* Setting the symbol value below must not affect
+		     sections deferred earlier.  */
+		  if (!elf_link_relocate_deferred (flinfo))
+		    return false;
+		  defer = false;
+
 		  if (!eval_symbol (&val, &sym_name, input_bfd, flinfo, dot,
 				    isymbuf, locsymcount, s_type == STT_SRELC))
 		    return false;
@@ -11528,6 +11800,8 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 							      flinfo->info);
 			  if (kept != NULL)
 			    {
+			      if (!elf_link_relocate_deferred (flinfo))
+				return false;
 			      *ps = kept;
 			      continue;
 			    }
@@ -11556,6 +11830,15 @@ elf_link_input_bfd (struct elf_final_link_info *flinfo, bfd *input_bfd)
 	     corresponding to the output section, which will require
 	     the addend to be adjusted.  */
 
+	  if (defer)
+	    {
+	      if (!elf_link_defer_relocate (flinfo, input_bfd, o, contents,
+					    internal_relocs, isymbuf,
+					    locsymcount))
+		return false;
+	      continue;
+	    }
+
 	  ret = (*relocate_section) (output_bfd, flinfo->info,
 				     input_bfd, o, contents,
 				     internal_relocs,
@@ -12210,6 +12493,8 @@ elf_final_link_free (bfd *obfd, struct elf_final_link_info *flinfo)
 
   if (flinfo->symstrtab != NULL)
     _bfd_elf_strtab_free (flinfo->symstrtab);
+  elf_link_free_reloc_jobs (flinfo);
+  free (flinfo->reloc_jobs);
   free (flinfo->contents);
   free (flinfo->external_relocs);
   free (flinfo->internal_relocs);
@@ -12295,6 +12580,18 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
       /* Note that it is OK if symver_sec is NULL.  */
     }
 
+  /* Relocate input sections in parallel if the linker can run threads
+     and the backend's relocate_section is safe to call concurrently.
+     Emitting relocs needs the relocs processed in order, and with LTO
+     the plugin symbol handling in elf_link_input_bfd changes global
+     symbols, so those links are done serially.  */
+  flinfo.parallel_relocate = (info->threads > 1
+			      && info->callbacks->parallel_for != NULL
+			      && bed->can_relocate_in_parallel
+			      && bed->elf_backend_write_section == NULL
+			      && !emit_relocs
+			      && !info->lto_plugin_active);
+
   if (info->unique_symbol
       && !bfd_hash_table_init (&flinfo.local_hash_table,
 			       local_hash_newfunc,
@@ -12774,6 +13071,9 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 		  if (! elf_link_input_bfd (&flinfo, sub))
 		    goto error_return;
 		  sub->output_has_begun = true;
+		  if (flinfo.reloc_job_size >= ELF_RELOC_JOB_LIMIT
+		      && !elf_link_relocate_deferred (&flinfo))
+		    goto error_return;
 		}
 	    }
 	  else if (p->type == bfd_section_reloc_link_order
@@ -12823,6 +13123,9 @@ bfd_elf_final_link (bfd *abfd, struct bfd_link_info *info)
 	}
     }
 
+  if (!elf_link_relocate_deferred (&flinfo))
+    goto error_return;
+
   /* Free symbol buffer if needed.  */
   if (!info->reduce_memory_overheads)
     {
@@ -13769,20 +14072,25 @@ _bfd_elf_gc_mark_reloc (struct bfd_link_info *info,
   return true;
 }
 
-/* The mark phase of garbage collection.  For a given section, mark
-   it and any sections in this section's group, and all the sections
-   which define symbols to which it refers.  */
+/* An entry in the gc_worklist of an elf_link_hash_table.  */
 
-bool
-_bfd_elf_gc_mark (struct bfd_link_info *info,
+struct elf_gc_work
+{
+  asection *sec;
+  elf_gc_mark_hook_fn gc_mark_hook;
+};
+
+/* Mark the sections in SEC's group, and all the sections which define
+   symbols to which SEC refers.  SEC itself has already been marked.  */
+
+static bool
+elf_gc_mark_refs (struct bfd_link_info *info,
 		  asection *sec,
 		  elf_gc_mark_hook_fn gc_mark_hook)
 {
   bool ret;
   asection *group_sec, *eh_frame;
 
-  sec->gc_mark = 1;
-
   /* Mark all the sections in the group.  */
   group_sec = elf_section_data (sec)->next_in_group;
   if (group_sec && !group_sec->gc_mark)
@@ -13835,6 +14143,76 @@ _bfd_elf_gc_mark (struct bfd_link_info *info,
   return ret;
 }
 
+/* Add SEC to the sections whose references are to be followed.  */
+
+static bool
+elf_gc_push_work (struct elf_link_hash_table *htab, asection *sec,
+		  elf_gc_mark_hook_fn gc_mark_hook)
+{
+  if (htab->gc_worklist_count == htab->gc_worklist_alloc)
+    {
+      size_t alloc = htab->gc_worklist_alloc * 2;
+      struct elf_gc_work *work;
+
+      work = (struct elf_gc_work *) bfd_realloc (htab->gc_worklist,
+						 alloc * sizeof (*work));
+      if (work == NULL)
+	return false;
+      htab->gc_worklist = work;
+      htab->gc_worklist_alloc = alloc;
+    }
+  htab->gc_worklist[htab->gc_worklist_count].sec = sec;
+  htab->gc_worklist[htab->gc_worklist_count].gc_mark_hook = gc_mark_hook;
+  htab->gc_worklist_count++;
+  return true;
+}
+
+/* The mark phase of garbage collection.  For a given section, mark
+   it and any sections in this section's group, and all the sections
+   which define symbols to which it refers.
+
+   Rather than recursing, which needs a very deep stack on large
+   links, the marked sections are put on a worklist.  Calls made
+   while following references, directly or from backend hooks, only
+   add to that worklist, and the outermost call empties it.  */
+
+bool
+_bfd_elf_gc_mark (struct bfd_link_info *info,
+		  asection *sec,
+		  elf_gc_mark_hook_fn gc_mark_hook)
+{
+  struct elf_link_hash_table *htab = elf_hash_table (info);
+  bool ret = true;
+
+  sec->gc_mark = 1;
+
+  if (htab->gc_worklist != NULL)
+    return elf_gc_push_work (htab, sec, gc_mark_hook);
+
+  htab->gc_worklist_alloc = 64;
+  htab->gc_worklist = (struct elf_gc_work *)
+    bfd_malloc (htab->gc_worklist_alloc * sizeof (*htab->gc_worklist));
+  if (htab->gc_worklist == NULL)
+    return false;
+  htab->gc_worklist[0].sec = sec;
+  htab->gc_worklist[0].gc_mark_hook = gc_mark_hook;
+  htab->gc_worklist_count = 1;
+
+  while (ret && htab->gc_worklist_count != 0)
+    {
+      struct elf_gc_work *work;
+
+      work = &htab->gc_worklist[--htab->gc_worklist_count];
+      ret = elf_gc_mark_refs (info, work->sec, work->gc_mark_hook);
+    }
+
+  free (htab->gc_worklist);
+  htab->gc_worklist = NULL;
+  htab->gc_worklist_count = 0;
+  htab->gc_worklist_alloc = 0;
+  return ret;
+}
+
 /* Scan and mark sections in a special or debug section group.  */
 
 static void
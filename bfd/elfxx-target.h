@@ -138,6 +138,9 @@
 #ifndef elf_backend_linux_prpsinfo64_ugid16
 #define elf_backend_linux_prpsinfo64_ugid16 false
 #endif
+#ifndef elf_backend_can_relocate_in_parallel
+#define elf_backend_can_relocate_in_parallel 0
+#endif
 #ifndef elf_backend_stack_align
 #define elf_backend_stack_align 16
 #endif
@@ -959,7 +962,8 @@ static const struct elf_backend_data elfNN_bed =
   elf_backend_extern_protected_data,
   elf_backend_always_renumber_dynsyms,
   elf_backend_linux_prpsinfo32_ugid16,
-  elf_backend_linux_prpsinfo64_ugid16
+  elf_backend_linux_prpsinfo64_ugid16,
+  elf_backend_can_relocate_in_parallel
 };
 
 /* Forward declaration for use when initialising alternative_target field.  */
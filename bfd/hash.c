@@ -130,7 +130,10 @@ SUBSECTION
 @findex bfd_hash_traverse
 	The function <<bfd_hash_traverse>> may be used to traverse a
 	hash table, calling a function on each element.  The traversal
-	is done in a random order.
+	is done in a random order.  The function may add entries to
+	the table, which may or may not be visited, and may rename
+	entries; every entry that was in the table when the traversal
+	started is visited once.
 
 	<<bfd_hash_traverse>> takes as arguments a function and a
 	generic <<void *>> pointer.  The function is called with a
@@ -297,67 +300,62 @@ SUBSUBSECTION
 	<<aout_link_hash_traverse>> in aoutx.h.
 */
 
+/* The table is an array of pointers to entries, using open addressing
+   with linear probing.  Its size is always a power of two, and it is
+   grown once it is half full, so that lookups only look at a few
+   slots.  Entries are never moved in memory, only the pointers to
+   them.
+
+   The NEXT field of an entry in the array is not used by this code.
+   Some users put several entries for the same string on a list
+   through NEXT, starting at the entry that is in the array (see for
+   instance bfd_make_section_anyway_with_flags), so the list is kept
+   with that entry when it is moved, renamed or replaced, and
+   bfd_hash_traverse walks it.
+
+   bfd_hash_traverse walks the array that was current when it
+   started, and the function it calls may add or rename entries.  So
+   entries are never moved within an array while a traversal is in
+   progress, which would have it skip or revisit them.  Growing the
+   table moves the entries to a new array, leaving the old one as it
+   was, and while the table is frozen a rename first does the same at
+   the current size instead of moving entries back over the one it
+   removes.  */
+
 /* The default number of entries to use when creating a hash table.  */
-#define DEFAULT_SIZE 4051
+#define DEFAULT_SIZE 4096
+
+/* The largest table size.  */
+#define MAX_SIZE ((unsigned int) 1 << 31)
 
-/* The following function returns a nearest prime number which is
-   greater than N, and near a power of two.  Copied from libiberty.
-   Returns zero for ridiculously large N to signify an error.  */
+/* Return the smallest power of two that is at least N and no less
+   than 16, or zero if N is too large.  */
 
-static unsigned long
-higher_prime_number (unsigned long n)
+static unsigned int
+bfd_hash_round_size (unsigned long n)
 {
-  /* These are primes that are near, but slightly smaller than, a
-     power of two.  */
-  static const unsigned long primes[] =
-    {
-      (unsigned long) 31,
-      (unsigned long) 61,
-      (unsigned long) 127,
-      (unsigned long) 251,
-      (unsigned long) 509,
-      (unsigned long) 1021,
-      (unsigned long) 2039,
-      (unsigned long) 4093,
-      (unsigned long) 8191,
-      (unsigned long) 16381,
-      (unsigned long) 32749,
-      (unsigned long) 65521,
-      (unsigned long) 131071,
-      (unsigned long) 262139,
-      (unsigned long) 524287,
-      (unsigned long) 1048573,
-      (unsigned long) 2097143,
-      (unsigned long) 4194301,
-      (unsigned long) 8388593,
-      (unsigned long) 16777213,
-      (unsigned long) 33554393,
-      (unsigned long) 67108859,
-      (unsigned long) 134217689,
-      (unsigned long) 268435399,
-      (unsigned long) 536870909,
-      (unsigned long) 1073741789,
-      (unsigned long) 2147483647,
-					/* 4294967291L */
-      ((unsigned long) 2147483647) + ((unsigned long) 2147483644),
-  };
-
-  const unsigned long *low = &primes[0];
-  const unsigned long *high = &primes[sizeof (primes) / sizeof (primes[0])];
-
-  while (low != high)
-    {
-      const unsigned long *mid = low + (high - low) / 2;
-      if (n >= *mid)
-	low = mid + 1;
-      else
-	high = mid;
-    }
+  unsigned int size = 16;
 
-  if (n >= *low)
+  if (n > MAX_SIZE)
     return 0;
+  while (size < n)
+    size <<= 1;
+  return size;
+}
+
+/* Return the slot at which to start looking for HASH in TABLE.  The
+   hash code is mixed again, as some users supply their own, weaker,
+   hash codes to bfd_hash_insert.  */
 
-  return *low;
+static inline unsigned int
+bfd_hash_slot (const struct bfd_hash_table *table, unsigned long hash)
+{
+  uint32_t h = (uint32_t) hash;
+
+  h ^= h >> 16;
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return h & (table->size - 1);
 }
 
 static unsigned long bfd_default_hash_table_size = DEFAULT_SIZE;
@@ -374,9 +372,10 @@ bfd_hash_table_init_n (struct bfd_hash_table *table,
 {
   unsigned long alloc;
 
+  size = bfd_hash_round_size (size);
   alloc = size;
   alloc *= sizeof (struct bfd_hash_entry *);
-  if (alloc / sizeof (struct bfd_hash_entry *) != size)
+  if (size == 0 || alloc / sizeof (struct bfd_hash_entry *) != size)
     {
       bfd_set_error (bfd_error_no_memory);
       return false;
@@ -427,29 +426,56 @@ bfd_hash_table_free (struct bfd_hash_table *table)
   table->memory = NULL;
 }
 
+/* Read eight bytes at P as a little endian number, whatever the host,
+   so that hash codes, and thus the order in which bfd_hash_traverse
+   visits entries, do not depend on the host.  */
+
+static inline uint64_t
+bfd_hash_load64 (const unsigned char *p)
+{
+  return ((uint64_t) p[0]
+	  | (uint64_t) p[1] << 8
+	  | (uint64_t) p[2] << 16
+	  | (uint64_t) p[3] << 24
+	  | (uint64_t) p[4] << 32
+	  | (uint64_t) p[5] << 40
+	  | (uint64_t) p[6] << 48
+	  | (uint64_t) p[7] << 56);
+}
+
+/* Hash STRING a word at a time.  The result only has 32 significant
+   bits, so that it is the same on hosts where long is 32 bits.  */
+
 static inline unsigned long
 bfd_hash_hash (const char *string, unsigned int *lenp)
 {
   const unsigned char *s;
-  unsigned long hash;
-  unsigned int len;
-  unsigned int c;
+  uint64_t hash, w;
+  size_t len, n;
 
   BFD_ASSERT (string != NULL);
-  hash = 0;
-  len = 0;
   s = (const unsigned char *) string;
-  while ((c = *s++) != '\0')
+  len = strlen (string);
+  hash = len * 0x9e3779b97f4a7c15ULL;
+  for (n = len; n >= 8; n -= 8, s += 8)
+    {
+      hash = (hash ^ bfd_hash_load64 (s)) * 0x9ddfea08eb382d69ULL;
+      hash ^= hash >> 47;
+    }
+  if (n != 0)
     {
-      hash += c + (c << 17);
-      hash ^= hash >> 2;
+      w = 0;
+      while (n-- != 0)
+	w = (w << 8) | s[n];
+      hash = (hash ^ w) * 0x9ddfea08eb382d69ULL;
+      hash ^= hash >> 47;
     }
-  len = (s - (const unsigned char *) string) - 1;
-  hash += len + (len << 17);
-  hash ^= hash >> 2;
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
   if (lenp != NULL)
     *lenp = len;
-  return hash;
+  return (uint32_t) hash;
 }
 
 /* Look up a string in a hash table.  */
@@ -466,10 +492,9 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   unsigned int _index;
 
   hash = bfd_hash_hash (string, &len);
-  _index = hash % table->size;
-  for (hashp = table->table[_index];
-       hashp != NULL;
-       hashp = hashp->next)
+  for (_index = bfd_hash_slot (table, hash);
+       (hashp = table->table[_index]) != NULL;
+       _index = (_index + 1) & (table->size - 1))
     {
       if (hashp->hash == hash
 	  && strcmp (hashp->string, string) == 0)
@@ -497,6 +522,62 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   return bfd_hash_insert (table, string, hash);
 }
 
+/* Put ENT in the first free slot for its hash code in TABLE.  */
+
+static void
+bfd_hash_place (struct bfd_hash_table *table, struct bfd_hash_entry *ent)
+{
+  unsigned int _index;
+
+  for (_index = bfd_hash_slot (table, ent->hash);
+       table->table[_index] != NULL;
+       _index = (_index + 1) & (table->size - 1))
+    ;
+  table->table[_index] = ent;
+}
+
+/* Move the entries of TABLE to a new array of NEWSIZE slots.  The old
+   array is not changed; like everything else in the table, it is only
+   freed with it.  Return false if that is not possible.  */
+
+static bool
+bfd_hash_resize (struct bfd_hash_table *table, unsigned int newsize)
+{
+  struct bfd_hash_entry **oldtable = table->table;
+  unsigned int oldsize = table->size;
+  unsigned long alloc = (unsigned long) newsize * sizeof (*oldtable);
+  struct bfd_hash_entry **newtable;
+  unsigned int i;
+
+  /* If we can't possibly alloc that much memory, don't try to grow
+     the table.  */
+  if (newsize == 0
+      || newsize > MAX_SIZE
+      || alloc / sizeof (*oldtable) != newsize)
+    return false;
+
+  newtable = ((struct bfd_hash_entry **)
+	      objalloc_alloc ((struct objalloc *) table->memory, alloc));
+  if (newtable == NULL)
+    return false;
+  memset (newtable, 0, alloc);
+
+  table->table = newtable;
+  table->size = newsize;
+  for (i = 0; i < oldsize; i++)
+    if (oldtable[i] != NULL)
+      bfd_hash_place (table, oldtable[i]);
+  return true;
+}
+
+/* Double the size of TABLE.  Return false if that is not possible.  */
+
+static bool
+bfd_hash_grow (struct bfd_hash_table *table)
+{
+  return bfd_hash_resize (table, table->size * 2);
+}
+
 /* Insert an entry in a hash table.  */
 
 struct bfd_hash_entry *
@@ -505,61 +586,83 @@ bfd_hash_insert (struct bfd_hash_table *table,
 		 unsigned long hash)
 {
   struct bfd_hash_entry *hashp;
-  unsigned int _index;
+
+  /* Keep at least one free slot, so that lookups terminate.  A frozen
+     table is only grown when it gets close to that; a traversal in
+     progress keeps walking the old array.  */
+  if ((table->count + 1) * 2 > table->size
+      && (!table->frozen
+	  || (table->count + 1) * 8 > table->size * 7)
+      && !bfd_hash_grow (table))
+    {
+      table->frozen = 1;
+      if (table->count + 1 >= table->size)
+	{
+	  bfd_set_error (bfd_error_no_memory);
+	  return NULL;
+	}
+    }
 
   hashp = (*table->newfunc) (NULL, table, string);
   if (hashp == NULL)
     return NULL;
   hashp->string = string;
   hashp->hash = hash;
-  _index = hash % table->size;
-  hashp->next = table->table[_index];
-  table->table[_index] = hashp;
+  hashp->next = NULL;
+  bfd_hash_place (table, hashp);
   table->count++;
+  return hashp;
+}
 
-  if (!table->frozen && table->count > table->size * 3 / 4)
-    {
-      unsigned long newsize = higher_prime_number (table->size);
-      struct bfd_hash_entry **newtable;
-      unsigned int hi;
-      unsigned long alloc = newsize * sizeof (struct bfd_hash_entry *);
-
-      /* If we can't find a higher prime, or we can't possibly alloc
-	 that much memory, don't try to grow the table.  */
-      if (newsize == 0 || alloc / sizeof (struct bfd_hash_entry *) != newsize)
+/* Find the slot of TABLE holding ENT, or the entry whose NEXT list
+   holds it.  Store the slot in *PINDEX and the entry before ENT on a
+   NEXT list, if any, in *PPREV.  */
+
+static void
+bfd_hash_find_entry (struct bfd_hash_table *table,
+		     struct bfd_hash_entry *ent,
+		     unsigned int *pindex,
+		     struct bfd_hash_entry **pprev)
+{
+  unsigned int _index;
+  struct bfd_hash_entry *p, *prev;
+
+  for (_index = bfd_hash_slot (table, ent->hash);
+       table->table[_index] != NULL;
+       _index = (_index + 1) & (table->size - 1))
+    for (prev = NULL, p = table->table[_index]; p != NULL; prev = p, p = p->next)
+      if (p == ent)
 	{
-	  table->frozen = 1;
-	  return hashp;
+	  *pindex = _index;
+	  *pprev = prev;
+	  return;
 	}
 
-      newtable = ((struct bfd_hash_entry **)
-		  objalloc_alloc ((struct objalloc *) table->memory, alloc));
-      if (newtable == NULL)
+  abort ();
+}
+
+/* Empty slot I of TABLE, moving back any following entries that would
+   no longer be found.  */
+
+static void
+bfd_hash_remove_slot (struct bfd_hash_table *table, unsigned int i)
+{
+  unsigned int mask = table->size - 1;
+  unsigned int j, home;
+
+  table->table[i] = NULL;
+  for (j = (i + 1) & mask; table->table[j] != NULL; j = (j + 1) & mask)
+    {
+      home = bfd_hash_slot (table, table->table[j]->hash);
+      /* Move the entry at J to I if I is between its home slot and J,
+	 cyclically.  */
+      if (((j - home) & mask) >= ((j - i) & mask))
 	{
-	  table->frozen = 1;
-	  return hashp;
+	  table->table[i] = table->table[j];
+	  table->table[j] = NULL;
+	  i = j;
 	}
-      memset (newtable, 0, alloc);
-
-      for (hi = 0; hi < table->size; hi ++)
-	while (table->table[hi])
-	  {
-	    struct bfd_hash_entry *chain = table->table[hi];
-	    struct bfd_hash_entry *chain_end = chain;
-
-	    while (chain_end->next && chain_end->next->hash == chain->hash)
-	      chain_end = chain_end->next;
-
-	    table->table[hi] = chain_end->next;
-	    _index = chain->hash % newsize;
-	    chain_end->next = newtable[_index];
-	    newtable[_index] = chain;
-	  }
-      table->table = newtable;
-      table->size = newsize;
     }
-
-  return hashp;
 }
 
 /* Rename an entry in a hash table.  */
@@ -570,21 +673,29 @@ bfd_hash_rename (struct bfd_hash_table *table,
 		 struct bfd_hash_entry *ent)
 {
   unsigned int _index;
-  struct bfd_hash_entry **pph;
-
-  _index = ent->hash % table->size;
-  for (pph = &table->table[_index]; *pph != NULL; pph = &(*pph)->next)
-    if (*pph == ent)
-      break;
-  if (*pph == NULL)
-    abort ();
+  struct bfd_hash_entry *prev;
+
+  /* Removing ENT from its slot may move other entries back, so during
+     a traversal do that in a copy of the array.  Should the copy fail,
+     the traversal might skip or revisit an entry, which is better than
+     losing the rename.  */
+  if (table->frozen)
+    bfd_hash_resize (table, table->size);
+
+  bfd_hash_find_entry (table, ent, &_index, &prev);
+  if (prev != NULL)
+    prev->next = ent->next;
+  else if (ent->next != NULL)
+    /* The rest of the list has the same hash code, so its head can
+       take ENT's slot.  */
+    table->table[_index] = ent->next;
+  else
+    bfd_hash_remove_slot (table, _index);
 
-  *pph = ent->next;
   ent->string = string;
   ent->hash = bfd_hash_hash (string, NULL);
-  _index = ent->hash % table->size;
-  ent->next = table->table[_index];
-  table->table[_index] = ent;
+  ent->next = NULL;
+  bfd_hash_place (table, ent);
 }
 
 /* Replace an entry in a hash table.  */
@@ -595,21 +706,49 @@ bfd_hash_replace (struct bfd_hash_table *table,
 		  struct bfd_hash_entry *nw)
 {
   unsigned int _index;
-  struct bfd_hash_entry **pph;
+  struct bfd_hash_entry *prev;
 
-  _index = old->hash % table->size;
-  for (pph = &table->table[_index];
-       (*pph) != NULL;
-       pph = &(*pph)->next)
-    {
-      if (*pph == old)
-	{
-	  *pph = nw;
-	  return;
-	}
-    }
+  bfd_hash_find_entry (table, old, &_index, &prev);
+  if (prev != NULL)
+    prev->next = nw;
+  else
+    table->table[_index] = nw;
+}
 
-  abort ();
+/* Return the first entry of TABLE in the array with hash code HASH,
+   for users of bfd_hash_insert that compare entries themselves.
+   *PINDEX is set for _bfd_hash_next_hash.  */
+
+struct bfd_hash_entry *
+_bfd_hash_first_hash (struct bfd_hash_table *table, unsigned long hash,
+		      unsigned int *pindex)
+{
+  *pindex = (bfd_hash_slot (table, hash) - 1) & (table->size - 1);
+  return _bfd_hash_next_hash (table, hash, pindex);
+}
+
+/* Return the next entry after the one returned by the previous call
+   to _bfd_hash_first_hash or _bfd_hash_next_hash with hash code HASH,
+   or NULL if there are no more.  */
+
+struct bfd_hash_entry *
+_bfd_hash_next_hash (struct bfd_hash_table *table, unsigned long hash,
+		     unsigned int *pindex)
+{
+  unsigned int _index = *pindex;
+  struct bfd_hash_entry *p;
+
+  for (_index = (_index + 1) & (table->size - 1);
+       (p = table->table[_index]) != NULL;
+       _index = (_index + 1) & (table->size - 1))
+    if (p->hash == hash)
+      {
+	*pindex = _index;
+	return p;
+      }
+
+  *pindex = _index;
+  return NULL;
 }
 
 /* Allocate space in a hash table.  */
@@ -646,39 +785,40 @@ bfd_hash_traverse (struct bfd_hash_table *table,
 		   bool (*func) (struct bfd_hash_entry *, void *),
 		   void * info)
 {
+  struct bfd_hash_entry **tab = table->table;
+  unsigned int size = table->size;
   unsigned int i;
 
+  /* FUNC may add or rename entries.  That never moves entries within
+     TAB, so each entry present at the start is visited exactly once;
+     entries added meanwhile may or may not be.  */
   table->frozen = 1;
-  for (i = 0; i < table->size; i++)
+  for (i = 0; i < size; i++)
     {
       struct bfd_hash_entry *p;
 
-      for (p = table->table[i]; p != NULL; p = p->next)
+      for (p = tab[i]; p != NULL; p = p->next)
 	if (! (*func) (p, info))
 	  goto out;
     }
  out:
   table->frozen = 0;
 }
-
+
 unsigned long
 bfd_hash_set_default_size (unsigned long hash_size)
 {
-  /* These silly_size values result in around 1G and 32M of memory
-     being allocated for the table of pointers.  Note that the number
-     of elements allocated will be almost twice the size of any power
-     of two chosen here.  */
+  /* These silly_size values result in around 512M and 16M of memory
+     being allocated for the table of pointers.  */
   unsigned long silly_size = sizeof (size_t) > 4 ? 0x4000000 : 0x400000;
   if (hash_size > silly_size)
     hash_size = silly_size;
-  else if (hash_size != 0)
-    hash_size--;
-  hash_size = higher_prime_number (hash_size);
+  hash_size = bfd_hash_round_size (hash_size);
   BFD_ASSERT (hash_size != 0);
   bfd_default_hash_table_size = hash_size;
   return bfd_default_hash_table_size;
 }
-
+
 /* A few different object file formats (a.out, COFF, ELF) use a string
    table.  These functions support adding strings to a string table,
    returning the byte offset, and writing out the table.
@@ -179,6 +179,8 @@ extern bfd * _bfd_new_bfd
   (void) ATTRIBUTE_HIDDEN;
 extern bool _bfd_free_cached_info
   (bfd *) ATTRIBUTE_HIDDEN;
+extern void _bfd_free_section_mappings
+  (bfd *) ATTRIBUTE_HIDDEN;
 
 extern bool _bfd_bool_bfd_false
   (bfd *) ATTRIBUTE_HIDDEN;
@@ -604,6 +606,13 @@ extern bool _bfd_dwarf2_slurp_debug_info
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **) ATTRIBUTE_HIDDEN;
 
+/* Walk the entries of a hash table with a given hash code, for users
+   of bfd_hash_insert that do their own lookups.  */
+extern struct bfd_hash_entry *_bfd_hash_first_hash
+  (struct bfd_hash_table *, unsigned long, unsigned int *) ATTRIBUTE_HIDDEN;
+extern struct bfd_hash_entry *_bfd_hash_next_hash
+  (struct bfd_hash_table *, unsigned long, unsigned int *) ATTRIBUTE_HIDDEN;
+
 /* Create a new section entry.  */
 extern struct bfd_hash_entry *bfd_section_hash_newfunc
   (struct bfd_hash_entry *, struct bfd_hash_table *, const char *)
@@ -659,14 +659,18 @@ bfd_link_hash_traverse
    bool (*func) (struct bfd_link_hash_entry *, void *),
    void *info)
 {
+  struct bfd_hash_entry **tab = htab->table.table;
+  unsigned int size = htab->table.size;
   unsigned int i;
 
+  /* As in bfd_hash_traverse, walk the array the traversal started
+     with, which FUNC cannot rearrange.  */
   htab->table.frozen = 1;
-  for (i = 0; i < htab->table.size; i++)
+  for (i = 0; i < size; i++)
     {
       struct bfd_link_hash_entry *p;
 
-      p = (struct bfd_link_hash_entry *) htab->table.table[i];
+      p = (struct bfd_link_hash_entry *) tab[i];
       for (; p != NULL; p = (struct bfd_link_hash_entry *) p->root.next)
 	if (!(*func) (p->type == bfd_link_hash_warning ? p->u.i.link : p, info))
 	  goto out;
@@ -71,6 +71,11 @@ struct sec_merge_hash
   unsigned int entsize;
   /* Are entries fixed size or zero terminated strings?  */
   bool strings;
+  /* If the entries were added by record_sections_parallel, the tables
+     holding them.  An entry with hash H is in SHARDS[H % NSHARDS],
+     and TABLE is unused.  */
+  struct bfd_hash_table *shards;
+  unsigned int nshards;
 };
 
 struct sec_merge_info
@@ -131,18 +136,17 @@ sec_merge_hash_newfunc (struct bfd_hash_entry *entry,
   return entry;
 }
 
-/* Look up an entry in a section merge hash table.  */
+/* Compute the hash of the entity at STRING for TABLE, and store its
+   length in octets, including any terminator, in *PLEN.  */
 
-static struct sec_merge_hash_entry *
-sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
-		       unsigned int alignment, bool create)
+static unsigned long
+sec_merge_hash_string (struct sec_merge_hash *table, const char *string,
+		       unsigned int *plen)
 {
   const unsigned char *s;
   unsigned long hash;
   unsigned int c;
-  struct sec_merge_hash_entry *hashp;
   unsigned int len, i;
-  unsigned int _index;
 
   hash = 0;
   len = 0;
@@ -193,10 +197,32 @@ sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
       len = table->entsize;
     }
 
-  _index = hash % table->table.size;
-  for (hashp = (struct sec_merge_hash_entry *) table->table.table[_index];
+  *plen = len;
+  return hash;
+}
+
+/* Look up the entity at STRING, of length LEN and with hash HASH, in
+   a section merge hash table.  */
+
+static struct sec_merge_hash_entry *
+sec_merge_hash_find (struct sec_merge_hash *table, const char *string,
+		     unsigned long hash, unsigned int len,
+		     unsigned int alignment, bool create)
+{
+  struct bfd_hash_table *htab;
+  struct sec_merge_hash_entry *hashp;
+  unsigned int _index;
+
+  if (table->nshards != 0)
+    htab = &table->shards[hash % table->nshards];
+  else
+    htab = &table->table;
+
+  for (hashp = ((struct sec_merge_hash_entry *)
+		_bfd_hash_first_hash (htab, hash, &_index));
        hashp != NULL;
-       hashp = (struct sec_merge_hash_entry *) hashp->root.next)
+       hashp = ((struct sec_merge_hash_entry *)
+		_bfd_hash_next_hash (htab, hash, &_index)))
     {
       if (hashp->root.hash == hash
 	  && len == hashp->len
@@ -222,7 +248,7 @@ sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
     return NULL;
 
   hashp = ((struct sec_merge_hash_entry *)
-	   bfd_hash_insert (&table->table, string, hash));
+	   bfd_hash_insert (htab, string, hash));
   if (hashp == NULL)
     return NULL;
   hashp->len = len;
@@ -230,6 +256,19 @@ sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
   return hashp;
 }
 
+/* Look up an entry in a section merge hash table.  */
+
+static struct sec_merge_hash_entry *
+sec_merge_hash_lookup (struct sec_merge_hash *table, const char *string,
+		       unsigned int alignment, bool create)
+{
+  unsigned long hash;
+  unsigned int len;
+
+  hash = sec_merge_hash_string (table, string, &len);
+  return sec_merge_hash_find (table, string, hash, len, alignment, create);
+}
+
 /* Create a new hash table.  */
 
 static struct sec_merge_hash *
@@ -253,33 +292,45 @@ sec_merge_init (unsigned int entsize, bool strings)
   table->last = NULL;
   table->entsize = entsize;
   table->strings = strings;
+  table->shards = NULL;
+  table->nshards = 0;
 
   return table;
 }
 
+/* Append ENTRY, newly added to TAB for SECINFO, to the list of
+   entities.  */
+
+static void
+sec_merge_append (struct sec_merge_hash *tab,
+		  struct sec_merge_hash_entry *entry,
+		  struct sec_merge_sec_info *secinfo)
+{
+  tab->size++;
+  entry->secinfo = secinfo;
+  if (tab->first == NULL)
+    tab->first = entry;
+  else
+    tab->last->next = entry;
+  tab->last = entry;
+}
+
 /* Get the index of an entity in a hash table, adding it if it is not
    already present.  */
 
 static struct sec_merge_hash_entry *
 sec_merge_add (struct sec_merge_hash *tab, const char *str,
+	       unsigned long hash, unsigned int len,
 	       unsigned int alignment, struct sec_merge_sec_info *secinfo)
 {
   struct sec_merge_hash_entry *entry;
 
-  entry = sec_merge_hash_lookup (tab, str, alignment, true);
+  entry = sec_merge_hash_find (tab, str, hash, len, alignment, true);
   if (entry == NULL)
     return NULL;
 
   if (entry->secinfo == NULL)
-    {
-      tab->size++;
-      entry->secinfo = secinfo;
-      if (tab->first == NULL)
-	tab->first = entry;
-      else
-	tab->last->next = entry;
-      tab->last = entry;
-    }
+    sec_merge_append (tab, entry, secinfo);
 
   return entry;
 }
@@ -475,17 +526,24 @@ _bfd_add_merge_section (bfd *abfd, void **psinfo, asection *sec,
   return false;
 }
 
-/* Record one section into the hash table.  */
+/* Call ADD for each entity of the section described by SECINFO, in
+   order, giving it the entity's string, hash, length and required
+   alignment.  */
+
+typedef bool (*sec_merge_add_fn) (void *, struct sec_merge_sec_info *,
+				  const char *, unsigned long, unsigned int,
+				  unsigned int);
+
 static bool
-record_section (struct sec_merge_info *sinfo,
-		struct sec_merge_sec_info *secinfo)
+scan_section (struct sec_merge_hash *tab, struct sec_merge_sec_info *secinfo,
+	      sec_merge_add_fn add, void *data)
 {
   asection *sec = secinfo->sec;
-  struct sec_merge_hash_entry *entry;
   bool nul;
   unsigned char *p, *end;
   bfd_vma mask, eltalign;
-  unsigned int align, i;
+  unsigned int align, i, len;
+  unsigned long hash;
 
   align = sec->alignment_power;
   end = secinfo->contents + sec->size;
@@ -499,11 +557,11 @@ record_section (struct sec_merge_info *sinfo,
 	  eltalign = ((eltalign ^ (eltalign - 1)) + 1) >> 1;
 	  if (!eltalign || eltalign > mask)
 	    eltalign = mask + 1;
-	  entry = sec_merge_add (sinfo->htab, (char *) p, (unsigned) eltalign,
-				 secinfo);
-	  if (! entry)
-	    goto error_return;
-	  p += entry->len;
+	  hash = sec_merge_hash_string (tab, (char *) p, &len);
+	  if (! add (data, secinfo, (char *) p, hash, len,
+		     (unsigned) eltalign))
+	    return false;
+	  p += len;
 	  if (sec->entsize == 1)
 	    {
 	      while (p < end && *p == 0)
@@ -511,10 +569,10 @@ record_section (struct sec_merge_info *sinfo,
 		  if (!nul && !((p - secinfo->contents) & mask))
 		    {
 		      nul = true;
-		      entry = sec_merge_add (sinfo->htab, "",
-					     (unsigned) mask + 1, secinfo);
-		      if (! entry)
-			goto error_return;
+		      hash = sec_merge_hash_string (tab, "", &len);
+		      if (! add (data, secinfo, "", hash, len,
+				 (unsigned) mask + 1))
+			return false;
 		    }
 		  p++;
 		}
@@ -531,10 +589,10 @@ record_section (struct sec_merge_info *sinfo,
 		  if (!nul && !((p - secinfo->contents) & mask))
 		    {
 		      nul = true;
-		      entry = sec_merge_add (sinfo->htab, (char *) p,
-					     (unsigned) mask + 1, secinfo);
-		      if (! entry)
-			goto error_return;
+		      hash = sec_merge_hash_string (tab, (char *) p, &len);
+		      if (! add (data, secinfo, (char *) p, hash, len,
+				 (unsigned) mask + 1))
+			return false;
 		    }
 		  p += sec->entsize;
 		}
@@ -545,20 +603,271 @@ record_section (struct sec_merge_info *sinfo,
     {
       for (p = secinfo->contents; p < end; p += sec->entsize)
 	{
-	  entry = sec_merge_add (sinfo->htab, (char *) p, 1, secinfo);
-	  if (! entry)
-	    goto error_return;
+	  hash = sec_merge_hash_string (tab, (char *) p, &len);
+	  if (! add (data, secinfo, (char *) p, hash, len, 1))
+	    return false;
 	}
     }
 
   return true;
+}
+
+/* A sec_merge_add_fn that adds the entity to the hash table TAB.  */
+
+static bool
+record_entity (void *tab, struct sec_merge_sec_info *secinfo,
+	       const char *string, unsigned long hash, unsigned int len,
+	       unsigned int alignment)
+{
+  return sec_merge_add ((struct sec_merge_hash *) tab, string, hash, len,
+			alignment, secinfo) != NULL;
+}
+
+/* Record one section into the hash table.  */
+static bool
+record_section (struct sec_merge_info *sinfo,
+		struct sec_merge_sec_info *secinfo)
+{
+  if (scan_section (sinfo->htab, secinfo, record_entity, sinfo->htab))
+    return true;
 
- error_return:
   for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
     *secinfo->psecinfo = NULL;
   return false;
 }
 
+/* With several threads, the sections of a sec_merge_info are recorded
+   in three steps.  First the sections are scanned in parallel,
+   computing the hash of each of their entities.  Then the hash table
+   is split into shards by hash, and each shard is filled in parallel
+   by going through the entities that belong to it in section order.
+   As equal entities always land in the same shard, each shard sees
+   them in the same order as record_section would.  Finally the new
+   entries are chained in the order in which they were created, so
+   the result is the same as recording the sections one by one.  */
+
+/* Don't bother with threads unless there is at least this much
+   to merge.  */
+#define SEC_MERGE_PARALLEL_MIN (256 * 1024)
+
+/* An entity found by scan_section.  */
+
+struct sec_merge_entity
+{
+  struct sec_merge_sec_info *secinfo;
+  const char *string;
+  unsigned long hash;
+  unsigned int len;
+  unsigned int alignment;
+  /* The entry this entity created in its shard, if any.  */
+  struct sec_merge_hash_entry *entry;
+};
+
+/* The entities of one section.  */
+
+struct sec_merge_scan
+{
+  struct sec_merge_sec_info *secinfo;
+  struct sec_merge_entity *ents;
+  size_t count;
+  size_t alloc;
+};
+
+struct sec_merge_parallel
+{
+  struct sec_merge_hash *htab;
+  struct sec_merge_scan *scans;
+  size_t nscans;
+  /* The entities of each shard, in section order.  Those of shard I
+     are SHARD_ENTS[SHARD_START[I]] to SHARD_ENTS[SHARD_START[I+1]-1].  */
+  struct sec_merge_entity **shard_ents;
+  size_t *shard_start;
+  /* Set if a job ran out of memory.  */
+  bool failed;
+};
+
+/* A sec_merge_add_fn that appends the entity to the sec_merge_scan
+   SCAN.  */
+
+static bool
+collect_entity (void *scan, struct sec_merge_sec_info *secinfo,
+		const char *string, unsigned long hash, unsigned int len,
+		unsigned int alignment)
+{
+  struct sec_merge_scan *sc = (struct sec_merge_scan *) scan;
+  struct sec_merge_entity *ent;
+
+  if (sc->count == sc->alloc)
+    {
+      size_t alloc = sc->alloc * 2 + 64;
+
+      ent = (struct sec_merge_entity *) bfd_realloc (sc->ents,
+						     alloc * sizeof (*ent));
+      if (ent == NULL)
+	return false;
+      sc->ents = ent;
+      sc->alloc = alloc;
+    }
+  ent = &sc->ents[sc->count++];
+  ent->secinfo = secinfo;
+  ent->string = string;
+  ent->hash = hash;
+  ent->len = len;
+  ent->alignment = alignment;
+  ent->entry = NULL;
+  return true;
+}
+
+/* Scan section I of DATA, a sec_merge_parallel.  */
+
+static void
+scan_section_job (void *data, size_t i)
+{
+  struct sec_merge_parallel *par = (struct sec_merge_parallel *) data;
+  struct sec_merge_scan *sc = &par->scans[i];
+
+  if (!scan_section (par->htab, sc->secinfo, collect_entity, sc))
+    par->failed = true;
+}
+
+/* Fill shard I of DATA, a sec_merge_parallel.  */
+
+static void
+fill_shard_job (void *data, size_t i)
+{
+  struct sec_merge_parallel *par = (struct sec_merge_parallel *) data;
+  size_t j;
+
+  for (j = par->shard_start[i]; j < par->shard_start[i + 1]; j++)
+    {
+      struct sec_merge_entity *ent = par->shard_ents[j];
+      struct sec_merge_hash_entry *entry;
+
+      entry = sec_merge_hash_find (par->htab, ent->string, ent->hash,
+				   ent->len, ent->alignment, true);
+      if (entry == NULL)
+	{
+	  par->failed = true;
+	  return;
+	}
+      if (entry->secinfo == NULL)
+	{
+	  /* Claim the entry now, so that later equal entities don't
+	     create it again.  It is chained by record_sections_parallel.  */
+	  entry->secinfo = ent->secinfo;
+	  ent->entry = entry;
+	}
+    }
+}
+
+/* Record the NSECS sections SECS of SINFO into its hash table, using
+   the linker's threads.  */
+
+static bool
+record_sections_parallel (struct bfd_link_info *info,
+			  struct sec_merge_info *sinfo,
+			  struct sec_merge_sec_info **secs, size_t nsecs)
+{
+  struct sec_merge_hash *tab = sinfo->htab;
+  struct sec_merge_parallel par;
+  unsigned int nshards, i;
+  size_t total, j, k;
+  bool ret = false;
+
+  memset (&par, 0, sizeof (par));
+  par.htab = tab;
+  par.nscans = nsecs;
+  par.scans = (struct sec_merge_scan *) bfd_zmalloc (nsecs
+						     * sizeof (*par.scans));
+  if (par.scans == NULL)
+    goto out;
+  for (j = 0; j < nsecs; j++)
+    par.scans[j].secinfo = secs[j];
+
+  info->callbacks->parallel_for (info, scan_section_job, &par, nsecs);
+  if (par.failed)
+    goto out;
+
+  /* Use a few shards per thread so that they even out.  */
+  nshards = info->threads * 4;
+  if (nshards > 256)
+    nshards = 256;
+  tab->shards = (struct bfd_hash_table *) bfd_zmalloc (nshards
+						       * sizeof (*tab->shards));
+  if (tab->shards == NULL)
+    goto out;
+  for (i = 0; i < nshards; i++)
+    if (!bfd_hash_table_init_n (&tab->shards[i], sec_merge_hash_newfunc,
+				sizeof (struct sec_merge_hash_entry), 4051))
+      {
+	while (i-- > 0)
+	  bfd_hash_table_free (&tab->shards[i]);
+	free (tab->shards);
+	tab->shards = NULL;
+	goto out;
+      }
+  tab->nshards = nshards;
+
+  /* Distribute the entities over the shards, keeping them in section
+     order.  */
+  par.shard_start = (size_t *) bfd_zmalloc ((nshards + 1)
+					    * sizeof (*par.shard_start));
+  if (par.shard_start == NULL)
+    goto out;
+  for (j = 0; j < nsecs; j++)
+    for (k = 0; k < par.scans[j].count; k++)
+      par.shard_start[par.scans[j].ents[k].hash % nshards + 1]++;
+  for (i = 0; i < nshards; i++)
+    par.shard_start[i + 1] += par.shard_start[i];
+  total = par.shard_start[nshards];
+  par.shard_ents = (struct sec_merge_entity **) bfd_malloc
+    (total * sizeof (*par.shard_ents) + 1);
+  if (par.shard_ents == NULL)
+    goto out;
+  for (j = 0; j < nsecs; j++)
+    for (k = 0; k < par.scans[j].count; k++)
+      {
+	struct sec_merge_entity *ent = &par.scans[j].ents[k];
+
+	par.shard_ents[par.shard_start[ent->hash % nshards]++] = ent;
+      }
+  for (i = nshards; i > 0; i--)
+    par.shard_start[i] = par.shard_start[i - 1];
+  par.shard_start[0] = 0;
+
+  info->callbacks->parallel_for (info, fill_shard_job, &par, nshards);
+  if (par.failed)
+    goto out;
+
+  /* Chain the new entries in the order record_section would have
+     created them.  */
+  for (j = 0; j < nsecs; j++)
+    for (k = 0; k < par.scans[j].count; k++)
+      {
+	struct sec_merge_entity *ent = &par.scans[j].ents[k];
+
+	if (ent->entry != NULL)
+	  sec_merge_append (tab, ent->entry, ent->secinfo);
+      }
+  ret = true;
+
+ out:
+  if (par.scans != NULL)
+    for (j = 0; j < nsecs; j++)
+      free (par.scans[j].ents);
+  free (par.scans);
+  free (par.shard_ents);
+  free (par.shard_start);
+  if (!ret)
+    {
+      struct sec_merge_sec_info *secinfo;
+
+      for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+	*secinfo->psecinfo = NULL;
+    }
+  return ret;
+}
+
 /* qsort comparison function.  Won't ever return zero as all entries
    differ, so there is no issue with qsort stability here.  */
 
@@ -626,10 +935,94 @@ is_suffix (const struct sec_merge_hash_entry *A,
 		 B->root.string, B->len) == 0;
 }
 
+/* Don't sort in parallel unless there are at least this many
+   strings.  */
+#define SEC_MERGE_PARALLEL_SORT_MIN 16384
+
+struct sec_merge_sort
+{
+  struct sec_merge_hash_entry **array;
+  /* Bucket I is ARRAY[START[I]] to ARRAY[START[I+1]-1].  */
+  size_t *start;
+  int (*cmp) (const void *, const void *);
+};
+
+/* Sort bucket I of DATA, a sec_merge_sort.  */
+
+static void
+sort_bucket_job (void *data, size_t i)
+{
+  struct sec_merge_sort *srt = (struct sec_merge_sort *) data;
+
+  if (srt->start[i + 1] - srt->start[i] > 1)
+    qsort (srt->array + srt->start[i], srt->start[i + 1] - srt->start[i],
+	   sizeof (struct sec_merge_hash_entry *), srt->cmp);
+}
+
+/* Sort the COUNT strings in ARRAY with CMP, either strrevcmp or
+   strrevcmp_align with ALIGNMENT, using the linker's threads.  Both
+   comparisons first order the strings by their last character (an
+   empty string coming first), strrevcmp_align doing so after
+   ordering them by the length of their unaligned tail.  So the array
+   is first split into buckets on those keys, and the buckets are
+   then sorted in parallel.  As CMP never returns zero, the result is
+   the same as sorting the whole array with it.  Return false if out
+   of memory.  */
+
+static bool
+sort_strings_parallel (struct bfd_link_info *info,
+		       struct sec_merge_hash_entry **array, size_t count,
+		       int (*cmp) (const void *, const void *),
+		       unsigned int alignment)
+{
+  struct sec_merge_hash_entry **sorted;
+  struct sec_merge_sort srt;
+  size_t nbuckets, i, *pos;
+  unsigned int tails;
+
+  tails = cmp == strrevcmp_align ? alignment : 1;
+  nbuckets = (size_t) tails * 257;
+  srt.start = (size_t *) bfd_zmalloc ((nbuckets + 1) * sizeof (*srt.start));
+  sorted = (struct sec_merge_hash_entry **) bfd_malloc (count
+							* sizeof (*sorted));
+  if (srt.start == NULL || sorted == NULL)
+    {
+      free (srt.start);
+      free (sorted);
+      return false;
+    }
+
+#define SORT_KEY(E) \
+  (((E)->len & (tails - 1)) * 257 \
+   + ((E)->len == 0 \
+      ? 0 : 1 + (unsigned char) (E)->root.string[(E)->len - 1]))
+
+  for (i = 0; i < count; i++)
+    srt.start[SORT_KEY (array[i]) + 1]++;
+  for (i = 0; i < nbuckets; i++)
+    srt.start[i + 1] += srt.start[i];
+  pos = srt.start;
+  for (i = 0; i < count; i++)
+    sorted[pos[SORT_KEY (array[i])]++] = array[i];
+  for (i = nbuckets; i > 0; i--)
+    srt.start[i] = srt.start[i - 1];
+  srt.start[0] = 0;
+
+#undef SORT_KEY
+
+  srt.array = sorted;
+  srt.cmp = cmp;
+  info->callbacks->parallel_for (info, sort_bucket_job, &srt, nbuckets);
+  memcpy (array, sorted, count * sizeof (*sorted));
+  free (sorted);
+  free (srt.start);
+  return true;
+}
+
 /* This is a helper function for _bfd_merge_sections.  It attempts to
    merge strings matching suffixes of longer strings.  */
 static struct sec_merge_sec_info *
-merge_strings (struct sec_merge_info *sinfo)
+merge_strings (struct bfd_link_info *info, struct sec_merge_info *sinfo)
 {
   struct sec_merge_hash_entry **array, **a, *e;
   struct sec_merge_sec_info *secinfo;
@@ -660,10 +1053,26 @@ merge_strings (struct sec_merge_info *sinfo)
   sinfo->htab->size = a - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      int (*sortcmp) (const void *, const void *);
+
+      sortcmp = (alignment != (unsigned) -1
+		 && alignment > sinfo->htab->entsize
+		 ? strrevcmp_align : strrevcmp);
+      if (info->threads > 1
+	  && info->callbacks->parallel_for != NULL
+	  && sinfo->htab->size >= SEC_MERGE_PARALLEL_SORT_MIN
+	  && (sortcmp == strrevcmp || alignment <= 64))
+	{
+	  if (!sort_strings_parallel (info, array, sinfo->htab->size,
+				      sortcmp, alignment))
+	    {
+	      free (array);
+	      return NULL;
+	    }
+	}
+      else
+	qsort (array, (size_t) sinfo->htab->size,
+	       sizeof (struct sec_merge_hash_entry *), sortcmp);
 
       /* Loop over the sorted array and merge suffixes */
       e = *--a;
@@ -734,7 +1143,7 @@ merge_strings (struct sec_merge_info *sinfo)
 
 bool
 _bfd_merge_sections (bfd *abfd,
-		     struct bfd_link_info *info ATTRIBUTE_UNUSED,
+		     struct bfd_link_info *info,
 		     void *xsinfo,
 		     void (*remove_hook) (bfd *, asection *))
 {
@@ -744,6 +1153,8 @@ _bfd_merge_sections (bfd *abfd,
     {
       struct sec_merge_sec_info *secinfo;
       bfd_size_type align;  /* Bytes.  */
+      bfd_size_type total;
+      size_t nsecs;
 
       if (! sinfo->chain)
 	continue;
@@ -755,6 +1166,8 @@ _bfd_merge_sections (bfd *abfd,
 
       /* Record the sections into the hash table.  */
       align = 1;
+      nsecs = 0;
+      total = 0;
       for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
 	if (secinfo->sec->flags & SEC_EXCLUDE)
 	  {
@@ -764,8 +1177,8 @@ _bfd_merge_sections (bfd *abfd,
 	  }
 	else
 	  {
-	    if (!record_section (sinfo, secinfo))
-	      return false;
+	    nsecs++;
+	    total += secinfo->sec->size;
 	    if (align)
 	      {
 		unsigned int opb = bfd_octets_per_byte (abfd, secinfo->sec);
@@ -776,12 +1189,40 @@ _bfd_merge_sections (bfd *abfd,
 	      }
 	  }
 
+      if (nsecs > 1
+	  && total >= SEC_MERGE_PARALLEL_MIN
+	  && info->threads > 1
+	  && info->callbacks->parallel_for != NULL)
+	{
+	  struct sec_merge_sec_info **secs;
+	  size_t i = 0;
+
+	  secs = (struct sec_merge_sec_info **) bfd_malloc (nsecs
+							    * sizeof (*secs));
+	  if (secs == NULL)
+	    return false;
+	  for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+	    if (!(secinfo->sec->flags & SEC_EXCLUDE))
+	      secs[i++] = secinfo;
+	  if (!record_sections_parallel (info, sinfo, secs, nsecs))
+	    {
+	      free (secs);
+	      return false;
+	    }
+	  free (secs);
+	}
+      else
+	for (secinfo = sinfo->chain; secinfo; secinfo = secinfo->next)
+	  if (!(secinfo->sec->flags & SEC_EXCLUDE)
+	      && !record_section (sinfo, secinfo))
+	    return false;
+
       if (sinfo->htab->first == NULL)
 	continue;
 
       if (sinfo->htab->strings)
 	{
-	  secinfo = merge_strings (sinfo);
+	  secinfo = merge_strings (info, sinfo);
 	  if (!secinfo)
 	    return false;
 	}
@@ -957,6 +1398,11 @@ _bfd_merge_sections_free (void *xsinfo)
 
   for (sinfo = (struct sec_merge_info *) xsinfo; sinfo; sinfo = sinfo->next)
     {
+      unsigned int i;
+
+      for (i = 0; i < sinfo->htab->nshards; i++)
+	bfd_hash_table_free (&sinfo->htab->shards[i]);
+      free (sinfo->htab->shards);
       bfd_hash_table_free (&sinfo->htab->table);
       free (sinfo->htab);
     }
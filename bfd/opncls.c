@@ -123,6 +123,7 @@ _bfd_new_bfd_contained_in (bfd *obfd)
 static void
 _bfd_delete_bfd (bfd *abfd)
 {
+  _bfd_free_section_mappings (abfd);
   if (abfd->memory)
     {
       bfd_hash_table_free (&abfd->section_htab);
@@ -132,6 +133,7 @@ _bfd_delete_bfd (bfd *abfd)
     free ((char *) bfd_get_filename (abfd));
 
   free (abfd->arelt_data);
+  free (abfd->armap_names);
   free (abfd);
 }
 
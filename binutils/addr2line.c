@@ -34,6 +34,7 @@
 #include "bfd.h"
 #include "getopt.h"
 #include "libiberty.h"
+#include "hashtab.h"
 #include "demangle.h"
 #include "bucomm.h"
 #include "elf-bfd.h"
@@ -45,6 +46,8 @@ static bool with_functions;	/* -f, show function names.  */
 static bool do_demangle;	/* -C, demangle names.  */
 static bool pretty_print;	/* -p, print on one line.  */
 static bool base_names;		/* -s, strip directory names.  */
+static bool batch_mode;		/* --batch, buffer the output.  */
+static size_t batch_size;	/* --batch=N, addresses per batch.  */
 
 /* Flags passed to the name demangler.  */
 static int demangle_flags = DMGL_PARAMS | DMGL_ANSI;
@@ -55,10 +58,16 @@ static char **addr;		/* Hex addresses to process.  */
 static long symcount;
 static asymbol **syms;		/* Symbol table.  */
 
+enum option_values
+  {
+    OPTION_BATCH = 150
+  };
+
 static struct option long_options[] =
 {
   {"addresses", no_argument, NULL, 'a'},
   {"basenames", no_argument, NULL, 's'},
+  {"batch", optional_argument, NULL, OPTION_BATCH},
   {"demangle", optional_argument, NULL, 'C'},
   {"exe", required_argument, NULL, 'e'},
   {"functions", no_argument, NULL, 'f'},
@@ -92,6 +101,8 @@ usage (FILE *stream, int status)
   fprintf (stream, _(" The options are:\n\
   @<file>                Read options from <file>\n\
   -a --addresses         Show addresses\n\
+  --batch[=<number>]     Read <number> addresses (default all) at a time and\n\
+                          write out their results together\n\
   -b --target=<bfdname>  Set the binary file format\n\
   -e --exe=<executable>  Set the input file name (default is a.out)\n\
   -i --inlines           Unwind inlined functions\n\
@@ -277,152 +288,394 @@ is_symbol (char *adr, char **symp, size_t *offset)
   return true;
 }
 
-/* Read hexadecimal or symbolic with offset addresses from stdin, translate into
-   file_name:line_number and optionally function name.  */
+/* The text describing an address is collected here by out_printf, so
+   that it can be cached and, in batch mode, printed later.  */
 
-static void
-translate_addresses (bfd *abfd, asection *section)
+static char *out_buf;
+static size_t out_len;
+static size_t out_size;
+
+/* Append a formatted string to out_buf.  */
+
+static void ATTRIBUTE_PRINTF_1
+out_printf (const char *format, ...)
 {
-  int read_stdin = (naddr == 0);
-  char *adr;
-  char addr_hex[100];
+  va_list args;
+  int len;
+
+  va_start (args, format);
+  len = vsnprintf (out_buf + out_len, out_size - out_len, format, args);
+  va_end (args);
+  if (len < 0)
+    return;
+
+  if ((size_t) len >= out_size - out_len)
+    {
+      while ((size_t) len >= out_size - out_len)
+	out_size *= 2;
+      out_buf = (char *) xrealloc (out_buf, out_size);
+
+      va_start (args, format);
+      vsnprintf (out_buf + out_len, out_size - out_len, format, args);
+      va_end (args);
+    }
+  out_len += len;
+}
+
+/* Convert the hexadecimal or symbolic with offset address ADR into a
+   value for PC.  */
+
+static bfd_vma
+parse_address (bfd *abfd, char *adr)
+{
+  bfd_vma vma;
   char *symp;
   size_t offset;
 
-  for (;;)
+  if (is_symbol (adr, &symp, &offset))
+    vma = lookup_symbol (abfd, symp, offset);
+  else
+    vma = bfd_scan_vma (adr, NULL, 16);
+  if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
     {
-      if (read_stdin)
-	{
-	  if (fgets (addr_hex, sizeof addr_hex, stdin) == NULL)
-	    break;
-	  adr = addr_hex;
-	}
-      else
-	{
-	  if (naddr <= 0)
-	    break;
-	  --naddr;
-	  adr = *addr++;
-	}
+      const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+      bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
 
-      if (is_symbol (adr, &symp, &offset))
-        pc = lookup_symbol (abfd, symp, offset);
-      else
-        pc = bfd_scan_vma (adr, NULL, 16);
-      if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
-	{
-	  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
-	  bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+      vma &= (sign << 1) - 1;
+      if (bed->sign_extend_vma)
+	vma = (vma ^ sign) - sign;
+    }
+  return vma;
+}
 
-	  pc &= (sign << 1) - 1;
-	  if (bed->sign_extend_vma)
-	    pc = (pc ^ sign) - sign;
-	}
+/* Translate PC into file_name:line_number and optionally function name,
+   and return the text that should be printed for it.  */
+
+static char *
+describe_address (bfd *abfd, asection *section)
+{
+  out_len = 0;
+  out_buf[0] = '\0';
 
-      if (with_addresses)
-        {
-          printf ("0x");
-          bfd_printf_vma (abfd, pc);
+  if (with_addresses)
+    {
+      char vma[64];
 
-          if (pretty_print)
-            printf (": ");
-          else
-            printf ("\n");
-        }
+      bfd_sprintf_vma (abfd, vma, pc);
+      out_printf ("0x%s", vma);
 
-      found = false;
-      if (section)
-	find_offset_in_section (abfd, section);
+      if (pretty_print)
+	out_printf (": ");
       else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
+	out_printf ("\n");
+    }
+
+  found = false;
+  if (section)
+    find_offset_in_section (abfd, section);
+  else
+    bfd_map_over_sections (abfd, find_address_in_section, NULL);
 
-      if (! found)
+  if (! found)
+    {
+      if (with_functions)
+	{
+	  if (pretty_print)
+	    out_printf ("?? ");
+	  else
+	    out_printf ("??\n");
+	}
+      out_printf ("??:0\n");
+    }
+  else
+    {
+      while (1)
 	{
 	  if (with_functions)
 	    {
+	      const char *name;
+	      char *alloc = NULL;
+
+	      name = functionname;
+	      if (name == NULL || *name == '\0')
+		name = "??";
+	      else if (do_demangle)
+		{
+		  alloc = bfd_demangle (abfd, name, demangle_flags);
+		  if (alloc != NULL)
+		    name = alloc;
+		}
+
+	      out_printf ("%s", name);
 	      if (pretty_print)
-		printf ("?? ");
+		/* Note for translators:  This printf is used to join the
+		   function name just printed above to the line number/
+		   file name pair that is about to be printed below.  Eg:
+
+		     foo at 123:bar.c  */
+		out_printf (_(" at "));
+	      else
+		out_printf ("\n");
+
+	      free (alloc);
+	    }
+
+	  if (base_names && filename != NULL)
+	    {
+	      char *h;
+
+	      h = strrchr (filename, '/');
+	      if (h != NULL)
+		filename = h + 1;
+	    }
+
+	  out_printf ("%s:", filename ? filename : "??");
+	  if (line != 0)
+	    {
+	      if (discriminator != 0)
+		out_printf ("%u (discriminator %u)\n", line, discriminator);
 	      else
-		printf ("??\n");
+		out_printf ("%u\n", line);
 	    }
-	  printf ("??:0\n");
+	  else
+	    out_printf ("?\n");
+	  if (!unwind_inlines)
+	    found = false;
+	  else
+	    found = bfd_find_inliner_info (abfd, &filename, &functionname,
+					   &line);
+	  if (! found)
+	    break;
+	  if (pretty_print)
+	    /* Note for translators: This printf is used to join the
+	       line number/file name pair that has just been printed with
+	       the line number/file name pair that is going to be printed
+	       by the next iteration of the while loop.  Eg:
+
+		 123:bar.c (inlined by) 456:main.c  */
+	    out_printf (_(" (inlined by) "));
 	}
-      else
+    }
+
+  return xmemdup (out_buf, out_len, out_len + 1);
+}
+
+/* A cache of the most recently described addresses, so that addresses
+   which are asked for again and again are only looked up once.  The
+   entries are kept in a hash table, and on a list from the most to
+   the least recently used.  */
+
+#define ADDR_CACHE_SIZE 4096
+
+struct addr_cache_entry
+{
+  bfd_vma pc;
+  char *text;
+  struct addr_cache_entry *newer;
+  struct addr_cache_entry *older;
+};
+
+static htab_t addr_cache;
+static struct addr_cache_entry *addr_cache_newest;
+static struct addr_cache_entry *addr_cache_oldest;
+
+static hashval_t
+addr_cache_hash (const void *p)
+{
+  const struct addr_cache_entry *e = (const struct addr_cache_entry *) p;
+
+  return (hashval_t) (e->pc ^ (e->pc >> 31));
+}
+
+static int
+addr_cache_eq (const void *p1, const void *p2)
+{
+  const struct addr_cache_entry *e1 = (const struct addr_cache_entry *) p1;
+  const struct addr_cache_entry *e2 = (const struct addr_cache_entry *) p2;
+
+  return e1->pc == e2->pc;
+}
+
+static void
+addr_cache_del (void *p)
+{
+  struct addr_cache_entry *e = (struct addr_cache_entry *) p;
+
+  free (e->text);
+  free (e);
+}
+
+/* Unlink entry E from the list of entries.  */
+
+static void
+addr_cache_unlink (struct addr_cache_entry *e)
+{
+  if (e->newer != NULL)
+    e->newer->older = e->older;
+  else
+    addr_cache_newest = e->older;
+  if (e->older != NULL)
+    e->older->newer = e->newer;
+  else
+    addr_cache_oldest = e->newer;
+}
+
+/* Make entry E the most recently used one.  */
+
+static void
+addr_cache_push (struct addr_cache_entry *e)
+{
+  e->newer = NULL;
+  e->older = addr_cache_newest;
+  if (addr_cache_newest != NULL)
+    addr_cache_newest->newer = e;
+  else
+    addr_cache_oldest = e;
+  addr_cache_newest = e;
+}
+
+/* Return the text for PC, describing it if it is not in the cache.
+   The text belongs to the cache and is only valid until the next
+   call.  */
+
+static const char *
+lookup_address (bfd *abfd, asection *section)
+{
+  struct addr_cache_entry key, *e;
+  void **slot;
+
+  key.pc = pc;
+  slot = htab_find_slot (addr_cache, &key, INSERT);
+  e = (struct addr_cache_entry *) *slot;
+  if (e != NULL)
+    {
+      addr_cache_unlink (e);
+      addr_cache_push (e);
+      return e->text;
+    }
+
+  e = (struct addr_cache_entry *) xmalloc (sizeof (*e));
+  e->pc = pc;
+  e->text = describe_address (abfd, section);
+  *slot = e;
+  addr_cache_push (e);
+
+  if (htab_elements (addr_cache) > ADDR_CACHE_SIZE)
+    {
+      struct addr_cache_entry *old = addr_cache_oldest;
+
+      addr_cache_unlink (old);
+      htab_remove_elt (addr_cache, old);
+    }
+
+  return e->text;
+}
+
+/* Return the next hexadecimal or symbolic with offset address from the
+   command line, or if READ_STDIN read it from stdin into BUF.  Returns
+   NULL if there are no more.  */
+
+static char *
+next_address (bool read_stdin, char *buf, int size)
+{
+  if (read_stdin)
+    return fgets (buf, size, stdin);
+
+  if (naddr <= 0)
+    return NULL;
+  --naddr;
+  return *addr++;
+}
+
+/* Translate up to BATCH_SIZE addresses at a time, and write out the
+   results of each batch at once.  The addresses are looked up in the
+   order in which they were given, just as they are without --batch,
+   since the function names that BFD reports for some addresses depend
+   on which addresses were looked up before them.  */
+
+static void
+translate_address_batches (bfd *abfd, asection *section, bool read_stdin)
+{
+  char *text;
+  size_t len, max, count;
+  char addr_hex[100];
+  char *adr;
+  bool more = true;
+
+  max = 4096;
+  text = (char *) xmalloc (max);
+
+  while (more)
+    {
+      len = 0;
+      for (count = 0; batch_size == 0 || count < batch_size; count++)
 	{
-	  while (1)
-            {
-              if (with_functions)
-                {
-                  const char *name;
-                  char *alloc = NULL;
-
-                  name = functionname;
-                  if (name == NULL || *name == '\0')
-                    name = "??";
-                  else if (do_demangle)
-                    {
-                      alloc = bfd_demangle (abfd, name, demangle_flags);
-                      if (alloc != NULL)
-                        name = alloc;
-                    }
-
-                  printf ("%s", name);
-                  if (pretty_print)
-		    /* Note for translators:  This printf is used to join the
-		       function name just printed above to the line number/
-		       file name pair that is about to be printed below.  Eg:
-
-		         foo at 123:bar.c  */
-                    printf (_(" at "));
-                  else
-                    printf ("\n");
-
-		  free (alloc);
-                }
-
-              if (base_names && filename != NULL)
-                {
-                  char *h;
-
-                  h = strrchr (filename, '/');
-                  if (h != NULL)
-                    filename = h + 1;
-                }
-
-              printf ("%s:", filename ? filename : "??");
-	      if (line != 0)
-                {
-                  if (discriminator != 0)
-                    printf ("%u (discriminator %u)\n", line, discriminator);
-                  else
-                    printf ("%u\n", line);
-                }
-	      else
-		printf ("?\n");
-              if (!unwind_inlines)
-                found = false;
-              else
-                found = bfd_find_inliner_info (abfd, &filename, &functionname,
-					       &line);
-              if (! found)
-                break;
-              if (pretty_print)
-		/* Note for translators: This printf is used to join the
-		   line number/file name pair that has just been printed with
-		   the line number/file name pair that is going to be printed
-		   by the next iteration of the while loop.  Eg:
-
-		     123:bar.c (inlined by) 456:main.c  */
-                printf (_(" (inlined by) "));
-            }
+	  const char *result;
+	  size_t n;
+
+	  adr = next_address (read_stdin, addr_hex, sizeof addr_hex);
+	  if (adr == NULL)
+	    {
+	      more = false;
+	      break;
+	    }
+	  pc = parse_address (abfd, adr);
+	  result = lookup_address (abfd, section);
+	  n = strlen (result);
+	  if (len + n > max)
+	    {
+	      while (len + n > max)
+		max *= 2;
+	      text = (char *) xrealloc (text, max);
+	    }
+	  memcpy (text + len, result, n);
+	  len += n;
 	}
 
-      /* fflush() is essential for using this command as a server
-         child process that reads addresses from a pipe and responds
-         with line number information, processing one address at a
-         time.  */
+      fwrite (text, 1, len, stdout);
       fflush (stdout);
     }
+
+  free (text);
+}
+
+/* Read hexadecimal or symbolic with offset addresses from stdin, translate into
+   file_name:line_number and optionally function name.  */
+
+static void
+translate_addresses (bfd *abfd, asection *section)
+{
+  bool read_stdin = (naddr == 0);
+  char addr_hex[100];
+  char *adr;
+
+  out_size = 256;
+  out_buf = (char *) xmalloc (out_size);
+  addr_cache = htab_create_alloc (ADDR_CACHE_SIZE * 2, addr_cache_hash,
+				  addr_cache_eq, addr_cache_del,
+				  xcalloc, free);
+
+  if (batch_mode)
+    translate_address_batches (abfd, section, read_stdin);
+  else
+    while ((adr = next_address (read_stdin, addr_hex,
+				sizeof addr_hex)) != NULL)
+      {
+	pc = parse_address (abfd, adr);
+	fputs (lookup_address (abfd, section), stdout);
+
+	/* fflush() is essential for using this command as a server
+	   child process that reads addresses from a pipe and responds
+	   with line number information, processing one address at a
+	   time.  */
+	fflush (stdout);
+      }
+
+  htab_delete (addr_cache);
+  addr_cache = NULL;
+  addr_cache_newest = addr_cache_oldest = NULL;
+  free (out_buf);
+  out_buf = NULL;
 }
 
 /* Process a file.  Returns an exit value for main().  */
@@ -564,6 +817,18 @@ main (int argc, char **argv)
 	case 'j':
 	  section_name = optarg;
 	  break;
+	case OPTION_BATCH:
+	  batch_mode = true;
+	  batch_size = 0;
+	  if (optarg != NULL)
+	    {
+	      char *end;
+
+	      batch_size = strtoul (optarg, &end, 0);
+	      if (*end != '\0' || batch_size == 0)
+		fatal (_("invalid batch size: %s"), optarg);
+	    }
+	  break;
 	default:
 	  usage (stderr, 1);
 	  break;
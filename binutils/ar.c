@@ -37,6 +37,11 @@
 #include "plugin.h"
 #include "ansidecl.h"
 
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#include <sys/wait.h>
+#define PARALLEL_ARMAP 1
+#endif
+
 #ifdef __GO32___
 #define EXT_NAME_LEN 3		/* Bufflen of addition to name if it's MS-DOS.  */
 #else
@@ -100,6 +105,10 @@ int write_armap = 0;
    consistent file modes.  */
 int deterministic = -1;			/* Determinism indeterminate.  */
 
+/* The number of processes to use to read the symbol tables of the
+   members when writing an archive symbol table.  */
+static unsigned int armap_jobs = 1;
+
 /* Nonzero means it's the name of an existing member; position new or moved
    files with respect to this one.  */
 char *posname = NULL;
@@ -159,7 +168,8 @@ enum long_option_numbers
 {
   OPTION_PLUGIN = 201,
   OPTION_TARGET,
-  OPTION_OUTPUT
+  OPTION_OUTPUT,
+  OPTION_THREADS
 };
 
 static const char * output_dir = NULL;
@@ -173,6 +183,7 @@ static struct option long_options[] =
   {"output", required_argument, NULL, OPTION_OUTPUT},
   {"record-libdeps", required_argument, NULL, 'l'},
   {"thin", no_argument, NULL, 'T'},
+  {"threads", optional_argument, NULL, OPTION_THREADS},
   {NULL, no_argument, NULL, 0}
 };
 
@@ -346,6 +357,7 @@ usage (int help)
   fprintf (s, _("  --output=DIRNAME - specify the output directory for extraction operations\n"));
   fprintf (s, _("  --record-libdeps=<text> - specify the dependencies of this library\n"));
   fprintf (s, _("  --thin       - make a thin archive\n"));
+  fprintf (s, _("  --threads[=N] - read symbol tables for the index in up to N processes\n"));
 #if BFD_SUPPORTS_PLUGINS
   fprintf (s, _(" optional:\n"));
   fprintf (s, _("  --plugin <p> - load the specified plugin\n"));
@@ -387,6 +399,7 @@ ranlib_usage (int help)
   -U                           Use actual symbol map timestamp (default)\n"));
   fprintf (s, _("\
   -t                           Update the archive's symbol map timestamp\n\
+  --threads[=N]                Read symbol tables in up to N processes\n\
   -h --help                    Print this help message\n\
   -v --version                 Print version information\n"));
 
@@ -617,6 +630,9 @@ decode_options (int argc, char **argv)
 	case OPTION_OUTPUT:
 	  output_dir = optarg;
 	  break;
+	case OPTION_THREADS:
+	  armap_jobs = parse_thread_count (optarg, "--threads");
+	  break;
 	case 0:		/* A long option that just sets a flag.  */
 	  break;
         default:
@@ -686,6 +702,10 @@ ranlib_main (int argc, char **argv)
 	  xexit (1);
 #endif
 	  break;
+
+	case OPTION_THREADS:
+	  armap_jobs = parse_thread_count (optarg, "--threads");
+	  break;
 	}
     }
 
@@ -1248,6 +1268,188 @@ extract_file (bfd *abfd)
   output_filename = NULL;
 }
 
+#ifdef PARALLEL_ARMAP
+/* Archives with fewer members than this for each process are not
+   worth forking for.  */
+#define ARMAP_MEMBERS_PER_JOB 64
+
+/* A range of consecutive members whose symbol map names are found in
+   a child process.  */
+
+struct armap_job
+{
+  bfd **members;	/* The first member.  */
+  size_t count;		/* The number of members.  */
+  pid_t pid;		/* The child, or -1 if not forked.  */
+  FILE *out;		/* What the child found.  */
+  FILE *err;		/* What the child wrote to stderr.  */
+};
+
+/* Write the symbol map names of JOB's members to JOB->out, as the size
+   of the names, their count and the names themselves for each member
+   in turn.  This runs in the child and never returns.  */
+
+static void
+write_armap_job (struct armap_job *job)
+{
+  size_t i;
+
+  if (dup2 (fileno (job->err), STDERR_FILENO) < 0)
+    _exit (2);
+
+  for (i = 0; i < job->count; i++)
+    {
+      char *names;
+      size_t size;
+      long count;
+
+      count = bfd_get_armap_names (job->members[i], &names, &size);
+      if (count < 0)
+	_exit (1);
+      if (fwrite (&size, sizeof (size), 1, job->out) != 1
+	  || fwrite (&count, sizeof (count), 1, job->out) != 1
+	  || fwrite (names, 1, size, job->out) != size)
+	_exit (1);
+      free (names);
+    }
+
+  if (fflush (job->out) != 0)
+    _exit (1);
+  fflush (stderr);
+  _exit (0);
+}
+
+/* Wait for the child running JOB, and if it succeeded without saying
+   anything pass the names it found to BFD.  Otherwise, or if no child
+   was started, leave the members alone so that BFD reads their symbol
+   tables itself when the archive is written, repeating any errors or
+   warnings in the usual order.  */
+
+static void
+read_armap_job (struct armap_job *job)
+{
+  char *names = NULL;
+  size_t names_max = 0;
+  size_t i;
+  int status;
+
+  if (job->pid < 0)
+    return;
+
+  while (waitpid (job->pid, &status, 0) < 0)
+    if (errno != EINTR)
+      {
+	status = -1;
+	break;
+      }
+
+  if (status == 0
+      && fseek (job->err, 0, SEEK_END) == 0
+      && ftell (job->err) == 0)
+    {
+      rewind (job->out);
+      for (i = 0; i < job->count; i++)
+	{
+	  size_t size;
+	  long count;
+
+	  if (fread (&size, sizeof (size), 1, job->out) != 1
+	      || fread (&count, sizeof (count), 1, job->out) != 1)
+	    break;
+	  if (size > names_max)
+	    {
+	      names_max = size;
+	      names = xrealloc (names, names_max);
+	    }
+	  if (fread (names, 1, size, job->out) != size)
+	    break;
+	  bfd_set_armap_names (job->members[i], names, size, count);
+	}
+      free (names);
+    }
+
+  fclose (job->out);
+  fclose (job->err);
+}
+
+/* Find the symbol map names of the members of ARCH, an archive about
+   to be written, using up to ARMAP_JOBS child processes which each
+   read the symbol tables of a range of consecutive members.  */
+
+static void
+get_armap_names_in_parallel (bfd *arch)
+{
+  struct armap_job *jobs;
+  bfd **members;
+  bfd *current;
+  size_t count, njobs, i, first;
+
+  count = 0;
+  for (current = arch->archive_head; current; current = current->archive_next)
+    count++;
+
+  njobs = count / ARMAP_MEMBERS_PER_JOB;
+  if (njobs > armap_jobs)
+    njobs = armap_jobs;
+  if (njobs < 2)
+    return;
+
+  members = xmalloc (count * sizeof (*members));
+  count = 0;
+  for (current = arch->archive_head; current; current = current->archive_next)
+    {
+      bfd *b;
+
+      members[count++] = current;
+
+      /* The children must not share the parent's open files, as they
+	 would then move each other's file positions.  */
+      for (b = current; b != NULL; b = b->my_archive)
+	bfd_cache_close (b);
+    }
+
+  /* Flush anything the children would otherwise inherit and write
+     again.  */
+  fflush (stdout);
+  fflush (stderr);
+
+  jobs = xmalloc (njobs * sizeof (*jobs));
+  first = 0;
+  for (i = 0; i < njobs; i++)
+    {
+      struct armap_job *job = &jobs[i];
+      size_t last = (count * (i + 1)) / njobs;
+
+      job->members = members + first;
+      job->count = last - first;
+      first = last;
+
+      job->pid = -1;
+      job->out = tmpfile ();
+      job->err = tmpfile ();
+      if (job->out != NULL && job->err != NULL)
+	job->pid = fork ();
+
+      if (job->pid == 0)
+	write_armap_job (job);
+
+      if (job->pid < 0)
+	{
+	  if (job->out != NULL)
+	    fclose (job->out);
+	  if (job->err != NULL)
+	    fclose (job->err);
+	}
+    }
+
+  for (i = 0; i < njobs; i++)
+    read_armap_job (&jobs[i]);
+
+  free (jobs);
+  free (members);
+}
+#endif /* PARALLEL_ARMAP */
+
 static void
 write_archive (bfd *iarch)
 {
@@ -1299,6 +1501,11 @@ write_archive (bfd *iarch)
   if (!bfd_set_archive_head (obfd, contents_head))
     bfd_fatal (old_name);
 
+#ifdef PARALLEL_ARMAP
+  if (obfd->has_armap && armap_jobs > 1)
+    get_armap_names_in_parallel (obfd);
+#endif
+
   tmpfd = dup (tmpfd);
   if (!bfd_close (obfd))
     bfd_fatal (old_name);
@@ -27,6 +27,9 @@
 #include "filenames.h"
 #include <time.h>
 #include <assert.h>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
 #include "bucomm.h"
 
 /* Error reporting.  */
@@ -708,3 +711,104 @@ is_valid_archive_path (char const * pathname)
 
   return true;
 }
+
+/* Parse ARG, the argument of a --threads option of OPTION.  With no
+   argument, return the number of online processors.  */
+
+unsigned int
+parse_thread_count (const char *arg, const char *option)
+{
+  char *end;
+  unsigned long count;
+
+  if (arg == NULL)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+      long ncpus = sysconf (_SC_NPROCESSORS_ONLN);
+      return ncpus > 0 ? ncpus : 1;
+#else
+      return 1;
+#endif
+    }
+
+  count = strtoul (arg, &end, 0);
+  if (*end != '\0' || count == 0 || count != (unsigned int) count)
+    fatal (_("%s: invalid thread count: %s"), option, arg);
+  return count;
+}
+
+#ifdef HAVE_PTHREAD
+struct parallel_for_data
+{
+  void (*fn) (void *, size_t);
+  void *data;
+  size_t count;
+  size_t next;
+  pthread_mutex_t next_lock;
+};
+
+static void *
+parallel_for_worker (void *arg)
+{
+  struct parallel_for_data *pf = (struct parallel_for_data *) arg;
+
+  for (;;)
+    {
+      size_t i;
+
+      pthread_mutex_lock (&pf->next_lock);
+      i = pf->next++;
+      pthread_mutex_unlock (&pf->next_lock);
+      if (i >= pf->count)
+	break;
+      pf->fn (pf->data, i);
+    }
+  return NULL;
+}
+#endif
+
+/* Call FN (DATA, I) for each I below COUNT, spreading the calls over
+   up to THREADS threads.  Returns once all calls are done.  FN must
+   not touch any state shared with the other calls without locking.  */
+
+void
+bu_parallel_for (unsigned int threads, void (*fn) (void *, size_t),
+		 void *data, size_t count)
+{
+#ifdef HAVE_PTHREAD
+  struct parallel_for_data pf;
+  pthread_t *tids;
+  size_t nthreads, started, i;
+
+  nthreads = threads < count ? threads : count;
+  if (nthreads > 1)
+    {
+      pf.fn = fn;
+      pf.data = data;
+      pf.count = count;
+      pf.next = 0;
+      pthread_mutex_init (&pf.next_lock, NULL);
+
+      tids = (pthread_t *) xmalloc ((nthreads - 1) * sizeof (*tids));
+      for (started = 0; started < nthreads - 1; started++)
+	if (pthread_create (&tids[started], NULL, parallel_for_worker,
+			    &pf) != 0)
+	  break;
+
+      /* The calling thread takes its share too, which also covers the
+	 case where no thread could be started.  */
+      parallel_for_worker (&pf);
+      for (i = 0; i < started; i++)
+	pthread_join (tids[i], NULL);
+      free (tids);
+      pthread_mutex_destroy (&pf.next_lock);
+      return;
+    }
+#else
+  size_t i;
+  (void) threads;
+#endif
+
+  for (i = 0; i < count; i++)
+    fn (data, i);
+}
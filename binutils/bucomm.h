@@ -62,6 +62,11 @@ off_t get_file_size (const char *);
 
 bool is_valid_archive_path (char const *);
 
+unsigned int parse_thread_count (const char *, const char *);
+
+void bu_parallel_for (unsigned int, void (*) (void *, size_t), void *,
+		      size_t);
+
 extern char *program_name;
 
 /* In filemode.c.  */
@@ -36,6 +36,12 @@
 #include <elfutils/debuginfod.h>
 #endif
 
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#include <signal.h>
+#include <sys/wait.h>
+#define PARALLEL_DEBUG_INFO 1
+#endif
+
 #include <limits.h>
 #ifndef CHAR_BIT
 #define CHAR_BIT 8
@@ -116,6 +122,7 @@ bool do_checks;
 
 int dwarf_cutoff_level = -1;
 unsigned long dwarf_start_die;
+unsigned int dwarf_jobs = 1;
 
 int dwarf_check = 0;
 
@@ -2992,7 +2999,10 @@ read_and_display_attr_value (unsigned long           attribute,
 			      cu_offset);
 		break;
 	      case DW_FORM_string:
-		add_dwo_name ((const char *) orig_data, cu_offset);
+		/* The section is not NUL terminated when it is mapped.  */
+		if (strnlen ((const char *) orig_data, end - orig_data)
+		    < (size_t) (end - orig_data))
+		  add_dwo_name ((const char *) orig_data, cu_offset);
 		break;
 	      default:
 		warn (_("Unsupported form (%s) for attribute %s\n"),
@@ -3026,7 +3036,10 @@ read_and_display_attr_value (unsigned long           attribute,
 			     cu_offset);
 		break;
 	      case DW_FORM_string:
-		add_dwo_dir ((const char *) orig_data, cu_offset);
+		/* The section is not NUL terminated when it is mapped.  */
+		if (strnlen ((const char *) orig_data, end - orig_data)
+		    < (size_t) (end - orig_data))
+		  add_dwo_dir ((const char *) orig_data, cu_offset);
 		break;
 	      default:
 		warn (_("Unsupported form (%s) for attribute %s\n"),
@@ -3536,6 +3549,16 @@ introduce (struct dwarf_section * section, bool raw)
     }
 }
 
+static int process_debug_info_units (struct dwarf_section *,
+				     enum dwarf_section_display_enum,
+				     unsigned char *, unsigned char *,
+				     unsigned int, bool, bool);
+#ifdef PARALLEL_DEBUG_INFO
+static int process_debug_info_parallel (struct dwarf_section *,
+					enum dwarf_section_display_enum,
+					unsigned int);
+#endif
+
 /* Process the contents of a .debug_info section.
    If do_loc is TRUE then we are scanning for location lists and dwo tags
    and we do not want to display anything to the user.
@@ -3556,8 +3579,11 @@ process_debug_info (struct dwarf_section * section,
   unsigned char *start = section->start;
   unsigned char *end = start + section->size;
   unsigned char *section_begin;
-  unsigned int unit;
   unsigned int num_units = 0;
+#ifdef PARALLEL_DEBUG_INFO
+  bool parallel = false;
+#endif
+  int status;
 
   /* First scan the section to get the number of comp units.
      Length sanity checks are done here.  */
@@ -3600,6 +3626,14 @@ process_debug_info (struct dwarf_section * section,
       return false;
     }
 
+#ifdef PARALLEL_DEBUG_INFO
+  /* Strings in separate debug files are loaded on demand, which the
+     children cannot do safely through the shared file handles.  */
+  parallel = (dwarf_jobs > 1 && num_units > 1
+	      && !do_loc && !do_types && dwarf_start_die == 0
+	      && first_separate_info == NULL);
+#endif
+
   if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
       && num_debug_info_entries == 0
       && ! do_types)
@@ -3744,7 +3778,57 @@ process_debug_info (struct dwarf_section * section,
       record_abbrev_list_for_cu (cu_offset, start - section_begin, list);
     }
 
-  for (start = section_begin, unit = 0; start < end; unit++)
+#ifdef PARALLEL_DEBUG_INFO
+  if (parallel)
+    status = process_debug_info_parallel (section, abbrev_sec, num_units);
+  else
+#endif
+    status = process_debug_info_units (section, abbrev_sec, section_begin,
+				       end, 0, do_loc, do_types);
+  switch (status)
+    {
+    case -1:
+      return false;
+    case 0:
+      return true;
+    }
+
+  /* Set num_debug_info_entries here so that it can be used to check if
+     we need to process .debug_loc and .debug_ranges sections.  */
+  if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
+      && num_debug_info_entries == 0
+      && ! do_types)
+    {
+      if (num_units > alloc_num_debug_info_entries)
+	num_debug_info_entries = alloc_num_debug_info_entries;
+      else
+	num_debug_info_entries = num_units;
+    }
+
+  if (!do_loc)
+    printf ("\n");
+
+  return true;
+}
+
+/* Process the units of SECTION that lie between START and LIMIT for
+   process_debug_info, numbering them from UNIT.  Returns 1 once all of
+   them have been processed, 0 if the display stopped early after the
+   children of DWARF_START_DIE, or -1 upon error.  */
+
+static int
+process_debug_info_units (struct dwarf_section *section,
+			  enum dwarf_section_display_enum abbrev_sec,
+			  unsigned char *start,
+			  unsigned char *limit,
+			  unsigned int unit,
+			  bool do_loc,
+			  bool do_types)
+{
+  unsigned char *section_begin = section->start;
+  unsigned char *end = section_begin + section->size;
+
+  for (; start < limit; unit++)
     {
       DWARF2_Internal_CompUnit compunit;
       unsigned char *hdrptr;
@@ -4002,7 +4086,7 @@ process_debug_info (struct dwarf_section * section,
 		    }
 		}
 	      if (dwarf_start_die != 0 && level < saved_level)
-		return true;
+		return 0;
 	      continue;
 	    }
 
@@ -4044,7 +4128,7 @@ process_debug_info (struct dwarf_section * section,
 		}
 	      warn (_("DIE at offset 0x%lx refers to abbreviation number %lu which does not exist\n"),
 		    die_offset, abbrev_number);
-	      return false;
+	      return -1;
 	    }
 
 	  if (!do_loc && do_printing)
@@ -4130,24 +4214,358 @@ process_debug_info (struct dwarf_section * section,
 	}
     }
 
-  /* Set num_debug_info_entries here so that it can be used to check if
-     we need to process .debug_loc and .debug_ranges sections.  */
-  if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
-      && num_debug_info_entries == 0
-      && ! do_types)
+  return 1;
+}
+
+#ifdef PARALLEL_DEBUG_INFO
+
+/* The units of a .debug_info section are split into about this many
+   groups per job, so that a group holding a huge unit does not leave
+   the other jobs idle for long.  */
+#define DEBUG_INFO_GROUPS_PER_JOB 4
+
+/* A run of consecutive units decoded by a child process.  */
+
+struct debug_info_group
+{
+  unsigned char *start;		/* The first unit in the group.  */
+  unsigned char *limit;		/* The end of the last unit.  */
+  unsigned int first_unit;	/* The number of the first unit.  */
+  unsigned int num_units;	/* The number of units.  */
+  pid_t pid;			/* The child, or -1 if not forked.  */
+  FILE *out;			/* What the child wrote to stdout.  */
+  FILE *err;			/* What the child wrote to stderr.  */
+  FILE *records;		/* The debug_information it recorded, or
+				   NULL if none is being recorded.  */
+};
+
+/* Whether process_debug_info_units is filling in debug_information
+   for the units it processes.  */
+
+static bool
+recording_debug_info (void)
+{
+  return debug_information != NULL && num_debug_info_entries == 0;
+}
+
+/* The number of entries in the location list arrays of D.  */
+
+static unsigned int
+num_loc_entries (const debug_info *d)
+{
+  return (d->num_loc_offsets > d->num_loc_views
+	  ? d->num_loc_offsets : d->num_loc_views);
+}
+
+/* Write the debug_information of the units of GROUP to FILE, to be
+   read back by read_debug_info_records in the parent.  Returns TRUE
+   upon success.  */
+
+static bool
+write_debug_info_records (FILE *file, struct debug_info_group *group)
+{
+  unsigned int unit;
+
+  for (unit = group->first_unit;
+       unit < group->first_unit + group->num_units
+	 && unit < alloc_num_debug_info_entries;
+       unit++)
     {
-      if (num_units > alloc_num_debug_info_entries)
-	num_debug_info_entries = alloc_num_debug_info_entries;
-      else
-	num_debug_info_entries = num_units;
+      debug_info *d = debug_information + unit;
+      unsigned int nloc = num_loc_entries (d);
+
+      if (fwrite (d, sizeof (*d), 1, file) != 1)
+	return false;
+      if (d->max_loc_offsets != 0
+	  && (fwrite (d->loc_offsets, sizeof (*d->loc_offsets), nloc,
+		      file) != nloc
+	      || fwrite (d->loc_views, sizeof (*d->loc_views), nloc,
+			 file) != nloc
+	      || fwrite (d->have_frame_base, sizeof (*d->have_frame_base),
+			 nloc, file) != nloc))
+	return false;
+      if (d->max_range_lists != 0
+	  && fwrite (d->range_lists, sizeof (*d->range_lists),
+		     d->num_range_lists, file) != d->num_range_lists)
+	return false;
     }
 
-  if (!do_loc)
-    printf ("\n");
+  return fflush (file) == 0;
+}
 
-  return true;
+/* Read the debug_information of the units of GROUP written by its
+   child into FILE.  Returns FALSE if that fails, in which case the
+   records of the group are left empty.  */
+
+static bool
+read_debug_info_records (FILE *file, struct debug_info_group *group)
+{
+  unsigned int unit, last;
+
+  rewind (file);
+  for (unit = group->first_unit;
+       unit < group->first_unit + group->num_units
+	 && unit < alloc_num_debug_info_entries;
+       unit++)
+    {
+      debug_info *d = debug_information + unit;
+      unsigned int nloc;
+
+      /* The pointers are the child's; do not keep them.  */
+      if (fread (d, sizeof (*d), 1, file) != 1)
+	break;
+      d->loc_offsets = d->loc_views = d->range_lists = NULL;
+      d->have_frame_base = NULL;
+
+      nloc = num_loc_entries (d);
+      if (nloc > d->max_loc_offsets || d->num_range_lists > d->max_range_lists)
+	break;
+      if (d->max_loc_offsets != 0)
+	{
+	  d->loc_offsets = xcmalloc (d->max_loc_offsets,
+				     sizeof (*d->loc_offsets));
+	  d->loc_views = xcmalloc (d->max_loc_offsets, sizeof (*d->loc_views));
+	  d->have_frame_base = xcmalloc (d->max_loc_offsets,
+					 sizeof (*d->have_frame_base));
+	  if (fread (d->loc_offsets, sizeof (*d->loc_offsets), nloc,
+		     file) != nloc
+	      || fread (d->loc_views, sizeof (*d->loc_views), nloc,
+			file) != nloc
+	      || fread (d->have_frame_base, sizeof (*d->have_frame_base),
+			nloc, file) != nloc)
+	    break;
+	}
+      if (d->max_range_lists != 0)
+	{
+	  d->range_lists = xcmalloc (d->max_range_lists,
+				     sizeof (*d->range_lists));
+	  if (fread (d->range_lists, sizeof (*d->range_lists),
+		     d->num_range_lists, file) != d->num_range_lists)
+	    break;
+	}
+    }
+
+  if (unit >= group->first_unit + group->num_units
+      || unit >= alloc_num_debug_info_entries)
+    return true;
+
+  last = unit;
+  for (unit = group->first_unit; unit <= last; unit++)
+    {
+      debug_info *d = debug_information + unit;
+
+      free (d->loc_offsets);
+      free (d->loc_views);
+      free (d->have_frame_base);
+      free (d->range_lists);
+      memset (d, 0, sizeof (*d));
+    }
+  return false;
+}
+
+/* Fork a child to decode GROUP with its standard output and error
+   redirected into temporary files.  If that is not possible leave
+   GROUP->pid as -1 so that the parent decodes it itself later.  */
+
+static void
+start_debug_info_group (struct dwarf_section *section,
+			enum dwarf_section_display_enum abbrev_sec,
+			struct debug_info_group *group)
+{
+  bool record = recording_debug_info ();
+
+  group->pid = -1;
+  group->out = tmpfile ();
+  group->err = tmpfile ();
+  group->records = record ? tmpfile () : NULL;
+  if (group->out != NULL && group->err != NULL
+      && (!record || group->records != NULL))
+    group->pid = fork ();
+
+  if (group->pid == 0)
+    {
+      int status;
+
+      if (dup2 (fileno (group->out), STDOUT_FILENO) < 0
+	  || dup2 (fileno (group->err), STDERR_FILENO) < 0)
+	_exit (2);
+      status = process_debug_info_units (section, abbrev_sec, group->start,
+					 group->limit, group->first_unit,
+					 false, false);
+      fflush (stdout);
+      fflush (stderr);
+      if (group->records != NULL
+	  && !write_debug_info_records (group->records, group))
+	_exit (2);
+      _exit (status < 0);
+    }
+
+  if (group->pid < 0)
+    {
+      if (group->out != NULL)
+	fclose (group->out);
+      if (group->err != NULL)
+	fclose (group->err);
+      if (group->records != NULL)
+	fclose (group->records);
+      group->out = group->err = group->records = NULL;
+    }
+}
+
+/* Copy the contents of the temporary file FROM to TO and close it.  */
+
+static void
+copy_debug_info_output (FILE *from, FILE *to)
+{
+  char buf[8192];
+  size_t len;
+
+  rewind (from);
+  while ((len = fread (buf, 1, sizeof (buf), from)) != 0)
+    fwrite (buf, 1, len, to);
+  fclose (from);
+}
+
+/* Close the temporary files of GROUP.  */
+
+static void
+close_debug_info_group (struct debug_info_group *group)
+{
+  fclose (group->out);
+  fclose (group->err);
+  if (group->records != NULL)
+    fclose (group->records);
+}
+
+/* Wait for the child decoding GROUP and copy its output and the
+   debug_information it recorded, or decode GROUP now if no child was
+   started.  Returns the same values as process_debug_info_units.  */
+
+static int
+finish_debug_info_group (struct dwarf_section *section,
+			 enum dwarf_section_display_enum abbrev_sec,
+			 struct debug_info_group *group)
+{
+  int status;
+
+  if (group->pid < 0)
+    return process_debug_info_units (section, abbrev_sec, group->start,
+				     group->limit, group->first_unit,
+				     false, false);
+
+  while (waitpid (group->pid, &status, 0) < 0)
+    if (errno != EINTR)
+      {
+	status = -1;
+	break;
+      }
+
+  if ((status == 0 || (WIFEXITED (status) && WEXITSTATUS (status) == 1))
+      && (group->records == NULL
+	  || read_debug_info_records (group->records, group)))
+    {
+      if (group->records != NULL)
+	fclose (group->records);
+      copy_debug_info_output (group->out, stdout);
+      fflush (stdout);
+      copy_debug_info_output (group->err, stderr);
+      return status == 0 ? 1 : -1;
+    }
+
+  /* The child failed to start or died; decode the group again here.  */
+  close_debug_info_group (group);
+  return process_debug_info_units (section, abbrev_sec, group->start,
+				   group->limit, group->first_unit,
+				   false, false);
+}
+
+/* Display the NUM_UNITS units of SECTION, a .debug_info section, using
+   up to DWARF_JOBS child processes.  Each child decodes a group of
+   consecutive units into temporary files, which are copied to the
+   output in order as soon as all the groups before them are done, so
+   the output is the same as that of process_debug_info_units.  When
+   debug_information is being filled in, each child also writes the
+   records of its units to a temporary file, which the parent reads
+   back as it copies the output.  So the parent holds what a serial
+   run would, and the decoding state of at most DWARF_JOBS groups
+   exists at any one time, each in its own child.  */
+
+static int
+process_debug_info_parallel (struct dwarf_section *section,
+			     enum dwarf_section_display_enum abbrev_sec,
+			     unsigned int num_units)
+{
+  unsigned char *section_begin = section->start;
+  unsigned char *end = section_begin + section->size;
+  unsigned char *start;
+  struct debug_info_group *groups;
+  unsigned int num_groups, max_groups, started, unit, i;
+  size_t group_size;
+  int status = 1;
+
+  max_groups = dwarf_jobs * DEBUG_INFO_GROUPS_PER_JOB;
+  if (max_groups > num_units)
+    max_groups = num_units;
+  group_size = section->size / max_groups;
+  groups = xmalloc (max_groups * sizeof (*groups));
+
+  /* The unit lengths have already been checked by process_debug_info.  */
+  num_groups = 0;
+  for (start = section_begin, unit = 0; start < end; unit++)
+    {
+      dwarf_vma length;
+      unsigned char *hdrptr = start;
+
+      SAFE_BYTE_GET_AND_INC (length, hdrptr, 4, end);
+      if (length == 0xffffffff)
+	SAFE_BYTE_GET_AND_INC (length, hdrptr, 8, end);
+
+      if (num_groups == 0
+	  || (num_groups < max_groups
+	      && (size_t) (start - groups[num_groups - 1].start) >= group_size))
+	{
+	  groups[num_groups].start = start;
+	  groups[num_groups].first_unit = unit;
+	  groups[num_groups].num_units = 0;
+	  num_groups++;
+	}
+      start = hdrptr + length;
+      groups[num_groups - 1].limit = start;
+      groups[num_groups - 1].num_units++;
+    }
+  groups[num_groups - 1].limit = end;
+
+  /* Anything buffered now would be written again by every child.  */
+  fflush (stdout);
+  fflush (stderr);
+
+  started = 0;
+  for (i = 0; i < num_groups; i++)
+    {
+      while (started < num_groups && started < i + dwarf_jobs)
+	start_debug_info_group (section, abbrev_sec, &groups[started++]);
+
+      status = finish_debug_info_group (section, abbrev_sec, &groups[i]);
+      if (status < 0)
+	break;
+    }
+
+  /* After an error the remaining output is discarded, as
+     process_debug_info_units would stop at the bad unit.  */
+  for (i++; i < started; i++)
+    if (groups[i].pid > 0)
+      {
+	kill (groups[i].pid, SIGTERM);
+	waitpid (groups[i].pid, NULL, 0);
+	close_debug_info_group (&groups[i]);
+      }
+
+  free (groups);
+  return status;
 }
 
+#endif /* PARALLEL_DEBUG_INFO */
+
 /* Locate and scan the .debug_info section in the file and record the pointer
    sizes and offsets for the compilation units in it.  Usually an executable
    will have just one pointer size, but this is not guaranteed, and so we try
@@ -5358,6 +5776,13 @@ display_debug_lines_decoded (struct dwarf_section *  section,
 		      state_machine_regs.view = 0;
 		      break;
 		    case DW_LNE_define_file:
+		      if (strnlen ((char *) op_code_data,
+				   op_code_end - op_code_data)
+			  == (size_t) (op_code_end - op_code_data))
+			{
+			  warn (_("DW_LNE_define_file: Bad opcode length\n"));
+			  break;
+			}
 		      file_table = (File_Entry *) xrealloc
 			(file_table, (n_files + 1) * sizeof (File_Entry));
 
@@ -232,7 +232,8 @@ static enum
   compress_zlib = compress | 1 << 1,
   compress_gnu_zlib = compress | 1 << 2,
   compress_gabi_zlib = compress | 1 << 3,
-  decompress = 1 << 4
+  compress_zstd = compress | 1 << 4,
+  decompress = 1 << 5
 } do_debug_sections = nothing;
 
 /* Whether to generate ELF common symbols with the STT_COMMON type.  */
@@ -678,9 +679,9 @@ copy_usage (FILE *stream, int exit_status)
                                    <commit>\n\
      --subsystem <name>[:<version>]\n\
                                    Set PE subsystem to <name> [& <version>]\n\
-     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi}]\n\
-                                   Compress DWARF debug sections using zlib\n\
-     --decompress-debug-sections   Decompress DWARF debug sections using zlib\n\
+     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
+                                   Compress DWARF debug sections\n\
+     --decompress-debug-sections   Decompress DWARF debug sections\n\
      --elf-stt-common=[yes|no]     Generate ELF common symbols with STT_COMMON\n\
                                      type\n\
      --verilog-data-width <number> Specifies data width, in bytes, for verilog output\n\
@@ -2645,7 +2646,7 @@ copy_object (bfd *ibfd, bfd *obfd, const bfd_arch_info_type *input_arch)
       if ((do_debug_sections & compress) != 0
 	  && do_debug_sections != compress)
 	{
-	  non_fatal (_("--compress-debug-sections=[zlib|zlib-gnu|zlib-gabi] is unsupported on `%s'"),
+	  non_fatal (_("--compress-debug-sections=[zlib|zlib-gnu|zlib-gabi|zstd] is unsupported on `%s'"),
 		     bfd_get_archive_filename (ibfd));
 	  return false;
 	}
@@ -3791,11 +3792,14 @@ copy_file (const char *input_filename, const char *output_filename, int ofd,
     case compress_zlib:
     case compress_gnu_zlib:
     case compress_gabi_zlib:
+    case compress_zstd:
       ibfd->flags |= BFD_COMPRESS;
       /* Don't check if input is ELF here since this information is
 	 only available after bfd_check_format_matches is called.  */
       if (do_debug_sections != compress_gnu_zlib)
 	ibfd->flags |= BFD_COMPRESS_GABI;
+      if (do_debug_sections == compress_zstd)
+	ibfd->flags |= BFD_COMPRESS_ZSTD;
       break;
     case decompress:
       ibfd->flags |= BFD_DECOMPRESS;
@@ -4372,6 +4376,69 @@ copy_relocations_in_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
     }
 }
 
+/* Sections larger than this that are copied unchanged are passed
+   through a buffer of this size rather than read into memory whole,
+   so that objcopy's memory use does not grow with section size.  */
+#define PASS_THROUGH_SIZE (4 * 1024 * 1024)
+
+/* Return true if the contents of ISECTION of IBFD are written to
+   OBFD exactly as they are read.  */
+
+static bool
+section_contents_unchanged (bfd *ibfd, sec_ptr isection, bfd *obfd)
+{
+  if (reverse_bytes != 0 || copy_byte >= 0)
+    return false;
+
+  /* Sections being decompressed change size.  */
+  if (isection->compress_status != COMPRESS_SECTION_NONE)
+    return false;
+
+  /* bfd_convert_section_contents rewrites compression headers and
+     GNU properties when the ELF class changes.  */
+  if (bfd_get_flavour (ibfd) == bfd_target_elf_flavour
+      && bfd_get_flavour (obfd) == bfd_target_elf_flavour
+      && (get_elf_backend_data (ibfd)->s->elfclass
+	  != get_elf_backend_data (obfd)->s->elfclass))
+    return false;
+
+  return true;
+}
+
+/* Copy SIZE bytes of ISECTION of IBFD to OSECTION of OBFD a piece at
+   a time.  */
+
+static void
+pass_through_section (bfd *ibfd, sec_ptr isection,
+		      bfd *obfd, sec_ptr osection, bfd_size_type size)
+{
+  static bfd_byte *buf;
+  bfd_size_type off, count;
+
+  if (buf == NULL)
+    buf = xmalloc (PASS_THROUGH_SIZE);
+
+  for (off = 0; off < size; off += count)
+    {
+      count = size - off;
+      if (count > PASS_THROUGH_SIZE)
+	count = PASS_THROUGH_SIZE;
+
+      if (!bfd_get_section_contents (ibfd, isection, buf, off, count))
+	{
+	  status = 1;
+	  bfd_nonfatal_message (NULL, ibfd, isection, NULL);
+	  return;
+	}
+      if (!bfd_set_section_contents (obfd, osection, buf, off, count))
+	{
+	  status = 1;
+	  bfd_nonfatal_message (NULL, obfd, osection, NULL);
+	  return;
+	}
+    }
+}
+
 /* Copy the data of input section ISECTION of IBFD
    to an output section with the same name in OBFD.  */
 
@@ -4398,6 +4465,13 @@ copy_section (bfd *ibfd, sec_ptr isection, void *obfdarg)
     {
       bfd_byte *memhunk = NULL;
 
+      if (size > PASS_THROUGH_SIZE
+	  && section_contents_unchanged (ibfd, isection, obfd))
+	{
+	  pass_through_section (ibfd, isection, obfd, osection, size);
+	  return;
+	}
+
       if (!bfd_get_full_section_contents (ibfd, isection, &memhunk)
 	  || !bfd_convert_section_contents (ibfd, isection, obfd,
 					    &memhunk, &size))
@@ -5462,6 +5536,15 @@ copy_main (int argc, char *argv[])
 		do_debug_sections = compress_gnu_zlib;
 	      else if (strcasecmp (optarg, "zlib-gabi") == 0)
 		do_debug_sections = compress_gabi_zlib;
+	      else if (strcasecmp (optarg, "zstd") == 0)
+		{
+#ifdef HAVE_ZSTD
+		  do_debug_sections = compress_zstd;
+#else
+		  fatal (_("--compress-debug-sections=zstd: binutils is not "
+			   "built with zstd support"));
+#endif
+		}
 	      else
 		fatal (_("unrecognized --compress-debug-sections type `%s'"),
 		       optarg);
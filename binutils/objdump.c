@@ -132,6 +132,7 @@ static bool extended_color_output = false; /* --visualize-jumps=extended-color.
 static int process_links = false;       /* --process-links.  */
 static bool disassembler_color = false; /* --disassembler-color=color.  */
 static bool disassembler_extended_color = false; /* --disassembler-color=extended-color.  */
+static unsigned int disassemble_threads; /* --threads.  */
 
 static int dump_any_debugging;
 static int demangle_flags = DMGL_ANSI | DMGL_PARAMS;
@@ -158,6 +159,14 @@ static struct only * only_list = NULL;
 static const char **include_paths;
 static int include_path_count;
 
+/* Pseudo FILE object for strings.  */
+typedef struct
+{
+  char *buffer;
+  size_t pos;
+  size_t alloc;
+} SFILE;
+
 /* Extra info to pass to the section disassembler and address printing
    function.  */
 struct objdump_disasm_info
@@ -167,6 +176,11 @@ struct objdump_disasm_info
   disassembler_ftype disassemble_fn;
   arelent *reloc;
   const char *symbol;
+  /* The number of threads disassemble_section may use.  */
+  unsigned int threads;
+  /* Where the disassembly goes: stdout if NULL, otherwise the buffer
+     of a chunk of a section being disassembled in parallel.  */
+  SFILE *out;
 };
 
 /* Architecture to disassemble for, or default if NULL.  */
@@ -377,6 +391,8 @@ usage (FILE *stream, int status)
       fprintf (stream, _("\
       --insn-width=WIDTH         Display WIDTH bytes on a single line for -d\n"));
       fprintf (stream, _("\
+      --threads[=N]              Use up to N threads for -d and -Wi\n"));
+      fprintf (stream, _("\
       --adjust-vma=OFFSET        Add OFFSET to all displayed section addresses\n"));
       fprintf (stream, _("\
       --special-syms             Include special symbols in symbol dumps\n"));
@@ -451,7 +467,8 @@ enum option_values
     OPTION_CTF_PARENT,
 #endif
     OPTION_VISUALIZE_JUMPS,
-    OPTION_DISASSEMBLER_COLOR
+    OPTION_DISASSEMBLER_COLOR,
+    OPTION_THREADS
   };
 
 static struct option long_options[]=
@@ -513,6 +530,7 @@ static struct option long_options[]=
   {"stop-address", required_argument, NULL, OPTION_STOP_ADDRESS},
   {"syms", no_argument, NULL, 't'},
   {"target", required_argument, NULL, 'b'},
+  {"threads", optional_argument, NULL, OPTION_THREADS},
   {"unicode", required_argument, NULL, 'U'},
   {"version", no_argument, NULL, 'V'},
   {"visualize-jumps", optional_argument, 0, OPTION_VISUALIZE_JUMPS},
@@ -637,6 +655,27 @@ display_utf8 (const unsigned char * in, char * out, unsigned int * consumed)
   return 1;
 }
 
+/* Returns TRUE if sanitize_string would need to translate IN.  */
+
+static bool
+string_needs_sanitizing (const char * in)
+{
+  do
+    {
+      unsigned char c = *in++;
+
+      if (c == 0)
+	return false;
+
+      if (ISCNTRL (c))
+	return true;
+
+      if (unicode_display != unicode_default && c >= 0xc0)
+	return true;
+    }
+  while (1);
+}
+
 /* Returns a version of IN with any control characters
    replaced by escape sequences.  Uses a static buffer
    if necessary.
@@ -649,7 +688,6 @@ sanitize_string (const char * in)
 {
   static char *  buffer = NULL;
   static size_t  buffer_len = 0;
-  const char *   original = in;
   char *         out;
 
   /* Paranoia.  */
@@ -658,23 +696,10 @@ sanitize_string (const char * in)
 
   /* See if any conversion is necessary.  In the majority
      of cases it will not be needed.  */
-  do
-    {
-      unsigned char c = *in++;
-
-      if (c == 0)
-	return original;
-
-      if (ISCNTRL (c))
-	break;
-
-      if (unicode_display != unicode_default && c >= 0xc0)
-	break;
-    }
-  while (1);
+  if (!string_needs_sanitizing (in))
+    return in;
 
   /* Copy the input, translating as needed.  */
-  in = original;
   if (buffer_len < (strlen (in) * 9))
     {
       free ((void *) buffer);
@@ -2112,29 +2137,21 @@ show_line (bfd *abfd, asection *section, bfd_vma addr_offset)
     free (path);
 }
 
-/* Pseudo FILE object for strings.  */
-typedef struct
-{
-  char *buffer;
-  size_t pos;
-  size_t alloc;
-} SFILE;
+/* vsprintf to a "stream".  */
 
-/* sprintf to a "stream".  */
-
-static int ATTRIBUTE_PRINTF_2
-objdump_sprintf (SFILE *f, const char *format, ...)
+static int
+objdump_vsprintf (SFILE *f, const char *format, va_list args)
 {
   size_t n;
-  va_list args;
+  va_list ap;
 
   while (1)
     {
       size_t space = f->alloc - f->pos;
 
-      va_start (args, format);
-      n = vsnprintf (f->buffer + f->pos, space, format, args);
-      va_end (args);
+      va_copy (ap, args);
+      n = vsnprintf (f->buffer + f->pos, space, format, ap);
+      va_end (ap);
 
       if (space > n)
 	break;
@@ -2147,6 +2164,40 @@ objdump_sprintf (SFILE *f, const char *format, ...)
   return n;
 }
 
+/* sprintf to a "stream".  */
+
+static int ATTRIBUTE_PRINTF_2
+objdump_sprintf (SFILE *f, const char *format, ...)
+{
+  int n;
+  va_list args;
+
+  va_start (args, format);
+  n = objdump_vsprintf (f, format, args);
+  va_end (args);
+
+  return n;
+}
+
+/* Like objdump_sprintf, but discarding the styling information, as
+   fprintf_styled does.  This stands in for fprintf_styled when the
+   output that would go to stdout is collected in a buffer.  */
+
+static int ATTRIBUTE_PRINTF_3
+objdump_unstyled_sprintf (SFILE *f,
+			  enum disassembler_style style ATTRIBUTE_UNUSED,
+			  const char *format, ...)
+{
+  int n;
+  va_list args;
+
+  va_start (args, format);
+  n = objdump_vsprintf (f, format, args);
+  va_end (args);
+
+  return n;
+}
+
 /* Return an integer greater than, or equal to zero, representing the color
    for STYLE, or -1 if no color should be used.  */
 
@@ -2155,6 +2206,11 @@ objdump_color_for_disassembler_style (enum disassembler_style style)
 {
   int color = -1;
 
+  /* Without colors there is nothing to track, and disassemble_section
+     may then be running in several threads.  */
+  if (!disassembler_color && !disassembler_extended_color)
+    return color;
+
   if (style == dis_style_comment_start)
     disassembler_in_comment = true;
 
@@ -2284,6 +2340,59 @@ fprintf_styled (FILE *f, enum disassembler_style style ATTRIBUTE_UNUSED,
   return res;
 }
 
+/* Print to the output of the disassembly described by AUX.  */
+
+static int ATTRIBUTE_PRINTF_2
+disasm_printf (struct objdump_disasm_info *aux, const char *format, ...)
+{
+  int n;
+  va_list args;
+
+  va_start (args, format);
+  if (aux->out == NULL)
+    n = vprintf (format, args);
+  else
+    n = objdump_vsprintf (aux->out, format, args);
+  va_end (args);
+
+  return n;
+}
+
+static void
+disasm_putchar (struct objdump_disasm_info *aux, int c)
+{
+  SFILE *f = aux->out;
+
+  if (f == NULL)
+    putchar (c);
+  else
+    {
+      if (f->pos + 1 >= f->alloc)
+	{
+	  f->alloc = f->alloc * 2 + 64;
+	  f->buffer = (char *) xrealloc (f->buffer, f->alloc);
+	}
+      f->buffer[f->pos++] = c;
+    }
+}
+
+/* Point the printing functions of INF back at the output of the
+   disassembly.  */
+
+static void
+disasm_set_output (struct disassemble_info *inf)
+{
+  struct objdump_disasm_info *aux
+    = (struct objdump_disasm_info *) inf->application_data;
+
+  if (aux->out == NULL)
+    disassemble_set_printf (inf, stdout, (fprintf_ftype) fprintf,
+			    (fprintf_styled_ftype) fprintf_styled);
+  else
+    disassemble_set_printf (inf, aux->out, (fprintf_ftype) objdump_sprintf,
+			    (fprintf_styled_ftype) objdump_unstyled_sprintf);
+}
+
 /* Code for generating (colored) diagrams of control flow start and end
    points.  */
 
@@ -3067,13 +3176,13 @@ disassemble_bytes (struct disassemble_info *inf,
 	     and the file offset from where we resume dumping.  */
 	  if (display_file_offsets
 	      && addr_offset + octets / opb < stop_offset)
-	    printf (_("\t... (skipping %lu zeroes, "
-		      "resuming at file offset: 0x%lx)\n"),
-		    (unsigned long) (octets / opb),
-		    (unsigned long) (section->filepos
-				     + addr_offset + octets / opb));
+	    disasm_printf (aux, _("\t... (skipping %lu zeroes, "
+				  "resuming at file offset: 0x%lx)\n"),
+			   (unsigned long) (octets / opb),
+			   (unsigned long) (section->filepos
+					    + addr_offset + octets / opb));
 	  else
-	    printf ("\t...\n");
+	    disasm_printf (aux, "\t...\n");
 	}
       else
 	{
@@ -3085,7 +3194,7 @@ disassemble_bytes (struct disassemble_info *inf,
 	    show_line (aux->abfd, section, addr_offset);
 
 	  if (no_addresses)
-	    printf ("\t");
+	    disasm_printf (aux, "\t");
 	  else if (!prefix_addresses)
 	    {
 	      char *s;
@@ -3095,14 +3204,14 @@ disassemble_bytes (struct disassemble_info *inf,
 		*s = ' ';
 	      if (*s == '\0')
 		*--s = '0';
-	      printf ("%s:\t", buf + skip_addr_chars);
+	      disasm_printf (aux, "%s:\t", buf + skip_addr_chars);
 	    }
 	  else
 	    {
 	      aux->require_sec = true;
 	      objdump_print_address (section->vma + addr_offset, inf);
 	      aux->require_sec = false;
-	      putchar (' ');
+	      disasm_putchar (aux, ' ');
 	    }
 
 	  print_jump_visualisation (section->vma + addr_offset,
@@ -3191,19 +3300,19 @@ disassemble_bytes (struct disassemble_info *inf,
 		inf->stop_vma = section->vma + stop_offset;
 
 	      inf->stop_offset = stop_offset;
-	      disassembler_in_comment = false;
+	      if (disassembler_color || disassembler_extended_color)
+		disassembler_in_comment = false;
 	      insn_size = (*disassemble_fn) (section->vma + addr_offset, inf);
 	      octets = insn_size;
 
 	      inf->stop_vma = 0;
-	      disassemble_set_printf (inf, stdout, (fprintf_ftype) fprintf,
-				      (fprintf_styled_ftype) fprintf_styled);
+	      disasm_set_output (inf);
 	      if (insn_width == 0 && inf->bytes_per_line != 0)
 		octets_per_line = inf->bytes_per_line;
 	      if (insn_size < (int) opb)
 		{
 		  if (sfile.pos)
-		    printf ("%s\n", sfile.buffer);
+		    disasm_printf (aux, "%s\n", sfile.buffer);
 		  if (insn_size >= 0)
 		    {
 		      non_fatal (_("disassemble_fn returned length %d"),
@@ -3258,15 +3367,17 @@ disassemble_bytes (struct disassemble_info *inf,
 		      if (inf->display_endian == BFD_ENDIAN_LITTLE)
 			{
 			  for (k = bpc; k-- != 0; )
-			    printf ("%02x", (unsigned) data[j + k]);
+			    disasm_printf (aux, "%02x",
+					   (unsigned) data[j + k]);
 			}
 		      else
 			{
 			  for (k = 0; k < bpc; k++)
-			    printf ("%02x", (unsigned) data[j + k]);
+			    disasm_printf (aux, "%02x",
+					   (unsigned) data[j + k]);
 			}
 		    }
-		  putchar (' ');
+		  disasm_putchar (aux, ' ');
 		}
 
 	      for (; pb < octets_per_line; pb += bpc)
@@ -3274,21 +3385,21 @@ disassemble_bytes (struct disassemble_info *inf,
 		  unsigned int k;
 
 		  for (k = 0; k < bpc; k++)
-		    printf ("  ");
-		  putchar (' ');
+		    disasm_printf (aux, "  ");
+		  disasm_putchar (aux, ' ');
 		}
 
 	      /* Separate raw data from instruction by extra space.  */
 	      if (insns)
-		putchar ('\t');
+		disasm_putchar (aux, '\t');
 	      else
-		printf ("    ");
+		disasm_printf (aux, "    ");
 	    }
 
 	  if (! insns)
-	    printf ("%s", buf);
+	    disasm_printf (aux, "%s", buf);
 	  else if (sfile.pos)
-	    printf ("%s", sfile.buffer);
+	    disasm_printf (aux, "%s", sfile.buffer);
 
 	  if (prefix_addresses
 	      ? show_raw_insn > 0
@@ -3299,11 +3410,11 @@ disassemble_bytes (struct disassemble_info *inf,
 		  bfd_vma j;
 		  char *s;
 
-		  putchar ('\n');
+		  disasm_putchar (aux, '\n');
 		  j = addr_offset * opb + pb;
 
 		  if (no_addresses)
-		    printf ("\t");
+		    disasm_printf (aux, "\t");
 		  else
 		    {
 		      bfd_sprintf_vma (aux->abfd, buf, section->vma + j / opb);
@@ -3311,7 +3422,7 @@ disassemble_bytes (struct disassemble_info *inf,
 			*s = ' ';
 		      if (*s == '\0')
 			*--s = '0';
-		      printf ("%s:\t", buf + skip_addr_chars);
+		      disasm_printf (aux, "%s:\t", buf + skip_addr_chars);
 		    }
 
 		  print_jump_visualisation (section->vma + j / opb,
@@ -3331,21 +3442,23 @@ disassemble_bytes (struct disassemble_info *inf,
 			  if (inf->display_endian == BFD_ENDIAN_LITTLE)
 			    {
 			      for (k = bpc; k-- != 0; )
-				printf ("%02x", (unsigned) data[j + k]);
+				disasm_printf (aux, "%02x",
+					       (unsigned) data[j + k]);
 			    }
 			  else
 			    {
 			      for (k = 0; k < bpc; k++)
-				printf ("%02x", (unsigned) data[j + k]);
+				disasm_printf (aux, "%02x",
+					       (unsigned) data[j + k]);
 			    }
 			}
-		      putchar (' ');
+		      disasm_putchar (aux, ' ');
 		    }
 		}
 	    }
 
 	  if (!wide_output)
-	    putchar ('\n');
+	    disasm_putchar (aux, '\n');
 	  else
 	    need_nl = true;
 	}
@@ -3360,26 +3473,26 @@ disassemble_bytes (struct disassemble_info *inf,
 	      q = **relppp;
 
 	      if (wide_output)
-		putchar ('\t');
+		disasm_putchar (aux, '\t');
 	      else
-		printf ("\t\t\t");
+		disasm_printf (aux, "\t\t\t");
 
 	      if (!no_addresses)
 		{
 		  objdump_print_value (section->vma - rel_offset + q->address,
 				       inf, true);
-		  printf (": ");
+		  disasm_printf (aux, ": ");
 		}
 
 	      if (q->howto == NULL)
-		printf ("*unknown*\t");
+		disasm_printf (aux, "*unknown*\t");
 	      else if (q->howto->name)
-		printf ("%s\t", q->howto->name);
+		disasm_printf (aux, "%s\t", q->howto->name);
 	      else
-		printf ("%d\t", q->howto->type);
+		disasm_printf (aux, "%d\t", q->howto->type);
 
 	      if (q->sym_ptr_ptr == NULL || *q->sym_ptr_ptr == NULL)
-		printf ("*unknown*");
+		disasm_printf (aux, "*unknown*");
 	      else
 		{
 		  const char *sym_name;
@@ -3395,7 +3508,7 @@ disassemble_bytes (struct disassemble_info *inf,
 		      sym_name = bfd_section_name (sym_sec);
 		      if (sym_name == NULL || *sym_name == '\0')
 			sym_name = "*unknown*";
-		      printf ("%s", sanitize_string (sym_name));
+		      disasm_printf (aux, "%s", sanitize_string (sym_name));
 		    }
 		}
 
@@ -3404,22 +3517,22 @@ disassemble_bytes (struct disassemble_info *inf,
 		  bfd_vma addend = q->addend;
 		  if ((bfd_signed_vma) addend < 0)
 		    {
-		      printf ("-0x");
+		      disasm_printf (aux, "-0x");
 		      addend = -addend;
 		    }
 		  else
-		    printf ("+0x");
+		    disasm_printf (aux, "+0x");
 		  objdump_print_value (addend, inf, true);
 		}
 
-	      printf ("\n");
+	      disasm_printf (aux, "\n");
 	      need_nl = false;
 	    }
 	  ++(*relppp);
 	}
 
       if (need_nl)
-	printf ("\n");
+	disasm_printf (aux, "\n");
 
       addr_offset += octets / opb;
     }
@@ -3429,6 +3542,223 @@ disassemble_bytes (struct disassemble_info *inf,
   free (color_buffer);
 }
 
+/* A run of bytes of a section between two symbols, disassembled by
+   one call of disassemble_bytes.  */
+
+struct disasm_block
+{
+  bfd_vma start_offset;
+  bfd_vma stop_offset;
+  /* The address of START_OFFSET, for the symbol header.  */
+  bfd_vma addr;
+  asymbol *sym;
+  asymbol **symbols;
+  int num_symbols;
+  int symtab_pos;
+  bool insns;
+};
+
+/* Print the symbol header of BLK and disassemble it.  */
+
+static void
+disassemble_block (struct disassemble_info *pinfo, bfd_byte *data,
+		   const struct disasm_block *blk, bfd_vma rel_offset,
+		   arelent ***rel_ppp, arelent **rel_ppend)
+{
+  struct objdump_disasm_info *paux
+    = (struct objdump_disasm_info *) pinfo->application_data;
+  asymbol *sym = blk->sym;
+
+  pinfo->symbols = blk->symbols;
+  pinfo->num_symbols = blk->num_symbols;
+  pinfo->symtab_pos = blk->symtab_pos;
+
+  if (! prefix_addresses)
+    {
+      pinfo->fprintf_func (pinfo->stream, "\n");
+      objdump_print_addr_with_sym (paux->abfd, pinfo->section, sym,
+				   blk->addr, pinfo, false);
+      pinfo->fprintf_func (pinfo->stream, ":\n");
+    }
+
+  /* Resolve symbol name.  */
+  if (visualize_jumps && sym && sym->name)
+    {
+      struct disassemble_info di;
+      SFILE sf;
+
+      sf.alloc = strlen (sym->name) + 40;
+      sf.buffer = (char*) xmalloc (sf.alloc);
+      sf.pos = 0;
+      disassemble_set_printf
+	(&di, &sf, (fprintf_ftype) objdump_sprintf,
+	 (fprintf_styled_ftype) objdump_styled_sprintf);
+
+      objdump_print_symname (paux->abfd, &di, sym);
+
+      /* Fetch jump information.  */
+      detected_jumps = disassemble_jumps
+	(pinfo, paux->disassemble_fn,
+	 blk->start_offset, blk->stop_offset,
+	 rel_offset, rel_ppp, rel_ppend);
+
+      /* Free symbol name.  */
+      free (sf.buffer);
+    }
+
+  /* Add jumps to output.  */
+  disassemble_bytes (pinfo, paux->disassemble_fn, blk->insns, data,
+		     blk->start_offset, blk->stop_offset,
+		     rel_offset, rel_ppp, rel_ppend);
+
+  /* Free jumps.  */
+  while (detected_jumps)
+    {
+      detected_jumps = jump_info_free (detected_jumps);
+    }
+}
+
+/* When disassembling a section in parallel, its blocks are gathered
+   into chunks of about this many bytes, each chunk being disassembled
+   by one thread into its own buffer.  */
+#define DISASM_CHUNK_SIZE 0x4000
+
+/* The number of chunks per thread disassembled before their output is
+   written out, which bounds the memory used for the buffers.  */
+#define DISASM_CHUNKS_PER_THREAD 8
+
+struct disasm_chunk
+{
+  size_t first_block;
+  size_t end_block;
+  /* The relocs at the start and end of the chunk.  */
+  arelent **rel_start;
+  arelent **rel_end;
+  SFILE out;
+};
+
+/* The blocks of a section waiting to be disassembled in parallel.  */
+
+struct disasm_parallel
+{
+  struct disassemble_info *pinfo;
+  bfd_byte *data;
+  bfd_vma rel_offset;
+  arelent **rel_ppend;
+  struct disasm_block *blocks;
+  size_t nblocks;
+  size_t blocks_alloc;
+  bfd_size_type bytes;
+  struct disasm_chunk *chunks;
+  size_t chunks_alloc;
+};
+
+/* Disassemble CHUNK of PAR into its buffer, with private copies of the
+   disassemble_info and objdump_disasm_info.  */
+
+static void
+disassemble_chunk (struct disasm_parallel *par, struct disasm_chunk *chunk)
+{
+  struct disassemble_info inf = *par->pinfo;
+  struct objdump_disasm_info aux
+    = *(struct objdump_disasm_info *) inf.application_data;
+  arelent **rel_pp = chunk->rel_start;
+  size_t i;
+
+  inf.application_data = &aux;
+  chunk->out.pos = 0;
+  aux.out = &chunk->out;
+  disasm_set_output (&inf);
+
+  for (i = chunk->first_block; i < chunk->end_block; i++)
+    disassemble_block (&inf, par->data, &par->blocks[i], par->rel_offset,
+		       &rel_pp, par->rel_ppend);
+  chunk->rel_end = rel_pp;
+}
+
+static void
+disassemble_chunk_job (void *data, size_t i)
+{
+  struct disasm_parallel *par = (struct disasm_parallel *) data;
+
+  disassemble_chunk (par, &par->chunks[i]);
+}
+
+/* Disassemble the blocks gathered in PAR using THREADS threads, and
+   write out the result just as disassemble_block would have done one
+   block after another.  *REL_PPP is the first reloc not yet printed,
+   and is updated.  */
+
+static void
+disassemble_blocks_parallel (struct disasm_parallel *par,
+			     unsigned int threads, arelent ***rel_ppp)
+{
+  size_t nchunks, i, j;
+  bfd_size_type size;
+  arelent **rel_pp;
+
+  if (par->nblocks == 0)
+    return;
+
+  /* Chunks end at block boundaries, so each starts with a symbol.  */
+  nchunks = 0;
+  for (i = 0; i < par->nblocks; i = j)
+    {
+      struct disasm_chunk *chunk;
+
+      size = 0;
+      for (j = i; j < par->nblocks && size < DISASM_CHUNK_SIZE; j++)
+	size += par->blocks[j].stop_offset - par->blocks[j].start_offset;
+
+      if (nchunks == par->chunks_alloc)
+	{
+	  par->chunks_alloc = par->chunks_alloc * 2 + 16;
+	  par->chunks = (struct disasm_chunk *)
+	    xrealloc (par->chunks, par->chunks_alloc * sizeof (*chunk));
+	  memset (par->chunks + nchunks, 0,
+		  (par->chunks_alloc - nchunks) * sizeof (*chunk));
+	}
+      chunk = &par->chunks[nchunks++];
+      chunk->first_block = i;
+      chunk->end_block = j;
+    }
+
+  /* Guess the relocs at the start of each chunk: those before it have
+     been printed by the chunks before.  */
+  rel_pp = *rel_ppp;
+  for (i = 0; i < nchunks; i++)
+    {
+      bfd_vma start = par->blocks[par->chunks[i].first_block].start_offset;
+
+      while (rel_pp < par->rel_ppend
+	     && (*rel_pp)->address < par->rel_offset + start)
+	++rel_pp;
+      par->chunks[i].rel_start = i == 0 ? *rel_ppp : rel_pp;
+    }
+
+  bu_parallel_for (threads, disassemble_chunk_job, par, nchunks);
+
+  for (i = 0; i < nchunks; i++)
+    {
+      struct disasm_chunk *chunk = &par->chunks[i];
+
+      /* An instruction running past the end of a chunk, or a
+	 disassembler error, may leave the relocs elsewhere than
+	 guessed.  Redo the chunk so the output is what it would have
+	 been without threads.  */
+      if (i != 0 && chunk->rel_start != par->chunks[i - 1].rel_end)
+	{
+	  chunk->rel_start = par->chunks[i - 1].rel_end;
+	  disassemble_chunk (par, chunk);
+	}
+      fwrite (chunk->out.buffer, 1, chunk->out.pos, stdout);
+    }
+
+  *rel_ppp = par->chunks[nchunks - 1].rel_end;
+  par->nblocks = 0;
+  par->bytes = 0;
+}
+
 static void
 disassemble_section (bfd *abfd, asection *section, void *inf)
 {
@@ -3449,6 +3779,8 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   bfd_vma rel_offset;
   unsigned long addr_offset;
   bool do_print;
+  struct disasm_parallel par;
+  bool parallel;
   enum loop_control
   {
    stop_offset_reached,
@@ -3532,7 +3864,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
     }
   rel_ppend = PTR_ADD (rel_pp, rel_count);
 
-  if (!bfd_malloc_and_get_section (abfd, section, &data))
+  if (!bfd_map_section_contents (abfd, section, &data))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
@@ -3579,6 +3911,15 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   do_print = paux->symbol == NULL;
   loop_until = stop_offset_reached;
 
+  /* When disassembling in parallel the blocks are gathered, and
+     disassembled by disassemble_blocks_parallel.  */
+  parallel = paux->threads > 1;
+  memset (&par, 0, sizeof (par));
+  par.pinfo = pinfo;
+  par.data = data;
+  par.rel_offset = rel_offset;
+  par.rel_ppend = rel_ppend;
+
   while (addr_offset < stop_offset)
     {
       bfd_vma addr;
@@ -3686,14 +4027,6 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 	    }
 	}
 
-      if (! prefix_addresses && do_print)
-	{
-	  pinfo->fprintf_func (pinfo->stream, "\n");
-	  objdump_print_addr_with_sym (abfd, section, sym, addr,
-				       pinfo, false);
-	  pinfo->fprintf_func (pinfo->stream, ":\n");
-	}
-
       if (sym != NULL && bfd_asymbol_value (sym) > addr)
 	nextsym = sym;
       else if (sym == NULL)
@@ -3749,40 +4082,40 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
 
       if (do_print)
 	{
-	  /* Resolve symbol name.  */
-	  if (visualize_jumps && abfd && sym && sym->name)
-	    {
-	      struct disassemble_info di;
-	      SFILE sf;
-
-	      sf.alloc = strlen (sym->name) + 40;
-	      sf.buffer = (char*) xmalloc (sf.alloc);
-	      sf.pos = 0;
-	      disassemble_set_printf
-		(&di, &sf, (fprintf_ftype) objdump_sprintf,
-		 (fprintf_styled_ftype) objdump_styled_sprintf);
+	  struct disasm_block *blk, block;
 
-	      objdump_print_symname (abfd, &di, sym);
-
-	      /* Fetch jump information.  */
-	      detected_jumps = disassemble_jumps
-		(pinfo, paux->disassemble_fn,
-		 addr_offset, nextstop_offset,
-		 rel_offset, &rel_pp, rel_ppend);
-
-	      /* Free symbol name.  */
-	      free (sf.buffer);
+	  if (parallel)
+	    {
+	      if (par.nblocks == par.blocks_alloc)
+		{
+		  par.blocks_alloc = par.blocks_alloc * 2 + 64;
+		  par.blocks = (struct disasm_block *)
+		    xrealloc (par.blocks, par.blocks_alloc * sizeof (*blk));
+		}
+	      blk = &par.blocks[par.nblocks++];
 	    }
-
-	  /* Add jumps to output.  */
-	  disassemble_bytes (pinfo, paux->disassemble_fn, insns, data,
-			     addr_offset, nextstop_offset,
-			     rel_offset, &rel_pp, rel_ppend);
-
-	  /* Free jumps.  */
-	  while (detected_jumps)
+	  else
+	    blk = &block;
+
+	  blk->start_offset = addr_offset;
+	  blk->stop_offset = nextstop_offset;
+	  blk->addr = addr;
+	  blk->sym = sym;
+	  blk->symbols = pinfo->symbols;
+	  blk->num_symbols = pinfo->num_symbols;
+	  blk->symtab_pos = pinfo->symtab_pos;
+	  blk->insns = insns;
+
+	  if (!parallel)
+	    disassemble_block (pinfo, data, blk, rel_offset,
+			       &rel_pp, rel_ppend);
+	  else
 	    {
-	      detected_jumps = jump_info_free (detected_jumps);
+	      par.bytes += nextstop_offset - addr_offset;
+	      if (par.bytes >= ((bfd_size_type) paux->threads
+				* DISASM_CHUNKS_PER_THREAD
+				* DISASM_CHUNK_SIZE))
+		disassemble_blocks_parallel (&par, paux->threads, &rel_pp);
 	    }
 	}
 
@@ -3790,12 +4123,68 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       sym = nextsym;
     }
 
-  free (data);
+  if (parallel)
+    {
+      size_t i;
+
+      disassemble_blocks_parallel (&par, paux->threads, &rel_pp);
+      for (i = 0; i < par.chunks_alloc; i++)
+	free (par.chunks[i].out.buffer);
+      free (par.chunks);
+      free (par.blocks);
+    }
+
+  bfd_unmap_section_contents (abfd, section, data);
 
   if (rel_ppstart != NULL)
     free (rel_ppstart);
 }
 
+/* Return TRUE if the sections of ABFD can be disassembled by several
+   threads at once.  The disassembler must keep all its state in the
+   disassemble_info it is passed, and objdump must not need any of the
+   state it keeps between instructions for -l, -S, --disassemble=SYM,
+   --visualize-jumps or --disassembler-color.  Names are not sanitized
+   either, as sanitize_string uses a static buffer.  */
+
+static bool
+disassemble_in_parallel_p (bfd *abfd)
+{
+  asection *sec;
+  long i;
+
+  if (with_line_numbers
+      || with_source_code
+      || disasm_sym != NULL
+      || visualize_jumps
+      || disassembler_color
+      || disassembler_extended_color)
+    return false;
+
+  switch (bfd_get_arch (abfd))
+    {
+    case bfd_arch_i386:
+      break;
+    default:
+      return false;
+    }
+
+  for (sec = abfd->sections; sec != NULL; sec = sec->next)
+    if (string_needs_sanitizing (sec->name))
+      return false;
+  for (i = 0; i < symcount; i++)
+    if (string_needs_sanitizing (bfd_asymbol_name (syms[i])))
+      return false;
+  for (i = 0; i < dynsymcount; i++)
+    if (string_needs_sanitizing (bfd_asymbol_name (dynsyms[i])))
+      return false;
+  for (i = 0; i < synthcount; i++)
+    if (string_needs_sanitizing (bfd_asymbol_name (&synthsyms[i])))
+      return false;
+
+  return true;
+}
+
 /* Disassemble the contents of an object file.  */
 
 static void
@@ -3838,6 +4227,8 @@ disassemble_data (bfd *abfd)
   disasm_info.dynrelcount = 0;
   aux.reloc = NULL;
   aux.symbol = disasm_sym;
+  aux.threads = 1;
+  aux.out = NULL;
 
   disasm_info.print_address_func = objdump_print_address;
   disasm_info.symbol_at_address_func = objdump_symbol_at_address;
@@ -3919,6 +4310,9 @@ disassemble_data (bfd *abfd)
   disasm_info.symtab = sorted_syms;
   disasm_info.symtab_size = sorted_symcount;
 
+  if (disassemble_threads > 1 && disassemble_in_parallel_p (abfd))
+    aux.threads = disassemble_threads;
+
   bfd_map_over_sections (abfd, disassemble_section, & disasm_info);
 
   free (disasm_info.dynrelbuf);
@@ -4710,7 +5104,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	    (unsigned long) (section->filepos + start_offset));
   printf ("\n");
 
-  if (!bfd_get_full_section_contents (abfd, section, &data))
+  if (!bfd_map_section_contents (abfd, section, &data))
     {
       non_fatal (_("Reading section %s failed because: %s"),
 		 section->name, bfd_errmsg (bfd_get_error ()));
@@ -4782,7 +5176,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	}
       putchar ('\n');
     }
-  free (data);
+  bfd_unmap_section_contents (abfd, section, data);
 }
 
 /* Actually display the various requested regions.  */
@@ -5689,6 +6083,10 @@ main (int argc, char **argv)
 	  else
 	    nonfatal (_("unrecognized argument to --disassembler-color"));
 	  break;
+	case OPTION_THREADS:
+	  disassemble_threads = parse_thread_count (optarg, "--threads");
+	  dwarf_jobs = disassemble_threads;
+	  break;
 	case 'E':
 	  if (strcmp (optarg, "B") == 0)
 	    endian = BFD_ENDIAN_BIG;
@@ -44,7 +44,13 @@
 #include <assert.h>
 #include <time.h>
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include <wchar.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #if defined HAVE_MSGPACK
 #include <msgpack.h>
@@ -273,6 +279,8 @@ typedef struct filedata
   Elf_Internal_Ehdr    file_header;
   unsigned long        archive_file_offset;
   unsigned long        archive_file_size;
+  /* A private, copy-on-write mapping of the whole file, or NULL.  */
+  unsigned char *      map;
   /* Everything below this point is cleared out by free_filedata.  */
   Elf_Internal_Shdr *  section_headers;
   Elf_Internal_Phdr *  program_headers;
@@ -552,6 +560,90 @@ get_data (void *         var,
   return mvar;
 }
 
+/* Map the whole of FILEDATA's file into memory, if possible.  */
+
+static void
+map_file (Filedata * filedata ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_MMAP
+  void * addr;
+
+  filedata->map = NULL;
+  if (filedata->file_size == 0
+      || (size_t) filedata->file_size != filedata->file_size)
+    return;
+
+  /* The mapping is writable so that relocations can be applied to
+     the contents of debug sections in place.  Being private, such
+     changes only copy the pages concerned and never reach the file.  */
+  addr = mmap (NULL, filedata->file_size, PROT_READ | PROT_WRITE,
+	       MAP_PRIVATE, fileno (filedata->handle), 0);
+  if (addr != MAP_FAILED)
+    filedata->map = (unsigned char *) addr;
+#endif
+}
+
+/* Undo map_file.  */
+
+static void
+unmap_file (Filedata * filedata ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_MMAP
+  if (filedata->map != NULL)
+    munmap (filedata->map, filedata->file_size);
+  filedata->map = NULL;
+#endif
+}
+
+/* Like get_data with a NULL VAR, but return a pointer into the mapping
+   of FILEDATA's file rather than a copy if the file is mapped.  The
+   data may be modified, but unlike that returned by get_data there is
+   no terminating NUL after it, and it must be released with
+   release_data rather than free.  */
+
+static void *
+get_mapped_data (Filedata *    filedata,
+		 unsigned long offset,
+		 bfd_size_type size,
+		 bfd_size_type nmemb,
+		 const char *  reason)
+{
+  bfd_size_type amt = size * nmemb;
+
+  /* Leave any error reporting to get_data.  */
+  if (filedata->map == NULL
+      || size == 0
+      || nmemb == 0
+      || amt / size != nmemb
+      || filedata->archive_file_offset > filedata->file_size
+      || offset > filedata->file_size - filedata->archive_file_offset
+      || amt > filedata->file_size - filedata->archive_file_offset - offset)
+    return get_data (NULL, filedata, offset, size, nmemb, reason);
+
+  return filedata->map + filedata->archive_file_offset + offset;
+}
+
+/* Return true if DATA points into the mapping of FILEDATA's file.  */
+
+static bool
+is_mapped_data (Filedata * filedata, const void * data)
+{
+  const unsigned char * p = (const unsigned char *) data;
+
+  return (filedata->map != NULL
+	  && p >= filedata->map
+	  && p < filedata->map + filedata->file_size);
+}
+
+/* Release DATA returned by get_mapped_data.  */
+
+static void
+release_data (Filedata * filedata, void * data)
+{
+  if (!is_mapped_data (filedata, data))
+    free (data);
+}
+
 /* Print a VMA value in the MODE specified.
    Returns the number of characters displayed.  */
 
@@ -1181,8 +1273,8 @@ slurp_rela_relocs (Filedata *            filedata,
     {
       Elf32_External_Rela * erelas;
 
-      erelas = (Elf32_External_Rela *) get_data (NULL, filedata, rel_offset, 1,
-                                                 rel_size, _("32-bit relocation data"));
+      erelas = (Elf32_External_Rela *) get_mapped_data (filedata, rel_offset, 1,
+							rel_size, _("32-bit relocation data"));
       if (!erelas)
 	return false;
 
@@ -1193,7 +1285,7 @@ slurp_rela_relocs (Filedata *            filedata,
 
       if (relas == NULL)
 	{
-	  free (erelas);
+	  release_data (filedata, erelas);
 	  error (_("out of memory parsing relocs\n"));
 	  return false;
 	}
@@ -1205,14 +1297,14 @@ slurp_rela_relocs (Filedata *            filedata,
 	  relas[i].r_addend = BYTE_GET_SIGNED (erelas[i].r_addend);
 	}
 
-      free (erelas);
+      release_data (filedata, erelas);
     }
   else
     {
       Elf64_External_Rela * erelas;
 
-      erelas = (Elf64_External_Rela *) get_data (NULL, filedata, rel_offset, 1,
-                                                 rel_size, _("64-bit relocation data"));
+      erelas = (Elf64_External_Rela *) get_mapped_data (filedata, rel_offset, 1,
+							rel_size, _("64-bit relocation data"));
       if (!erelas)
 	return false;
 
@@ -1223,7 +1315,7 @@ slurp_rela_relocs (Filedata *            filedata,
 
       if (relas == NULL)
 	{
-	  free (erelas);
+	  release_data (filedata, erelas);
 	  error (_("out of memory parsing relocs\n"));
 	  return false;
 	}
@@ -1257,7 +1349,7 @@ slurp_rela_relocs (Filedata *            filedata,
 #endif /* BFD64 */
 	}
 
-      free (erelas);
+      release_data (filedata, erelas);
     }
 
   *relasp = relas;
@@ -1286,8 +1378,8 @@ slurp_rel_relocs (Filedata *            filedata,
     {
       Elf32_External_Rel * erels;
 
-      erels = (Elf32_External_Rel *) get_data (NULL, filedata, rel_offset, 1,
-                                               rel_size, _("32-bit relocation data"));
+      erels = (Elf32_External_Rel *) get_mapped_data (filedata, rel_offset, 1,
+						      rel_size, _("32-bit relocation data"));
       if (!erels)
 	return false;
 
@@ -1297,7 +1389,7 @@ slurp_rel_relocs (Filedata *            filedata,
 
       if (rels == NULL)
 	{
-	  free (erels);
+	  release_data (filedata, erels);
 	  error (_("out of memory parsing relocs\n"));
 	  return false;
 	}
@@ -1309,14 +1401,14 @@ slurp_rel_relocs (Filedata *            filedata,
 	  rels[i].r_addend = 0;
 	}
 
-      free (erels);
+      release_data (filedata, erels);
     }
   else
     {
       Elf64_External_Rel * erels;
 
-      erels = (Elf64_External_Rel *) get_data (NULL, filedata, rel_offset, 1,
-                                               rel_size, _("64-bit relocation data"));
+      erels = (Elf64_External_Rel *) get_mapped_data (filedata, rel_offset, 1,
+						      rel_size, _("64-bit relocation data"));
       if (!erels)
 	return false;
 
@@ -1326,7 +1418,7 @@ slurp_rel_relocs (Filedata *            filedata,
 
       if (rels == NULL)
 	{
-	  free (erels);
+	  release_data (filedata, erels);
 	  error (_("out of memory parsing relocs\n"));
 	  return false;
 	}
@@ -1360,7 +1452,7 @@ slurp_rel_relocs (Filedata *            filedata,
 #endif /* BFD64 */
 	}
 
-      free (erels);
+      release_data (filedata, erels);
     }
 
   *relsp = rels;
@@ -5127,7 +5219,8 @@ enum long_option_values
   OPTION_RECURSE_LIMIT,
   OPTION_NO_RECURSE_LIMIT,
   OPTION_NO_DEMANGLING,
-  OPTION_SYM_BASE
+  OPTION_SYM_BASE,
+  OPTION_THREADS
 };
 
 static struct option options[] =
@@ -5179,6 +5272,7 @@ static struct option options[] =
   {"dwarf-depth",      required_argument, 0, OPTION_DWARF_DEPTH},
   {"dwarf-start",      required_argument, 0, OPTION_DWARF_START},
   {"dwarf-check",      no_argument, 0, OPTION_DWARF_CHECK},
+  {"threads",          optional_argument, 0, OPTION_THREADS},
 #ifdef ENABLE_LIBCTF
   {"ctf",	       required_argument, 0, OPTION_CTF_DUMP},
   {"ctf-symbols",      required_argument, 0, OPTION_CTF_SYMBOLS},
@@ -5313,6 +5407,8 @@ usage (FILE * stream)
   --dwarf-depth=N        Do not display DIEs at depth N or greater\n"));
   fprintf (stream, _("\
   --dwarf-start=N        Display DIEs starting at offset N\n"));
+  fprintf (stream, _("\
+  --threads[=N]          Decode .debug_info using up to N parallel jobs\n"));
 #ifdef ENABLE_LIBCTF
   fprintf (stream, _("\
   --ctf=<number|name>    Display CTF info from section <number|name>\n"));
@@ -5582,6 +5678,26 @@ parse_args (struct dump_data *dumpdata, int argc, char ** argv)
 	case OPTION_DWARF_CHECK:
 	  dwarf_check = true;
 	  break;
+	case OPTION_THREADS:
+	  if (optarg == NULL)
+	    {
+#ifdef _SC_NPROCESSORS_ONLN
+	      long ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+
+	      dwarf_jobs = ncpu > 0 ? ncpu : 1;
+#endif
+	    }
+	  else
+	    {
+	      char *cp;
+	      unsigned long jobs = strtoul (optarg, & cp, 0);
+
+	      if (*cp != 0 || jobs == 0 || jobs > UINT_MAX)
+		error (_("invalid thread count: %s\n"), optarg);
+	      else
+		dwarf_jobs = jobs;
+	    }
+	  break;
 	case OPTION_CTF_DUMP:
 	  do_ctf = true;
 	  request_dump (dumpdata, CTF_DUMP);
@@ -6542,8 +6658,8 @@ get_32bit_elf_symbols (Filedata *           filedata,
       goto exit_point;
     }
 
-  esyms = (Elf32_External_Sym *) get_data (NULL, filedata, section->sh_offset, 1,
-                                           section->sh_size, _("symbols"));
+  esyms = (Elf32_External_Sym *) get_mapped_data (filedata, section->sh_offset, 1,
+						  section->sh_size, _("symbols"));
   if (esyms == NULL)
     goto exit_point;
 
@@ -6556,13 +6672,13 @@ get_32bit_elf_symbols (Filedata *           filedata,
       if (shndx != NULL)
 	{
 	  error (_("Multiple symbol table index sections associated with the same symbol section\n"));
-	  free (shndx);
+	  release_data (filedata, shndx);
 	}
 
-      shndx = (Elf_External_Sym_Shndx *) get_data (NULL, filedata,
-						   entry->hdr->sh_offset,
-						   1, entry->hdr->sh_size,
-						   _("symbol table section indices"));
+      shndx = (Elf_External_Sym_Shndx *) get_mapped_data (filedata,
+							  entry->hdr->sh_offset,
+							  1, entry->hdr->sh_size,
+							  _("symbol table section indices"));
       if (shndx == NULL)
 	goto exit_point;
 
@@ -6602,8 +6718,8 @@ get_32bit_elf_symbols (Filedata *           filedata,
     }
 
  exit_point:
-  free (shndx);
-  free (esyms);
+  release_data (filedata, shndx);
+  release_data (filedata, esyms);
 
   if (num_syms_return != NULL)
     * num_syms_return = isyms == NULL ? 0 : number;
@@ -6659,8 +6775,8 @@ get_64bit_elf_symbols (Filedata *           filedata,
       goto exit_point;
     }
 
-  esyms = (Elf64_External_Sym *) get_data (NULL, filedata, section->sh_offset, 1,
-                                           section->sh_size, _("symbols"));
+  esyms = (Elf64_External_Sym *) get_mapped_data (filedata, section->sh_offset, 1,
+						  section->sh_size, _("symbols"));
   if (!esyms)
     goto exit_point;
 
@@ -6673,13 +6789,13 @@ get_64bit_elf_symbols (Filedata *           filedata,
       if (shndx != NULL)
 	{
 	  error (_("Multiple symbol table index sections associated with the same symbol section\n"));
-	  free (shndx);
+	  release_data (filedata, shndx);
 	}
 
-      shndx = (Elf_External_Sym_Shndx *) get_data (NULL, filedata,
-						   entry->hdr->sh_offset,
-						   1, entry->hdr->sh_size,
-						   _("symbol table section indices"));
+      shndx = (Elf_External_Sym_Shndx *) get_mapped_data (filedata,
+							  entry->hdr->sh_offset,
+							  1, entry->hdr->sh_size,
+							  _("symbol table section indices"));
       if (shndx == NULL)
 	goto exit_point;
 
@@ -6721,8 +6837,8 @@ get_64bit_elf_symbols (Filedata *           filedata,
     }
 
  exit_point:
-  free (shndx);
-  free (esyms);
+  release_data (filedata, shndx);
+  release_data (filedata, esyms);
 
   if (num_syms_return != NULL)
     * num_syms_return = isyms == NULL ? 0 : number;
@@ -7743,6 +7859,8 @@ process_section_headers (Filedata * filedata)
 		    {
 		      if (chdr.ch_type == ELFCOMPRESS_ZLIB)
 			printf ("       ZLIB, ");
+		      else if (chdr.ch_type == ELFCOMPRESS_ZSTD)
+			printf ("       ZSTD, ");
 		      else
 			printf (_("       [<unknown>: 0x%x], "),
 				chdr.ch_type);
@@ -15190,10 +15308,12 @@ get_section_contents (Elf_Internal_Shdr * section, Filedata * filedata)
                              _("section contents"));
 }
 
-/* Uncompresses a section that was compressed using zlib, in place.  */
+/* Uncompresses a section that was compressed using zlib or zstd,
+   in place.  */
 
 static bool
-uncompress_section_contents (unsigned char **   buffer,
+uncompress_section_contents (bool               is_zstd,
+			     unsigned char **   buffer,
 			     dwarf_size_type    uncompressed_size,
 			     dwarf_size_type *  size)
 {
@@ -15203,6 +15323,25 @@ uncompress_section_contents (unsigned char **   buffer,
   z_stream strm;
   int rc;
 
+  if (is_zstd)
+    {
+#ifdef HAVE_ZSTD
+      size_t ret;
+
+      uncompressed_buffer = (unsigned char *) xmalloc (uncompressed_size);
+      ret = ZSTD_decompress (uncompressed_buffer, uncompressed_size,
+			     compressed_buffer, compressed_size);
+      if (ZSTD_isError (ret) || ret != uncompressed_size)
+	goto fail;
+      *buffer = uncompressed_buffer;
+      *size = uncompressed_size;
+      return true;
+#else
+      *buffer = NULL;
+      return false;
+#endif
+    }
+
   /* It is possible the section consists of several compressed
      buffers concatenated together, so we uncompress in a loop.  */
   /* PR 18313: The state field in the z_stream structure is supposed
@@ -15274,6 +15413,7 @@ dump_section_as_strings (Elf_Internal_Shdr * section, Filedata * filedata)
     {
       dwarf_size_type new_size = num_bytes;
       dwarf_size_type uncompressed_size = 0;
+      bool is_zstd = false;
 
       if ((section->sh_flags & SHF_COMPRESSED) != 0)
 	{
@@ -15286,7 +15426,13 @@ dump_section_as_strings (Elf_Internal_Shdr * section, Filedata * filedata)
 	       by get_compression_header.  */
 	    goto error_out;
 
-	  if (chdr.ch_type != ELFCOMPRESS_ZLIB)
+	  if (chdr.ch_type == ELFCOMPRESS_ZLIB)
+	    ;
+#ifdef HAVE_ZSTD
+	  else if (chdr.ch_type == ELFCOMPRESS_ZSTD)
+	    is_zstd = true;
+#endif
+	  else
 	    {
 	      warn (_("section '%s' has unsupported compress type: %d\n"),
 		    printable_section_name (filedata, section), chdr.ch_type);
@@ -15315,7 +15461,7 @@ dump_section_as_strings (Elf_Internal_Shdr * section, Filedata * filedata)
 
       if (uncompressed_size)
 	{
-	  if (uncompress_section_contents (& start,
+	  if (uncompress_section_contents (is_zstd, & start,
 					   uncompressed_size, & new_size))
 	    num_bytes = new_size;
 	  else
@@ -15490,6 +15636,7 @@ dump_section_as_bytes (Elf_Internal_Shdr *section,
     {
       dwarf_size_type new_size = section_size;
       dwarf_size_type uncompressed_size = 0;
+      bool is_zstd = false;
 
       if ((section->sh_flags & SHF_COMPRESSED) != 0)
 	{
@@ -15502,7 +15649,13 @@ dump_section_as_bytes (Elf_Internal_Shdr *section,
 	       by get_compression_header.  */
 	    goto error_out;
 
-	  if (chdr.ch_type != ELFCOMPRESS_ZLIB)
+	  if (chdr.ch_type == ELFCOMPRESS_ZLIB)
+	    ;
+#ifdef HAVE_ZSTD
+	  else if (chdr.ch_type == ELFCOMPRESS_ZSTD)
+	    is_zstd = true;
+#endif
+	  else
 	    {
 	      warn (_("section '%s' has unsupported compress type: %d\n"),
 		    printable_section_name (filedata, section), chdr.ch_type);
@@ -15531,8 +15684,8 @@ dump_section_as_bytes (Elf_Internal_Shdr *section,
 
       if (uncompressed_size)
 	{
-	  if (uncompress_section_contents (& start, uncompressed_size,
-					   & new_size))
+	  if (uncompress_section_contents (is_zstd, & start,
+					   uncompressed_size, & new_size))
 	    {
 	      section_size = new_size;
 	    }
@@ -15838,6 +15991,32 @@ dump_section_as_ctf (Elf_Internal_Shdr * section, Filedata * filedata)
 }
 #endif
 
+/* Which of the loaded debug sections point into the mapping of their
+   file, rather than to malloc'd memory.  */
+static bool debug_section_mapped[max];
+
+/* Return true if the debug section DEBUG holds strings, which are
+   read as C strings and so must be followed by a NUL even if the last
+   one in the section is unterminated.  Such sections are copied rather
+   than mapped.  */
+
+static bool
+debug_section_has_strings (enum dwarf_section_display_enum debug)
+{
+  switch (debug)
+    {
+    case str:
+    case line_str:
+    case str_dwo:
+    case str_index:
+    case str_index_dwo:
+    case separate_debug_str:
+      return true;
+    default:
+      return false;
+    }
+}
+
 static bool
 load_specific_debug_section (enum dwarf_section_display_enum  debug,
 			     const Elf_Internal_Shdr *        sec,
@@ -15852,15 +16031,22 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
       /* If it is already loaded, do nothing.  */
       if (streq (section->filename, filedata->file_name))
 	return true;
-      free (section->start);
+      if (!debug_section_mapped[debug])
+	free (section->start);
     }
 
   snprintf (buf, sizeof (buf), _("%s section data"), section->name);
   section->address = sec->sh_addr;
   section->filename = filedata->file_name;
-  section->start = (unsigned char *) get_data (NULL, filedata,
-                                               sec->sh_offset, 1,
-                                               sec->sh_size, buf);
+  if (debug_section_has_strings (debug))
+    section->start = (unsigned char *) get_data (NULL, filedata,
+						 sec->sh_offset, 1,
+						 sec->sh_size, buf);
+  else
+    section->start = (unsigned char *) get_mapped_data (filedata,
+							sec->sh_offset, 1,
+							sec->sh_size, buf);
+  debug_section_mapped[debug] = is_mapped_data (filedata, section->start);
   if (section->start == NULL)
     section->size = 0;
   else
@@ -15868,6 +16054,7 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
       unsigned char *start = section->start;
       dwarf_size_type size = sec->sh_size;
       dwarf_size_type uncompressed_size = 0;
+      bool is_zstd = false;
 
       if ((sec->sh_flags & SHF_COMPRESSED) != 0)
 	{
@@ -15889,7 +16076,13 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
 	       by get_compression_header.  */
 	    return false;
 
-	  if (chdr.ch_type != ELFCOMPRESS_ZLIB)
+	  if (chdr.ch_type == ELFCOMPRESS_ZLIB)
+	    ;
+#ifdef HAVE_ZSTD
+	  else if (chdr.ch_type == ELFCOMPRESS_ZSTD)
+	    is_zstd = true;
+#endif
+	  else
 	    {
 	      warn (_("section '%s' has unsupported compress type: %d\n"),
 		    section->name, chdr.ch_type);
@@ -15918,13 +16111,15 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
 
       if (uncompressed_size)
 	{
-	  if (uncompress_section_contents (&start, uncompressed_size,
+	  if (uncompress_section_contents (is_zstd, &start, uncompressed_size,
 					   &size))
 	    {
 	      /* Free the compressed buffer, update the section buffer
 		 and the section size if uncompress is successful.  */
-	      free (section->start);
+	      if (!debug_section_mapped[debug])
+		free (section->start);
 	      section->start = start;
+	      debug_section_mapped[debug] = false;
 	    }
 	  else
 	    {
@@ -16161,7 +16356,9 @@ free_debug_section (enum dwarf_section_display_enum debug)
   if (section->start == NULL)
     return;
 
-  free ((char *) section->start);
+  if (!debug_section_mapped[debug])
+    free ((char *) section->start);
+  debug_section_mapped[debug] = false;
   section->start = NULL;
   section->address = 0;
   section->size = 0;
@@ -22174,6 +22371,7 @@ close_file (Filedata * filedata)
 {
   if (filedata)
     {
+      unmap_file (filedata);
       if (filedata->handle)
 	fclose (filedata->handle);
       free (filedata);
@@ -22208,6 +22406,7 @@ open_file (const char * pathname, bool is_separate)
   filedata->file_size = (bfd_size_type) statbuf.st_size;
   filedata->file_name = pathname;
   filedata->is_separate = is_separate;
+  map_file (filedata);
 
   if (! get_file_header (filedata))
     goto fail;
@@ -22220,6 +22419,7 @@ open_file (const char * pathname, bool is_separate)
  fail:
   if (filedata)
     {
+      unmap_file (filedata);
       if (filedata->handle)
         fclose (filedata->handle);
       free (filedata);
@@ -22767,6 +22967,7 @@ process_file (char * file_name)
 
   filedata->file_size = (bfd_size_type) statbuf.st_size;
   filedata->is_separate = false;
+  map_file (filedata);
 
   if (memcmp (armag, ARMAG, SARMAG) == 0)
     {
@@ -22791,6 +22992,7 @@ process_file (char * file_name)
 	ret = false;
     }
 
+  unmap_file (filedata);
   fclose (filedata->handle);
   free (filedata->section_headers);
   free (filedata->program_headers);
@@ -89,6 +89,9 @@
 #include "libiberty.h"
 #include "safe-ctype.h"
 #include "bucomm.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #ifndef streq
 #define streq(a,b) (strcmp ((a),(b)) == 0)
@@ -491,116 +494,139 @@ strings_file (char *file)
   return true;
 }
 
-/* Read the next character, return EOF if none available.
-   Assume that STREAM is positioned so that the next byte read
-   is at address ADDRESS in the file.
-
-   If STREAM is NULL, do not read from it.
-   The caller can supply a buffer of characters
-   to be processed before the data in STREAM.
-   MAGIC is the address of the buffer and
-   MAGICCOUNT is how many characters are in it.  */
+/* The strings are located by scanning blocks of the input in memory
+   rather than reading it a character at a time.  GRAPHIC_BYTE[B] is
+   true if the byte B, taken as a character, satisfies
+   STRING_ISGRAPHIC.  CHAR_BYTE is the offset within a multi-byte
+   character of the byte holding its value; the other bytes must be
+   zero for the character to be graphic.  */
 
-static long
-get_char (FILE *stream, file_ptr *address, int *magiccount, char **magic)
-{
-  int c, i;
-  long r = 0;
-
-  for (i = 0; i < encoding_bytes; i++)
-    {
-      if (*magiccount)
-	{
-	  (*magiccount)--;
-	  c = *(*magic)++;
-	}
-      else
-	{
-	  if (stream == NULL)
-	    return EOF;
+static bool graphic_byte[256];
+static unsigned int char_byte;
 
-	  /* Only use getc_unlocked if we found a declaration for it.
-	     Otherwise, libc is not thread safe by default, and we
-	     should not use it.  */
+/* Number of bytes read from a stream at a time.  */
+#define STRINGS_BLOCK_SIZE (1024 * 1024)
 
-#if defined(HAVE_GETC_UNLOCKED) && HAVE_DECL_GETC_UNLOCKED
-	  c = getc_unlocked (stream);
-#else
-	  c = getc (stream);
-#endif
-	  if (c == EOF)
-	    return EOF;
-	}
+static void
+init_graphic_bytes (void)
+{
+  int c;
 
-      (*address)++;
-      r = (r << 8) | (c & 0xff);
-    }
+  for (c = 0; c < 256; c++)
+    graphic_byte[c] = STRING_ISGRAPHIC (c);
 
   switch (encoding)
     {
     default:
+      char_byte = 0;
       break;
-    case 'l':
-      r = ((r & 0xff) << 8) | ((r & 0xff00) >> 8);
+    case 'b':
+      char_byte = 1;
       break;
-    case 'L':
-      r = (((r & 0xff) << 24) | ((r & 0xff00) << 8)
-	   | ((r & 0xff0000) >> 8) | ((r & 0xff000000) >> 24));
+    case 'B':
+      char_byte = 3;
       break;
     }
+}
+
+/* Return TRUE if the ENCODING_BYTES wide character at P is graphic.  */
+
+static inline bool
+graphic_char_p (const unsigned char *p)
+{
+  unsigned int i;
 
-  return r;
+  for (i = 0; i < (unsigned int) encoding_bytes; i++)
+    if (i != char_byte && p[i] != 0)
+      return false;
+  return graphic_byte[p[char_byte]];
 }
 
-/* Throw away one byte of a (possibly) multi-byte char C, updating
-   address and buffer to suit.  */
+#ifdef __SSE2__
+/* Return a mask with bit N set if byte N of the sixteen at P is a
+   graphic single byte character.  This must agree with
+   GRAPHIC_BYTE.  */
 
-static void
-unget_part_char (long c, file_ptr *address, int *magiccount, char **magic)
+static inline unsigned int
+graphic_mask (const unsigned char *p)
 {
-  static char tmp[4];
+  __m128i x = _mm_loadu_si128 ((const __m128i *) p);
+  __m128i m;
+
+  /* 0x20 to 0x7e, comparing as signed bytes.  */
+  m = _mm_and_si128 (_mm_cmpgt_epi8 (x, _mm_set1_epi8 (0x1f)),
+		     _mm_cmplt_epi8 (x, _mm_set1_epi8 (0x7f)));
+  if (include_all_whitespace)
+    /* '\t', '\n', '\v', '\f' and '\r'.  */
+    m = _mm_or_si128 (m,
+		      _mm_and_si128 (_mm_cmpgt_epi8 (x, _mm_set1_epi8 (0x08)),
+				     _mm_cmplt_epi8 (x, _mm_set1_epi8 (0x0e))));
+  else
+    m = _mm_or_si128 (m, _mm_cmpeq_epi8 (x, _mm_set1_epi8 ('\t')));
+  if (encoding == 'S')
+    m = _mm_or_si128 (m, _mm_cmplt_epi8 (x, _mm_setzero_si128 ()));
+  return _mm_movemask_epi8 (m);
+}
+#endif
 
-  if (encoding_bytes > 1)
-    {
-      *address -= encoding_bytes - 1;
+/* Return the offset of the first character at or after POS in BUF,
+   which holds LEN bytes, that is graphic.  Multi-byte characters may
+   start at any byte.  If there is none, return the offset of the
+   first incomplete character, which is LEN for single byte
+   encodings.  */
 
-      if (*magiccount == 0)
+static size_t
+find_graphic (const unsigned char *buf, size_t pos, size_t len)
+{
+  if (encoding_bytes == 1)
+    {
+#ifdef __SSE2__
+      for (; pos + 16 <= len; pos += 16)
 	{
-	  /* If no magic buffer exists, use temp buffer.  */
-	  switch (encoding)
-	    {
-	    default:
-	      break;
-	    case 'b':
-	      tmp[0] = c & 0xff;
-	      *magiccount = 1;
-	      break;
-	    case 'l':
-	      tmp[0] = (c >> 8) & 0xff;
-	      *magiccount = 1;
-	      break;
-	    case 'B':
-	      tmp[0] = (c >> 16) & 0xff;
-	      tmp[1] = (c >> 8) & 0xff;
-	      tmp[2] = c & 0xff;
-	      *magiccount = 3;
-	      break;
-	    case 'L':
-	      tmp[0] = (c >> 8) & 0xff;
-	      tmp[1] = (c >> 16) & 0xff;
-	      tmp[2] = (c >> 24) & 0xff;
-	      *magiccount = 3;
-	      break;
-	    }
-	  *magic = tmp;
+	  unsigned int mask = graphic_mask (buf + pos);
+	  if (mask != 0)
+	    return pos + __builtin_ctz (mask);
 	}
-      else
+#endif
+      for (; pos < len; pos++)
+	if (graphic_byte[buf[pos]])
+	  break;
+      return pos;
+    }
+
+  for (; pos + encoding_bytes <= len; pos++)
+    if (graphic_char_p (buf + pos))
+      break;
+  return pos;
+}
+
+/* Return the offset of the first character after the run of graphic
+   characters starting at POS in BUF, which holds LEN bytes.  The
+   character there is either not graphic or is incomplete.  */
+
+static size_t
+find_graphic_end (const unsigned char *buf, size_t pos, size_t len)
+{
+  if (encoding_bytes == 1)
+    {
+#ifdef __SSE2__
+      for (; pos + 16 <= len; pos += 16)
 	{
-	  /* If magic buffer exists, rewind.  */
-	  *magic -= encoding_bytes - 1;
-	  *magiccount += encoding_bytes - 1;
+	  unsigned int mask = graphic_mask (buf + pos) ^ 0xffff;
+	  if (mask != 0)
+	    return pos + __builtin_ctz (mask);
 	}
+#endif
+      for (; pos < len; pos++)
+	if (!graphic_byte[buf[pos]])
+	  break;
+      return pos;
     }
+
+  for (; pos + encoding_bytes <= len; pos += encoding_bytes)
+    if (!graphic_char_p (buf + pos))
+      break;
+  return pos;
 }
 
 static void
@@ -1223,6 +1249,82 @@ print_unicode_stream (const char * filename,
   free (print_buf);
 }
 
+/* Print the characters in BUF from START up to END, which are all
+   graphic.  */
+
+static void
+print_graphic_chars (const unsigned char *buf, size_t start, size_t end)
+{
+  if (encoding_bytes == 1)
+    {
+      fwrite (buf + start, 1, end - start, stdout);
+      return;
+    }
+
+  for (; start < end; start += encoding_bytes)
+    putchar (buf[start + char_byte]);
+}
+
+/* Print the strings in BUF, which holds LEN bytes of file FILENAME
+   starting at ADDRESS.  If AT_EOF is false, more data follows BUF, so
+   a string running to the end of BUF may continue in the next block.
+   *IN_STRING is TRUE if a string was being printed at the end of the
+   previous block and is updated for the end of this one.  Return the
+   number of bytes consumed; the remainder must be passed again at the
+   start of the next block.  */
+
+static size_t
+print_strings_block (const char *filename, file_ptr address,
+		     const unsigned char *buf, size_t len, bool at_eof,
+		     bool *in_string)
+{
+  size_t pos = 0;
+
+  while (1)
+    {
+      size_t start, end;
+
+      start = *in_string ? pos : find_graphic (buf, pos, len);
+      if (start + encoding_bytes > len && !at_eof)
+	return start;
+
+      end = find_graphic_end (buf, start, len);
+      if (end + encoding_bytes > len && !at_eof)
+	{
+	  /* The string may continue in the next block.  Start printing
+	     it if it is already long enough, otherwise keep it.  */
+	  if (!*in_string)
+	    {
+	      if ((end - start) / encoding_bytes < string_min)
+		return start;
+	      print_filename_and_address (filename, address + start);
+	      *in_string = true;
+	    }
+	  print_graphic_chars (buf, start, end);
+	  return end;
+	}
+
+      if (*in_string || (end - start) / encoding_bytes >= string_min)
+	{
+	  if (!*in_string)
+	    print_filename_and_address (filename, address + start);
+	  print_graphic_chars (buf, start, end);
+	  if (output_separator)
+	    fputs (output_separator, stdout);
+	  else
+	    putchar ('\n');
+	  *in_string = false;
+	}
+
+      if (end + encoding_bytes > len)
+	return len;
+
+      /* Skip the non-graphic character.  For multi-byte encodings the
+	 next string may start at any of its bytes but the first.  */
+      pos = end + 1;
+    }
+}
+
 /* Find the strings in file FILENAME, read from STREAM.
    Assume that STREAM is positioned so that the next byte read
    is at address ADDRESS in the file.
@@ -1249,63 +1351,46 @@ print_strings (const char *filename, FILE *stream, file_ptr address,
       return;
     }
 
-  char *buf = (char *) xmalloc (sizeof (char) * (string_min + 1));
+  bool in_string = false;
 
-  while (1)
-    {
-      file_ptr start;
-      unsigned int i;
-      long c;
+  init_graphic_bytes ();
 
-      /* See if the next `string_min' chars are all graphic chars.  */
-    tryline:
-      start = address;
-      for (i = 0; i < string_min; i++)
-	{
-	  c = get_char (stream, &address, &magiccount, &magic);
-	  if (c == EOF)
-	    {
-	      free (buf);
-	      return;
-	    }
+  if (stream == NULL)
+    {
+      if (magic != NULL)
+	print_strings_block (filename, address, (unsigned char *) magic,
+			     magiccount, true, &in_string);
+      return;
+    }
 
-	  if (! STRING_ISGRAPHIC (c))
-	    {
-	      /* Found a non-graphic.  Try again starting with next byte.  */
-	      unget_part_char (c, &address, &magiccount, &magic);
-	      goto tryline;
-	    }
-	  buf[i] = c;
-	}
+  /* Read STREAM a block at a time.  The buffer must also be able to
+     hold the start of a string too short to print yet, which is kept
+     for the next block.  */
+  size_t size = (STRINGS_BLOCK_SIZE + magiccount
+		 + ((size_t) string_min + 1) * encoding_bytes);
+  unsigned char *buf = (unsigned char *) xmalloc (size);
+  size_t len = magiccount;
+  bool at_eof = false;
 
-      /* We found a run of `string_min' graphic characters.  Print up
-	 to the next non-graphic character.  */
-      print_filename_and_address (filename, start);
+  if (magiccount != 0)
+    memcpy (buf, magic, magiccount);
 
-      buf[i] = '\0';
-      fputs (buf, stdout);
+  while (!at_eof)
+    {
+      size_t done;
 
-      while (1)
-	{
-	  c = get_char (stream, &address, &magiccount, &magic);
-	  if (c == EOF)
-	    break;
-	  if (! STRING_ISGRAPHIC (c))
-	    {
-	      unget_part_char (c, &address, &magiccount, &magic);
-	      break;
-	    }
-	  putchar (c);
-	}
+      len += fread (buf + len, 1, size - len, stream);
+      at_eof = len < size;
 
-      if (output_separator)
-	fputs (output_separator, stdout);
-      else
-	putchar ('\n');
+      done = print_strings_block (filename, address, buf, len, at_eof,
+				  &in_string);
+      memmove (buf, buf + done, len - done);
+      len -= done;
+      address += done;
     }
   free (buf);
 }
-
+
 static void
 usage (FILE *stream, int status)
 {
@@ -0,0 +1,31 @@
+/* This program is used to test addr2line --batch.  */
+
+int table[16];
+
+static inline __attribute__ ((always_inline)) int
+get (int i)
+{
+  return table[i & 15];
+}
+
+static inline __attribute__ ((always_inline)) int
+sum (int n)
+{
+  int i, s = 0;
+
+  for (i = 0; i < n; i++)
+    s += get (i) * i;
+  return s;
+}
+
+int
+fn (int n)
+{
+  return sum (n) + get (n);
+}
+
+int
+main (void)
+{
+  return fn (3) + sum (5);
+}
@@ -0,0 +1,34 @@
+/* A compilation unit whose name is the last string of .debug_str,
+   and is not terminated.  The section contents must not be read
+   beyond its end, wherever readelf keeps them.  */
+
+	.section .debug_info
+	.4byte	.Linfo_end - .Linfo_start	/* Length of CU */
+.Linfo_start:
+	.2byte	4				/* DWARF version */
+	.4byte	0				/* Offset into abbrev section */
+	.byte	4				/* Pointer size */
+
+	.uleb128 1				/* DW_TAG_compile_unit */
+	.4byte	0				/* DW_AT_producer */
+	.4byte	9				/* DW_AT_name */
+	.ascii	"/tmp\0"			/* DW_AT_comp_dir */
+.Linfo_end:
+
+	.section .debug_abbrev
+	.uleb128 1				/* Abbrev code */
+	.uleb128 0x11				/* DW_TAG_compile_unit */
+	.byte	0				/* DW_CHILDREN_no */
+	.uleb128 0x25				/* DW_AT_producer */
+	.uleb128 0x0e				/* DW_FORM_strp */
+	.uleb128 0x03				/* DW_AT_name */
+	.uleb128 0x0e				/* DW_FORM_strp */
+	.uleb128 0x1b				/* DW_AT_comp_dir */
+	.uleb128 0x08				/* DW_FORM_string */
+	.byte	0
+	.byte	0
+	.byte	0
+
+	.section .debug_str
+	.ascii	"producer\0"
+	.ascii	"unterminated"
@@ -395,9 +395,11 @@ scan_for_multibyte_characters (const unsigned char *  start,
 }
 
 /* This function is called to process input characters.  The GET
-   parameter is used to retrieve more input characters.  GET should
-   set its parameter to point to a buffer, and return the length of
-   the buffer; it should return 0 at end of file.  The scrubbed output
+   parameter is used to retrieve more input characters.  GET is passed
+   a pointer to a buffer of the given length; it may either fill that
+   buffer or set its parameter to point to a buffer of its own, and
+   should return the number of characters available, or 0 at end of
+   file.  The scrubbed output
    characters are put into the buffer starting at TOSTART; the TOSTART
    buffer is TOLEN bytes in length.  The function returns the number
    of scrubbed characters put into TOSTART.  This will be TOLEN unless
@@ -406,7 +408,8 @@ scan_for_multibyte_characters (const unsigned char *  start,
    This is the way the old code used to work.  */
 
 size_t
-do_scrub_chars (size_t (*get) (char *, size_t), char *tostart, size_t tolen)
+do_scrub_chars (size_t (*get) (char **, size_t), char *tostart,
+		size_t tolen)
 {
   char *to = tostart;
   char *toend = tostart + tolen;
@@ -471,8 +474,8 @@ do_scrub_chars (size_t (*get) (char *, size_t), char *tostart, size_t tolen)
   (from < fromend						\
    ? * (unsigned char *) (from++)				\
    : (saved_input = NULL,					\
-      fromlen = (*get) (input_buffer, sizeof input_buffer),	\
       from = input_buffer,					\
+      fromlen = (*get) (&from, sizeof input_buffer),		\
       fromend = from + fromlen,					\
       (fromlen == 0						\
        ? EOF							\
@@ -507,10 +510,10 @@ do_scrub_chars (size_t (*get) (char *, size_t), char *tostart, size_t tolen)
     }
   else
     {
-      fromlen = (*get) (input_buffer, sizeof input_buffer);
+      from = input_buffer;
+      fromlen = (*get) (&from, sizeof input_buffer);
       if (fromlen == 0)
 	return 0;
-      from = input_buffer;
       fromend = from + fromlen;
 
       if (multibyte_handling == multibyte_warn)
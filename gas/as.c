@@ -38,6 +38,7 @@
 #include "as.h"
 #include "subsegs.h"
 #include "output-file.h"
+#include "input-file.h"
 #include "sb.h"
 #include "macro.h"
 #include "dwarf2dbg.h"
@@ -124,6 +125,9 @@ static struct defsym_list *defsyms;
 
 static long start_time;
 
+/* Time spent in perform_an_assembly_pass, for --statistics.  */
+static long pass_time;
+
 static int flag_macro_alternate;
 
 
@@ -252,15 +256,15 @@ Options:\n\
   --alternate             initially turn on alternate macro syntax\n"));
 #ifdef DEFAULT_FLAG_COMPRESS_DEBUG
   fprintf (stream, _("\
-  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi}]\n\
-                          compress DWARF debug sections using zlib [default]\n"));
+  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
+                          compress DWARF debug sections [default]\n"));
   fprintf (stream, _("\
   --nocompress-debug-sections\n\
                           don't compress DWARF debug sections\n"));
 #else
   fprintf (stream, _("\
-  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi}]\n\
-                          compress DWARF debug sections using zlib\n"));
+  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
+                          compress DWARF debug sections\n"));
   fprintf (stream, _("\
   --nocompress-debug-sections\n\
                           don't compress DWARF debug sections [default]\n"));
@@ -736,6 +740,15 @@ This program has absolutely no warranty.\n"));
 		flag_compress_debug = COMPRESS_DEBUG_GNU_ZLIB;
 	      else if (strcasecmp (optarg, "zlib-gabi") == 0)
 		flag_compress_debug = COMPRESS_DEBUG_GABI_ZLIB;
+	      else if (strcasecmp (optarg, "zstd") == 0)
+		{
+#ifdef HAVE_ZSTD
+		  flag_compress_debug = COMPRESS_DEBUG_ZSTD;
+#else
+		  as_fatal (_("--compress-debug-sections=zstd: gas is not "
+			      "built with zstd support"));
+#endif
+		}
 	      else
 		as_fatal (_("Invalid --compress-debug-sections option: `%s'"),
 			  optarg);
@@ -1117,9 +1130,24 @@ dump_statistics (void)
 {
   long run_time = get_run_time () - start_time;
 
+  long read_time, scrub_time, parse_time;
+
   fprintf (stderr, _("%s: total time in assembly: %ld.%06ld\n"),
 	   myname, run_time / 1000000, run_time % 1000000);
 
+  /* Whatever part of the first pass was not spent reading or
+     scrubbing the input was spent parsing and assembling it.  */
+  input_file_times (&read_time, &scrub_time);
+  parse_time = pass_time - read_time - scrub_time;
+  if (parse_time < 0)
+    parse_time = 0;
+  fprintf (stderr, _("%s: time reading input: %ld.%06ld\n"),
+	   myname, read_time / 1000000, read_time % 1000000);
+  fprintf (stderr, _("%s: time scrubbing input: %ld.%06ld\n"),
+	   myname, scrub_time / 1000000, scrub_time % 1000000);
+  fprintf (stderr, _("%s: time parsing input: %ld.%06ld\n"),
+	   myname, parse_time / 1000000, parse_time % 1000000);
+
   subsegs_print_statistics (stderr);
   write_print_statistics (stderr);
   symbol_print_statistics (stderr);
@@ -1245,6 +1273,7 @@ main (int argc, char ** argv)
   struct stat sob;
 
   int macro_strip_at;
+  long pass_start;
 
   start_time = get_run_time ();
   signal_init ();
@@ -1394,7 +1423,9 @@ main (int argc, char ** argv)
   PROGRESS (1);
 
   /* Assemble it.  */
+  pass_start = get_run_time ();
   perform_an_assembly_pass (argc, argv);
+  pass_time = get_run_time () - pass_start;
 
   cond_finish_check (-1);
 
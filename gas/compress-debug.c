@@ -19,21 +19,32 @@
    02110-1301, USA.  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include "ansidecl.h"
 #include "compress-debug.h"
 
 /* Initialize the compression engine.  */
 
-struct z_stream_s *
-compress_init (void)
+void *
+compress_init (bool use_zstd)
 {
-  static struct z_stream_s strm;
+  if (use_zstd)
+    {
+#ifdef HAVE_ZSTD
+      return ZSTD_createCCtx ();
+#else
+      return NULL;
+#endif
+    }
 
-  strm.zalloc = NULL;
-  strm.zfree = NULL;
-  strm.opaque = NULL;
+  static struct z_stream_s strm;
+  memset (&strm, 0, sizeof (strm));
   deflateInit (&strm, Z_DEFAULT_COMPRESSION);
   return &strm;
 }
@@ -42,10 +53,32 @@ compress_init (void)
    from the engine goes into the current frag on the obstack.  */
 
 int
-compress_data (struct z_stream_s *strm, const char **next_in,
+compress_data (bool use_zstd, void *ctx, const char **next_in,
 	       int *avail_in, char **next_out, int *avail_out)
 {
-  int out_size = 0;
+  int out_size;
+
+  if (use_zstd)
+    {
+#ifdef HAVE_ZSTD
+      ZSTD_outBuffer ob = { *next_out, *avail_out, 0 };
+      ZSTD_inBuffer ib = { *next_in, *avail_in, 0 };
+      size_t ret = ZSTD_compressStream2 ((ZSTD_CCtx *) ctx, &ob, &ib,
+					 ZSTD_e_continue);
+      if (ZSTD_isError (ret))
+	return -1;
+      out_size = ob.pos;
+      *next_in += ib.pos;
+      *avail_in -= ib.pos;
+      *next_out += ob.pos;
+      *avail_out -= ob.pos;
+      return out_size;
+#else
+      return -1;
+#endif
+    }
+
+  struct z_stream_s *strm = (struct z_stream_s *) ctx;
   int x;
 
   strm->next_in = (Bytef *) (*next_in);
@@ -71,9 +104,33 @@ compress_data (struct z_stream_s *strm, const char **next_in,
    needed.  */
 
 int
-compress_finish (struct z_stream_s *strm, char **next_out,
+compress_finish (bool use_zstd, void *ctx, char **next_out,
 		 int *avail_out, int *out_size)
 {
+  if (use_zstd)
+    {
+#ifdef HAVE_ZSTD
+      ZSTD_outBuffer ob = { *next_out, *avail_out, 0 };
+      ZSTD_inBuffer ib = { 0, 0, 0 };
+      size_t ret = ZSTD_compressStream2 ((ZSTD_CCtx *) ctx, &ob, &ib,
+					 ZSTD_e_end);
+      *out_size = ob.pos;
+      *next_out += ob.pos;
+      *avail_out -= ob.pos;
+      if (ZSTD_isError (ret))
+	return -1;
+      if (ret == 0)
+	{
+	  ZSTD_freeCCtx ((ZSTD_CCtx *) ctx);
+	  return 0;
+	}
+      return 1;
+#else
+      return -1;
+#endif
+    }
+
+  struct z_stream_s *strm = (struct z_stream_s *) ctx;
   int x;
 
   strm->avail_in = 0;
@@ -12098,6 +12098,24 @@ i386_branch_padding_size (fragS *fragP, offsetT address)
   return padding_size;
 }
 
+/* Return TRUE if relaxing FRAGP depends only on its own address and
+   the value of its symbol.  The frags padding branches for
+   -malign-branch also depend on the frags that follow them.  */
+
+bool
+i386_relax_frag_local_p (fragS *fragP)
+{
+  switch (TYPE_FROM_RELAX_STATE (fragP->fr_subtype))
+    {
+    case BRANCH_PADDING:
+    case BRANCH_PREFIX:
+    case FUSED_JCC_PADDING:
+      return false;
+    default:
+      return true;
+    }
+}
+
 /* i386_generic_table_relax_frag()
 
    Handle BRANCH_PADDING, BRANCH_PREFIX and FUSED_JCC_PADDING frags to
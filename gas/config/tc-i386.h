@@ -226,6 +226,9 @@ extern long i386_generic_table_relax_frag (segT, fragS *, long);
 #define md_generic_table_relax_frag(segment, fragP, stretch) \
   i386_generic_table_relax_frag (segment, fragP, stretch)
 
+extern bool i386_relax_frag_local_p (fragS *);
+#define TC_RELAX_FRAG_LOCAL_P(fragP) i386_relax_frag_local_p (fragP)
+
 #define md_number_to_chars number_to_chars_littleendian
 
 enum processor_type
@@ -61,6 +61,9 @@ struct frag {
   const char *fr_file;
   unsigned int fr_line;
 
+  /* The position of the frag in its segment, set by relax_segment.  */
+  unsigned int relax_index;
+
 #ifndef NO_LISTING
   struct list_info_struct *line;
 #endif
@@ -27,6 +27,13 @@
 #include "input-file.h"
 #include "safe-ctype.h"
 
+#if defined (HAVE_MMAP) && defined (HAVE_SYS_MMAN_H) \
+    && !defined (USE_BINARY_FOPEN)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define USE_MMAP 1
+#endif
+
 /* This variable is non-zero if the file currently being read should be
    preprocessed by app.  It is zero if the file can be read straight in.  */
 int preprocess = 0;
@@ -44,6 +51,19 @@ int preprocess = 0;
 static FILE *f_in;
 static const char *file_name;
 
+#ifdef USE_MMAP
+/* When the input is a regular file it is mapped rather than read, and
+   the scrubber is handed pointers straight into the mapping.  F_MAP
+   is NULL when the current file is being read with stdio.  */
+static char *f_map;
+static size_t f_map_size;
+static size_t f_map_pos;
+#endif
+
+/* Time spent reading and scrubbing input, for --statistics.  */
+static long read_time;
+static long scrub_time;
+
 /* Struct for saving the state of this module for file includes.  */
 struct saved_file
   {
@@ -51,6 +71,11 @@ struct saved_file
     const char * file_name;
     int    preprocess;
     char * app_save;
+#ifdef USE_MMAP
+    char * f_map;
+    size_t f_map_size;
+    size_t f_map_pos;
+#endif
   };
 
 /* These hooks accommodate most operating systems.  */
@@ -59,6 +84,9 @@ void
 input_file_begin (void)
 {
   f_in = (FILE *) 0;
+#ifdef USE_MMAP
+  f_map = NULL;
+#endif
 }
 
 void
@@ -88,6 +116,11 @@ input_file_push (void)
   saved->preprocess = preprocess;
   if (preprocess)
     saved->app_save = app_push ();
+#ifdef USE_MMAP
+  saved->f_map = f_map;
+  saved->f_map_size = f_map_size;
+  saved->f_map_pos = f_map_pos;
+#endif
 
   /* Initialize for new file.  */
   input_file_begin ();
@@ -107,10 +140,65 @@ input_file_pop (char *arg)
   preprocess = saved->preprocess;
   if (preprocess)
     app_pop (saved->app_save);
+#ifdef USE_MMAP
+  f_map = saved->f_map;
+  f_map_size = saved->f_map_size;
+  f_map_pos = saved->f_map_pos;
+#endif
 
   free (arg);
 }
 
+#ifdef USE_MMAP
+/* Map the rest of the input file, from the current stream position
+   onwards.  PUSHED is the character last pushed back onto F_IN, which
+   must be the byte found at that position for the mapping to stand in
+   for the stream.  On any failure the file is simply read with stdio.  */
+
+static void
+input_file_map (int pushed)
+{
+  struct stat st;
+  long pos;
+  char *map;
+
+  f_map = NULL;
+  if (f_in == stdin
+      || fstat (fileno (f_in), &st) != 0
+      || !S_ISREG (st.st_mode)
+      || (pos = ftell (f_in)) < 0
+      || (unsigned long) pos >= (unsigned long) st.st_size
+      || (size_t) st.st_size != (unsigned long) st.st_size)
+    return;
+
+  /* The scrubber pushes characters back into its input, so the
+     mapping is private and writable.  */
+  map = mmap (NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+	      fileno (f_in), 0);
+  if (map == MAP_FAILED)
+    return;
+  if ((unsigned char) map[pos] != pushed)
+    {
+      munmap (map, st.st_size);
+      return;
+    }
+
+  f_map = map;
+  f_map_size = st.st_size;
+  f_map_pos = pos;
+}
+
+/* Release the mapping of the current file, if there is one.  */
+
+static void
+input_file_unmap (void)
+{
+  if (f_map != NULL)
+    munmap (f_map, f_map_size);
+  f_map = NULL;
+}
+#endif
+
 /* Open the specified file, "" means stdin.  Filename must not be null.  */
 
 void
@@ -174,9 +262,9 @@ input_file_open (const char *filename,
 	  if (p && startswith (p, "O_APP") && ISSPACE (p[5]))
 	    preprocess = 0;
 	  if (!p || !strchr (p, '\n'))
-	    ungetc ('#', f_in);
+	    c = '#';
 	  else
-	    ungetc ('\n', f_in);
+	    c = '\n';
 	}
       else if (c == 'A')
 	{
@@ -184,17 +272,18 @@ input_file_open (const char *filename,
 	  if (p && startswith (p, "PP") && ISSPACE (p[2]))
 	    preprocess = 1;
 	  if (!p || !strchr (p, '\n'))
-	    ungetc ('#', f_in);
+	    c = '#';
 	  else
-	    ungetc ('\n', f_in);
+	    c = '\n';
 	}
-      else if (c == '\n')
-	ungetc ('\n', f_in);
-      else
-	ungetc ('#', f_in);
+      else if (c != '\n')
+	c = '#';
     }
-  else
-    ungetc (c, f_in);
+  ungetc (c, f_in);
+
+#ifdef USE_MMAP
+  input_file_map (c);
+#endif
 }
 
 /* Close input file.  */
@@ -207,21 +296,46 @@ input_file_close (void)
     fclose (f_in);
 
   f_in = 0;
+#ifdef USE_MMAP
+  input_file_unmap ();
+#endif
 }
 
-/* This function is passed to do_scrub_chars.  */
+/* This function is passed to do_scrub_chars.  It fills the buffer at
+   *BUFP, or when the file is mapped points *BUFP at the next BUFLEN
+   bytes of the mapping instead.  */
 
 static size_t
-input_file_get (char *buf, size_t buflen)
+input_file_get (char **bufp, size_t buflen)
 {
   size_t size;
+  long start = 0;
 
+  if (flag_print_statistics)
+    start = get_run_time ();
+
+#ifdef USE_MMAP
+  if (f_map != NULL)
+    {
+      size = f_map_size - f_map_pos;
+      if (size > buflen)
+	size = buflen;
+      *bufp = f_map + f_map_pos;
+      f_map_pos += size;
+    }
+  else
+#endif
   if (feof (f_in))
-    return 0;
+    size = 0;
+  else
+    {
+      size = fread (*bufp, sizeof (char), buflen, f_in);
+      if (ferror (f_in))
+	as_bad (_("can't read from %s: %s"), file_name, xstrerror (errno));
+    }
 
-  size = fread (buf, sizeof (char), buflen, f_in);
-  if (ferror (f_in))
-    as_bad (_("can't read from %s: %s"), file_name, xstrerror (errno));
+  if (flag_print_statistics)
+    read_time += get_run_time () - start;
   return size;
 }
 
@@ -240,9 +354,23 @@ input_file_give_next_buffer (char *where /* Where to place 1st character of new
      Since the assembler shouldn't do any output to stdout, we
      don't bother to synch output and input.  */
   if (preprocess)
-    size = do_scrub_chars (input_file_get, where, BUFFER_SIZE);
+    {
+      long start = 0, start_read = read_time;
+
+      if (flag_print_statistics)
+	start = get_run_time ();
+      size = do_scrub_chars (input_file_get, where, BUFFER_SIZE);
+      if (flag_print_statistics)
+	scrub_time += (get_run_time () - start) - (read_time - start_read);
+    }
   else
-    size = input_file_get (where, BUFFER_SIZE);
+    {
+      char *buf = where;
+
+      size = input_file_get (&buf, BUFFER_SIZE);
+      if (buf != where)
+	memcpy (where, buf, size);
+    }
 
   if (size)
     return_value = where + size;
@@ -252,8 +380,20 @@ input_file_give_next_buffer (char *where /* Where to place 1st character of new
 	as_warn (_("can't close %s: %s"), file_name, xstrerror (errno));
 
       f_in = (FILE *) 0;
+#ifdef USE_MMAP
+      input_file_unmap ();
+#endif
       return_value = 0;
     }
 
   return return_value;
 }
+
+/* Return the time spent reading and scrubbing input so far.  */
+
+void
+input_file_times (long *read_timep, long *scrub_timep)
+{
+  *read_timep = read_time;
+  *scrub_timep = scrub_time;
+}
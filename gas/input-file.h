@@ -63,3 +63,4 @@ void input_file_close (void);
 void input_file_end (void);
 void input_file_open (const char *filename, int pre);
 void input_file_pop (char *arg);
+void input_file_times (long *read_timep, long *scrub_timep);
@@ -0,0 +1,13 @@
+#NO_APP
+	.data
+	.byte 1
+#APP
+/* Compiler output, with inline assembly that needs scrubbing
+   and no newline at the end of the file.  */
+  .byte   2 ,  /* scrubbed */  3
+#NO_APP
+	.byte 4
+#APP
+	.byte	5
+#NO_APP
+	.byte 6
\ No newline at end of file
@@ -0,0 +1,26 @@
+	.text
+	# Each jump is just in range of its target while the next jump
+	# is short, so the long form of the last jump pushes them out of
+	# range one at a time, last to first.
+	jmp	.L1
+	.fill 125, 1, 0x90
+	jmp	.L2
+.L1:
+	.fill 125, 1, 0x90
+	jmp	.L3
+.L2:
+	.fill 125, 1, 0x90
+	jmp	.L4
+.L3:
+	.fill 125, 1, 0x90
+	jmp	.L5
+.L4:
+	.fill 125, 1, 0x90
+	jmp	.L6
+.L5:
+	.fill 200, 1, 0x90
+.L6:
+	.p2align 4, 0x90
+	# A backward jump to the start of the chain.
+	jne	.L1
+	nop
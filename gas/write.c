@@ -102,6 +102,20 @@
 #define TC_FX_SIZE_SLACK(FIX) 0
 #endif
 
+/* Nonzero if the size chosen for the rs_machine_dependent frag FRAG
+   depends only on its own address, its subtype and the value of its
+   fr_symbol, so that relax_segment may relax it incrementally.  This
+   is true of the generic relax_frag.  */
+#ifndef TC_RELAX_FRAG_LOCAL_P
+#if defined (TC_GENERIC_RELAX_TABLE) && !defined (md_relax_frag) \
+    && !defined (md_generic_table_relax_frag) \
+    && !defined (md_prepare_relax_scan) && !defined (TC_PCREL_ADJUST)
+#define TC_RELAX_FRAG_LOCAL_P(FRAG) 1
+#else
+#define TC_RELAX_FRAG_LOCAL_P(FRAG) 0
+#endif
+#endif
+
 /* Used to control final evaluation of expressions.  */
 int finalize_syms = 0;
 
@@ -1413,7 +1427,7 @@ write_relocs (bfd *abfd ATTRIBUTE_UNUSED, asection *sec,
 }
 
 static int
-compress_frag (struct z_stream_s *strm, const char *contents, int in_size,
+compress_frag (bool use_zstd, void *ctx, const char *contents, int in_size,
 	       fragS **last_newf, struct obstack *ob)
 {
   int out_size;
@@ -1442,7 +1456,7 @@ compress_frag (struct z_stream_s *strm, const char *contents, int in_size,
 	as_fatal (_("can't extend frag"));
       next_out = obstack_next_free (ob);
       obstack_blank_fast (ob, avail_out);
-      out_size = compress_data (strm, &contents, &in_size,
+      out_size = compress_data (use_zstd, ctx, &contents, &in_size,
 				&next_out, &avail_out);
       if (out_size < 0)
         return -1;
@@ -1471,10 +1485,11 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
   const char *section_name;
   char *compressed_name;
   char *header;
-  struct z_stream_s *strm;
+  void *ctx;
   int x;
   flagword flags = bfd_section_flags (sec);
   unsigned int header_size, compression_header_size;
+  bool use_zstd = flag_compress_debug == COMPRESS_DEBUG_ZSTD;
 
   if (seginfo == NULL
       || sec->size < 32
@@ -1485,11 +1500,11 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
   if (!startswith (section_name, ".debug_"))
     return;
 
-  strm = compress_init ();
-  if (strm == NULL)
+  ctx = compress_init (use_zstd);
+  if (ctx == NULL)
     return;
 
-  if (flag_compress_debug == COMPRESS_DEBUG_GABI_ZLIB)
+  if (flag_compress_debug != COMPRESS_DEBUG_GNU_ZLIB)
     {
       compression_header_size
 	= bfd_get_compression_header_size (stdoutput, NULL);
@@ -1531,7 +1546,7 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
       gas_assert (f->fr_type == rs_fill);
       if (f->fr_fix)
 	{
-	  out_size = compress_frag (strm, f->fr_literal, f->fr_fix,
+	  out_size = compress_frag (use_zstd, ctx, f->fr_literal, f->fr_fix,
 				    &last_newf, ob);
 	  if (out_size < 0)
 	    return;
@@ -1545,8 +1560,8 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
 	{
 	  while (count--)
 	    {
-	      out_size = compress_frag (strm, fill_literal, (int) fill_size,
-				        &last_newf, ob);
+	      out_size = compress_frag (use_zstd, ctx, fill_literal,
+					(int) fill_size, &last_newf, ob);
 	      if (out_size < 0)
 		return;
 	      compressed_size += out_size;
@@ -1579,7 +1594,7 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
 	as_fatal (_("can't extend frag"));
       next_out = obstack_next_free (ob);
       obstack_blank_fast (ob, avail_out);
-      x = compress_finish (strm, &next_out, &avail_out, &out_size);
+      x = compress_finish (use_zstd, ctx, &next_out, &avail_out, &out_size);
       if (x < 0)
 	return;
 
@@ -2540,6 +2555,9 @@ write_object_file (void)
     {
       if (flag_compress_debug == COMPRESS_DEBUG_GABI_ZLIB)
 	stdoutput->flags |= BFD_COMPRESS | BFD_COMPRESS_GABI;
+      else if (flag_compress_debug == COMPRESS_DEBUG_ZSTD)
+	stdoutput->flags |= (BFD_COMPRESS | BFD_COMPRESS_GABI
+			     | BFD_COMPRESS_ZSTD);
       else
 	stdoutput->flags |= BFD_COMPRESS;
       bfd_map_over_sections (stdoutput, compress_debug, (char *) 0);
@@ -2682,6 +2700,426 @@ relax_align (relax_addressT address,	/* Address now.  */
   return (new_address - address);
 }
 
+/* Relaxing a segment a full pass at a time costs the number of frags
+   times the number of passes, and chains of branches that push each
+   other out of range can take many passes to settle.  When the size of
+   every frag in a segment depends only on its own address or on the
+   distance to the frag holding its fr_symbol, a pass need only revisit
+   the frags that might change.  The frag sizes are kept in a Fenwick
+   tree, so the address a frag would have at any point of a full pass
+   is found without updating the frags before it, and fr_address is
+   only set for every frag once relaxation is done.  Frags are
+   revisited in order and see the same addresses and STRETCH as in a
+   full pass, so the result is the same.  */
+
+/* A frag relaxed against a symbol in the same segment.  It can only
+   change size when one of the frags from LO to HI inclusive does.  */
+
+struct relax_span
+{
+  size_t lo;
+  size_t hi;
+  size_t frag;
+};
+
+struct relax_state
+{
+  /* The frags of the segment, in order.  */
+  fragS **frags;
+  size_t count;
+
+  /* Fenwick tree of the frag sizes, indexed from 1.  */
+  offsetT *size_tree;
+
+  /* The frags whose size depends on their own address, in order, and
+     their address when last relaxed.  */
+  size_t *anchors;
+  addressT *anchor_address;
+  size_t anchor_count;
+
+  /* The frags relaxed against a symbol in the segment sorted by LO,
+     and a tree holding one more than the largest HI of each range of
+     them.  SPAN_LEAVES is the number of leaves of the tree.  */
+  struct relax_span *spans;
+  size_t span_count;
+  size_t *span_max;
+  size_t span_leaves;
+
+  /* Nonzero for the frags to be relaxed again.  */
+  char *dirty;
+};
+
+/* Return the address of frag I, the sum of the sizes before it.  */
+
+static addressT
+relax_address (const struct relax_state *rs, size_t i)
+{
+  offsetT address = 0;
+
+  for (; i > 0; i -= i & -i)
+    address += rs->size_tree[i];
+  return address;
+}
+
+/* Change the size of frag I by GROWTH.  */
+
+static void
+relax_grow (struct relax_state *rs, size_t i, offsetT growth)
+{
+  for (i++; i <= rs->count; i += i & -i)
+    rs->size_tree[i] += growth;
+}
+
+/* Return the index in RS->anchors of the first anchor after frag I.  */
+
+static size_t
+relax_next_anchor (const struct relax_state *rs, size_t i)
+{
+  size_t lo = 0, hi = rs->anchor_count;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (rs->anchors[mid] <= i)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return lo;
+}
+
+/* Mark the first anchor after frag I to be relaxed again, as its
+   address has changed.  */
+
+static void
+relax_mark_next_anchor (struct relax_state *rs, size_t i)
+{
+  size_t a = relax_next_anchor (rs, i);
+
+  if (a < rs->anchor_count)
+    rs->dirty[rs->anchors[a]] = 1;
+}
+
+/* Mark the spans in the subtree NODE, which covers WIDTH spans from
+   FIRST, that contain frag I.  Only the first LIMIT spans start at or
+   before I.  */
+
+static void
+relax_mark_spans (struct relax_state *rs, size_t node, size_t first,
+		  size_t width, size_t limit, size_t i)
+{
+  if (first >= limit || rs->span_max[node] <= i)
+    return;
+
+  if (width == 1)
+    {
+      rs->dirty[rs->spans[first].frag] = 1;
+      return;
+    }
+
+  width /= 2;
+  relax_mark_spans (rs, 2 * node, first, width, limit, i);
+  relax_mark_spans (rs, 2 * node + 1, first + width, width, limit, i);
+}
+
+/* Mark the frags to be relaxed again after frag I changes size.  */
+
+static void
+relax_mark_growth (struct relax_state *rs, size_t i)
+{
+  size_t lo = 0, hi = rs->span_count;
+
+  /* Find the spans that start at or before I.  */
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (rs->spans[mid].lo <= i)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  if (lo != 0)
+    relax_mark_spans (rs, 1, 0, rs->span_leaves, lo, i);
+
+  relax_mark_next_anchor (rs, i);
+  rs->dirty[i] = 1;
+}
+
+static int
+relax_span_compare (const void *a, const void *b)
+{
+  const struct relax_span *sa = (const struct relax_span *) a;
+  const struct relax_span *sb = (const struct relax_span *) b;
+
+  if (sa->lo != sb->lo)
+    return sa->lo < sb->lo ? -1 : 1;
+  if (sa->frag != sb->frag)
+    return sa->frag < sb->frag ? -1 : 1;
+  return 0;
+}
+
+/* Set up RS to relax the COUNT frags from ROOT in SEGMENT, whose end
+   is at address END, incrementally.  Return FALSE, leaving nothing to
+   free, if some frag does not allow it.  */
+
+static bool
+relax_incremental_init (struct relax_state *rs, fragS *root, size_t count,
+			addressT end, segT segment)
+{
+  fragS *fragP;
+  size_t i;
+
+  memset (rs, 0, sizeof (*rs));
+  if (count == 0 || count != (unsigned int) count)
+    return false;
+
+  for (i = 0, fragP = root; fragP; fragP = fragP->fr_next, i++)
+    {
+      if (i == count || fragP->relax_index != i)
+	return false;
+
+      switch (fragP->fr_type)
+	{
+	case rs_fill:
+	  break;
+
+	case rs_align:
+	case rs_align_code:
+	case rs_align_test:
+	  rs->anchor_count++;
+	  break;
+
+	case rs_machine_dependent:
+	  if (!TC_RELAX_FRAG_LOCAL_P (fragP)
+	      || (fragP->fr_symbol != NULL
+		  && !symbol_constant_p (fragP->fr_symbol)))
+	    return false;
+	  if (fragP->fr_symbol != NULL
+	      && S_GET_SEGMENT (fragP->fr_symbol) == segment)
+	    rs->span_count++;
+	  else
+	    rs->anchor_count++;
+	  break;
+
+	default:
+	  return false;
+	}
+    }
+  if (i != count)
+    return false;
+
+  rs->count = count;
+  rs->frags = XNEWVEC (fragS *, count);
+  for (i = 0, fragP = root; fragP; fragP = fragP->fr_next, i++)
+    rs->frags[i] = fragP;
+
+  rs->spans = XNEWVEC (struct relax_span, rs->span_count);
+  rs->anchors = XNEWVEC (size_t, rs->anchor_count);
+  rs->anchor_address = XNEWVEC (addressT, rs->anchor_count);
+  rs->span_count = 0;
+  rs->anchor_count = 0;
+  for (i = 0; i < count; i++)
+    {
+      fragP = rs->frags[i];
+      if (fragP->fr_type == rs_fill)
+	continue;
+
+      if (fragP->fr_type == rs_machine_dependent
+	  && fragP->fr_symbol != NULL
+	  && S_GET_SEGMENT (fragP->fr_symbol) == segment)
+	{
+	  fragS *sym_frag = symbol_get_frag (fragP->fr_symbol);
+	  size_t s = sym_frag->relax_index;
+	  struct relax_span *span = &rs->spans[rs->span_count++];
+
+	  if (s >= count || rs->frags[s] != sym_frag)
+	    {
+	      free (rs->frags);
+	      free (rs->spans);
+	      free (rs->anchors);
+	      free (rs->anchor_address);
+	      return false;
+	    }
+	  span->lo = s < i ? s : i;
+	  span->hi = s < i ? i : s;
+	  span->frag = i;
+	}
+      else
+	{
+	  rs->anchors[rs->anchor_count] = i;
+	  rs->anchor_address[rs->anchor_count++] = fragP->fr_address;
+	}
+    }
+
+  qsort (rs->spans, rs->span_count, sizeof (*rs->spans), relax_span_compare);
+  for (rs->span_leaves = 1;
+       rs->span_leaves < rs->span_count;
+       rs->span_leaves *= 2)
+    ;
+  rs->span_max = XCNEWVEC (size_t, 2 * rs->span_leaves);
+  for (i = 0; i < rs->span_count; i++)
+    rs->span_max[rs->span_leaves + i] = rs->spans[i].hi + 1;
+  for (i = rs->span_leaves - 1; i > 0; i--)
+    rs->span_max[i] = (rs->span_max[2 * i] > rs->span_max[2 * i + 1]
+		       ? rs->span_max[2 * i] : rs->span_max[2 * i + 1]);
+
+  rs->size_tree = XNEWVEC (offsetT, count + 1);
+  for (i = 1; i <= count; i++)
+    rs->size_tree[i] = ((i < count ? rs->frags[i]->fr_address : end)
+			- rs->frags[i - 1]->fr_address);
+  for (i = 1; i <= count; i++)
+    if (i + (i & -i) <= count)
+      rs->size_tree[i + (i & -i)] += rs->size_tree[i];
+
+  /* The first pass visits every frag.  */
+  rs->dirty = XNEWVEC (char, count);
+  memset (rs->dirty, 1, count);
+  return true;
+}
+
+/* Relax the frags of RS marked dirty in SEGMENT, in order, as one pass
+   of relax_segment.  Return nonzero if any of them changed size.  */
+
+static int
+relax_incremental_pass (struct relax_state *rs, segT segment)
+{
+  offsetT stretch = 0;
+  int stretched = 0;
+  size_t i = 0;
+  char *p;
+
+  while ((p = memchr (rs->dirty + i, 1, rs->count - i)) != NULL)
+    {
+      fragS *fragP;
+      addressT address, was_address = 0;
+      offsetT growth = 0;
+      bool anchor = true;
+      size_t a = 0;
+
+      i = p - rs->dirty;
+      rs->dirty[i] = 0;
+      fragP = rs->frags[i];
+      address = relax_address (rs, i);
+
+      switch (fragP->fr_type)
+	{
+	case rs_fill:
+	  anchor = false;
+	  break;
+
+	case rs_align:
+	case rs_align_code:
+	case rs_align_test:
+	  {
+	    addressT oldoff, newoff;
+
+	    a = relax_next_anchor (rs, i) - 1;
+	    was_address = rs->anchor_address[a];
+	    oldoff = relax_align (was_address + fragP->fr_fix,
+				  (int) fragP->fr_offset);
+	    newoff = relax_align (address + fragP->fr_fix,
+				  (int) fragP->fr_offset);
+
+	    if (fragP->fr_subtype != 0)
+	      {
+		if (oldoff > fragP->fr_subtype)
+		  oldoff = 0;
+		if (newoff > fragP->fr_subtype)
+		  newoff = 0;
+	      }
+
+	    growth = newoff - oldoff;
+	  }
+	  break;
+
+	case rs_machine_dependent:
+	  fragP->fr_address = address;
+	  fragP->relax_marker = 1;
+	  if (fragP->fr_symbol != NULL
+	      && S_GET_SEGMENT (fragP->fr_symbol) == segment)
+	    {
+	      fragS *sym_frag = symbol_get_frag (fragP->fr_symbol);
+	      size_t s = sym_frag->relax_index;
+
+	      /* A full pass would not have reached SYM_FRAG yet if it
+		 comes after this frag, and relax_frag may then guess
+		 its address from STRETCH.  Relax this frag again next
+		 pass with the true address.  */
+	      anchor = false;
+	      if (s > i)
+		{
+		  sym_frag->fr_address = relax_address (rs, s) - stretch;
+		  sym_frag->relax_marker = 0;
+		  if (stretch != 0)
+		    rs->dirty[i] = 1;
+		}
+	      else
+		{
+		  sym_frag->fr_address = relax_address (rs, s);
+		  sym_frag->relax_marker = 1;
+		}
+	    }
+
+#ifdef md_relax_frag
+	  growth = md_relax_frag (segment, fragP, stretch);
+#else
+#ifdef TC_GENERIC_RELAX_TABLE
+	  growth = md_generic_table_relax_frag (segment, fragP, stretch);
+#endif
+#endif
+	  if (anchor)
+	    {
+	      a = relax_next_anchor (rs, i) - 1;
+	      was_address = rs->anchor_address[a];
+	    }
+	  break;
+
+	default:
+	  BAD_CASE (fragP->fr_type);
+	  break;
+	}
+
+      /* The address of the next anchor changes if this one moved
+	 without its size absorbing the move.  */
+      if (anchor)
+	{
+	  rs->anchor_address[a] = address;
+	  if (address - was_address + growth != 0)
+	    relax_mark_next_anchor (rs, i);
+	}
+
+      if (growth)
+	{
+	  relax_grow (rs, i, growth);
+	  relax_mark_growth (rs, i);
+	  stretch += growth;
+	  stretched = 1;
+	}
+      i++;
+    }
+
+  return stretched;
+}
+
+/* Set the final frag addresses from RS and free it.  */
+
+static void
+relax_incremental_finish (struct relax_state *rs)
+{
+  size_t i;
+
+  for (i = 0; i < rs->count; i++)
+    rs->frags[i]->fr_address = relax_address (rs, i);
+
+  free (rs->frags);
+  free (rs->size_tree);
+  free (rs->anchors);
+  free (rs->anchor_address);
+  free (rs->spans);
+  free (rs->span_max);
+  free (rs->dirty);
+}
+
 /* Now we have a segment, not a crowd of sub-segments, we can make
    fr_address values.
 
@@ -2700,6 +3138,8 @@ relax_segment (struct frag *segment_frag_root, segT segment, int pass)
   relax_addressT address;
   int region;
   int ret;
+  struct relax_state rs;
+  bool incremental;
 
   /* In case md_estimate_size_before_relax() wants to make fixSs.  */
   subseg_change (segment, 0);
@@ -2714,6 +3154,7 @@ relax_segment (struct frag *segment_frag_root, segT segment, int pass)
     {
       fragP->region = region;
       fragP->relax_marker = 0;
+      fragP->relax_index = frag_count;
       fragP->fr_address = address;
       address += fragP->fr_fix;
 
@@ -2844,12 +3285,21 @@ relax_segment (struct frag *segment_frag_root, segT segment, int pass)
     if (max_iterations < frag_count)
       max_iterations = frag_count;
 
+    incremental = relax_incremental_init (&rs, segment_frag_root,
+					  frag_count, address, segment);
+
     ret = 0;
     do
       {
 	stretch = 0;
 	stretched = 0;
 
+	if (incremental)
+	  {
+	    stretched = relax_incremental_pass (&rs, segment);
+	    continue;
+	  }
+
 	for (fragP = segment_frag_root; fragP; fragP = fragP->fr_next)
 	  {
 	    offsetT growth = 0;
@@ -3160,6 +3610,9 @@ relax_segment (struct frag *segment_frag_root, segT segment, int pass)
     /* Until nothing further to relax.  */
     while (stretched && -- max_iterations);
 
+    if (incremental)
+      relax_incremental_finish (&rs);
+
     if (stretched)
       as_fatal (_("Infinite loop encountered whilst attempting to compute the addresses of symbols in section %s"),
 		segment_name (segment));
@@ -212,4 +212,5 @@ m4_include([../config/override.m4])
 m4_include([../config/pkg.m4])
 m4_include([../config/plugins.m4])
 m4_include([../config/tcl.m4])
+m4_include([../config/zstd.m4])
 m4_include([acinclude.m4])
@@ -24,6 +24,9 @@
 #include "bcache.h"
 
 #include <algorithm>
+#if CXX_STD_THREAD
+#include <mutex>
+#endif
 
 namespace gdb {
 
@@ -388,4 +391,315 @@ bcache::memory_used ()
   return obstack_memory_used (&m_cache);
 }
 
+
+
+/* The concurrent bcache.  */
+
+/* The type used to hold a single concurrent_bcache string.  The user
+   data is stored in d.data, aligned like that of a bstring.  */
+
+struct cbstring
+{
+  /* The full hash value of the data.  */
+  unsigned long hash;
+  int length;
+
+  union
+  {
+    char data[1];
+    double dummy;
+  }
+  d;
+};
+
+/* The number of bytes needed to allocate a struct cbstring whose data
+   is N bytes long.  */
+#define CBSTRING_SIZE(n) (offsetof (struct cbstring, d.data) + (n))
+
+/* The number of stripes in a concurrent_bcache.  This is a power of
+   two, so that the stripe and the slot within it can be taken from
+   different bits of the hash value.  */
+#define CONCURRENT_BCACHE_STRIPES 64
+
+/* The initial size of the hash table of a stripe.  This is a power of
+   two, as are all the sizes it is grown to.  */
+#define CONCURRENT_BCACHE_INITIAL_SIZE 64
+
+/* One stripe of a concurrent_bcache.  Everything here is guarded by
+   LOCK.  */
+
+struct concurrent_bcache::stripe
+{
+#if CXX_STD_THREAD
+  std::mutex lock;
+#endif
+
+  /* All the cbstrings of this stripe are allocated here.  */
+  struct obstack cache {};
+
+  /* The open-addressed hash table, searched by linear probing.  Empty
+     slots are null.  */
+  struct cbstring **table = nullptr;
+  size_t table_size = 0;
+
+  /* Statistics, as for bcache.  */
+  unsigned long unique_count = 0;
+  long total_count = 0;
+  long unique_size = 0;
+  long total_size = 0;
+  long structure_size = 0;
+  unsigned long expand_count = 0;
+  /* The number of occupied slots looked at while searching.  */
+  unsigned long probe_count = 0;
+
+  /* Return the slot of TABLE, of size SIZE, where the search for a
+     string with hash value HASH starts.  */
+  static size_t home_slot (unsigned long hash, size_t size)
+  {
+    return (hash / CONCURRENT_BCACHE_STRIPES) & (size - 1);
+  }
+
+  /* Grow the hash table so that it is at most three quarters full
+     once one more string has been added.  */
+  void maybe_expand ();
+};
+
+void
+concurrent_bcache::stripe::maybe_expand ()
+{
+  if ((unique_count + 1) * 4 <= table_size * 3)
+    return;
+
+  size_t new_size = (table_size == 0
+		     ? CONCURRENT_BCACHE_INITIAL_SIZE
+		     : table_size * 2);
+  struct cbstring **new_table = XCNEWVEC (struct cbstring *, new_size);
+
+  if (table_size != 0)
+    expand_count++;
+  structure_size -= table_size * sizeof (table[0]);
+  structure_size += new_size * sizeof (new_table[0]);
+
+  /* Re-enter the existing strings, using the hash value they
+     record.  */
+  for (size_t i = 0; i < table_size; i++)
+    if (table[i] != nullptr)
+      {
+	size_t j = home_slot (table[i]->hash, new_size);
+
+	while (new_table[j] != nullptr)
+	  j = (j + 1) & (new_size - 1);
+	new_table[j] = table[i];
+      }
+
+  xfree (table);
+  table = new_table;
+  table_size = new_size;
+}
+
+concurrent_bcache::concurrent_bcache ()
+  : m_stripes (new stripe[CONCURRENT_BCACHE_STRIPES])
+{
+}
+
+concurrent_bcache::~concurrent_bcache ()
+{
+  for (int i = 0; i < CONCURRENT_BCACHE_STRIPES; i++)
+    {
+      stripe &s = m_stripes[i];
+
+      /* Only free the obstack if we actually initialized it.  */
+      if (s.total_count > 0)
+	obstack_free (&s.cache, 0);
+      xfree (s.table);
+    }
+  delete[] m_stripes;
+}
+
+/* See bcache.h.  */
+
+const void *
+concurrent_bcache::insert (const void *addr, int length, bool *added)
+{
+  unsigned long full_hash = fast_hash (addr, length, 0);
+  stripe &s = m_stripes[full_hash % CONCURRENT_BCACHE_STRIPES];
+
+  if (added != nullptr)
+    *added = false;
+
+#if CXX_STD_THREAD
+  std::lock_guard<std::mutex> guard (s.lock);
+#endif
+
+  /* Lazily initialize the obstack, as bcache does.  */
+  if (s.total_count == 0)
+    obstack_init (&s.cache);
+
+  s.maybe_expand ();
+
+  s.total_count++;
+  s.total_size += length;
+
+  size_t mask = s.table_size - 1;
+  size_t i;
+  for (i = stripe::home_slot (full_hash, s.table_size);
+       s.table[i] != nullptr;
+       i = (i + 1) & mask)
+    {
+      struct cbstring *str = s.table[i];
+
+      s.probe_count++;
+      if (str->hash == full_hash
+	  && str->length == length
+	  && memcmp (&str->d.data, addr, length) == 0)
+	return &str->d.data;
+    }
+
+  /* The user's string isn't in the table.  Enter it in the empty slot
+     where the search stopped.  */
+  struct cbstring *newobj
+    = (struct cbstring *) obstack_alloc (&s.cache, CBSTRING_SIZE (length));
+
+  memcpy (&newobj->d.data, addr, length);
+  newobj->hash = full_hash;
+  newobj->length = length;
+  s.table[i] = newobj;
+
+  s.unique_count++;
+  s.unique_size += length;
+  s.structure_size += CBSTRING_SIZE (length);
+
+  if (added != nullptr)
+    *added = true;
+
+  return &newobj->d.data;
+}
+
+/* See bcache.h.  */
+
+void
+concurrent_bcache::print_statistics (const char *type)
+{
+  unsigned long unique_count = 0;
+  long total_count = 0;
+  long unique_size = 0;
+  long total_size = 0;
+  long structure_size = 0;
+  unsigned long expand_count = 0;
+  unsigned long probe_count = 0;
+  unsigned long table_size = 0;
+  std::vector<int> entry_size;
+  std::vector<int> probe_length;
+
+  /* Add up the statistics of all the stripes, and collect the entry
+     sizes and the number of probes needed to find each entry.  */
+  for (int i = 0; i < CONCURRENT_BCACHE_STRIPES; i++)
+    {
+      stripe &s = m_stripes[i];
+#if CXX_STD_THREAD
+      std::lock_guard<std::mutex> guard (s.lock);
+#endif
+
+      unique_count += s.unique_count;
+      total_count += s.total_count;
+      unique_size += s.unique_size;
+      total_size += s.total_size;
+      structure_size += s.structure_size;
+      expand_count += s.expand_count;
+      probe_count += s.probe_count;
+      table_size += s.table_size;
+
+      for (size_t j = 0; j < s.table_size; j++)
+	if (s.table[j] != nullptr)
+	  {
+	    size_t home = stripe::home_slot (s.table[j]->hash, s.table_size);
+
+	    entry_size.push_back (s.table[j]->length);
+	    probe_length.push_back (((j - home) & (s.table_size - 1)) + 1);
+	  }
+    }
+
+  std::sort (entry_size.begin (), entry_size.end ());
+  std::sort (probe_length.begin (), probe_length.end ());
+
+  int max_entry_size = entry_size.empty () ? 0 : entry_size.back ();
+  int median_entry_size
+    = entry_size.empty () ? 0 : entry_size[entry_size.size () / 2];
+  int max_probe_length = probe_length.empty () ? 0 : probe_length.back ();
+  int median_probe_length
+    = probe_length.empty () ? 0 : probe_length[probe_length.size () / 2];
+
+  gdb_printf (_("  Concurrently cached '%s' statistics:\n"), type);
+  gdb_printf (_("    Total object count:  %ld\n"), total_count);
+  gdb_printf (_("    Unique object count: %lu\n"), unique_count);
+  gdb_printf (_("    Percentage of duplicates, by count: "));
+  print_percentage (total_count - unique_count, total_count);
+  gdb_printf ("\n");
+
+  gdb_printf (_("    Total object size:   %ld\n"), total_size);
+  gdb_printf (_("    Unique object size:  %ld\n"), unique_size);
+  gdb_printf (_("    Percentage of duplicates, by size:  "));
+  print_percentage (total_size - unique_size, total_size);
+  gdb_printf ("\n");
+
+  gdb_printf (_("    Max entry size:     %d\n"), max_entry_size);
+  gdb_printf (_("    Average entry size: "));
+  if (unique_count > 0)
+    gdb_printf ("%ld\n", unique_size / unique_count);
+  else
+    /* i18n: "Average entry size: (not applicable)".  */
+    gdb_printf (_("(not applicable)\n"));
+  gdb_printf (_("    Median entry size:  %d\n"), median_entry_size);
+  gdb_printf ("\n");
+
+  gdb_printf (_("    \
+Total memory used by bcache, including overhead: %ld\n"),
+	      structure_size);
+  gdb_printf (_("    Percentage memory overhead: "));
+  print_percentage (structure_size - unique_size, unique_size);
+  gdb_printf (_("    Net memory savings:         "));
+  print_percentage (total_size - structure_size, total_size);
+  gdb_printf ("\n");
+
+  gdb_printf (_("    Hash table stripes:        %3d\n"),
+	      CONCURRENT_BCACHE_STRIPES);
+  gdb_printf (_("    Hash table size:           %3lu\n"), table_size);
+  gdb_printf (_("    Hash table expands:        %lu\n"), expand_count);
+  gdb_printf (_("    Hash table hashes:         %ld\n"), total_count);
+  gdb_printf (_("    Hash table population:     "));
+  print_percentage (unique_count, table_size);
+  gdb_printf (_("    Median probe length:       %3d\n"),
+	      median_probe_length);
+  gdb_printf (_("    Average probe length:      "));
+  if (total_count > 0)
+    gdb_printf ("%3lu\n", probe_count / total_count);
+  else
+    /* i18n: "Average probe length: (not applicable)".  */
+    gdb_printf (_("(not applicable)\n"));
+  gdb_printf (_("    Maximum probe length:      %3d\n"),
+	      max_probe_length);
+  gdb_printf ("\n");
+}
+
+/* See bcache.h.  */
+
+int
+concurrent_bcache::memory_used ()
+{
+  int result = 0;
+
+  for (int i = 0; i < CONCURRENT_BCACHE_STRIPES; i++)
+    {
+      stripe &s = m_stripes[i];
+#if CXX_STD_THREAD
+      std::lock_guard<std::mutex> guard (s.lock);
+#endif
+
+      if (s.total_count > 0)
+	result += obstack_memory_used (&s.cache);
+    }
+
+  return result;
+}
+
 } /* namespace gdb */
@@ -205,6 +205,51 @@ struct bcache
   void expand_hash_table ();
 };
 
+/* A variant of bcache that may be used from several threads at once,
+   for instance from the tasks of gdb::parallel_for_each.
+
+   The strings are spread over a fixed number of stripes by their hash
+   value.  Each stripe has its own lock, its own open-addressed hash
+   table, and its own obstack holding the strings, so two threads only
+   wait for each other when they insert strings that land in the same
+   stripe.  Each table slot points to a string that records its full
+   hash value, which is checked before the length and data are
+   compared, and which lets the table grow without hashing the strings
+   again.
+
+   Unlike bcache, the hash and compare functions cannot be
+   overridden.  */
+
+struct concurrent_bcache
+{
+  concurrent_bcache ();
+  ~concurrent_bcache ();
+  DISABLE_COPY_AND_ASSIGN (concurrent_bcache);
+
+  /* Like bcache::insert.  This may be called from any thread.  */
+
+  const void *insert (const void *addr, int length, bool *added = nullptr);
+
+  /* Insert the null-terminated string STR, and return the cached
+     copy.  */
+
+  const char *insert (const char *str)
+  {
+    return (const char *) insert (str, strlen (str) + 1);
+  }
+
+  /* Like the bcache methods of the same name.  */
+  void print_statistics (const char *type);
+  int memory_used ();
+
+private:
+
+  struct stripe;
+
+  /* The stripes, of which there are a fixed number.  */
+  stripe *m_stripes;
+};
+
 } /* namespace gdb */
 
 #endif /* BCACHE_H */
@@ -78,6 +78,7 @@
 #include "mi/mi-common.h"
 #include "extension.h"
 #include <algorithm>
+#include <unordered_set>
 #include "progspace-and-thread.h"
 #include "gdbsupport/array-view.h"
 #include "gdbsupport/gdb_optional.h"
@@ -12753,22 +12754,173 @@ decode_location_spec_default (struct breakpoint *b,
   return {};
 }
 
-/* Reset a breakpoint.  */
+/* True if breakpoint_re_set_new_objfiles may limit the re-set to the
+   objfiles added since the previous re-set.  */
+
+static bool incremental_breakpoint_re_set = true;
+
+/* Implement the "maint show incremental-breakpoint-re-set" command.  */
+
+static void
+show_incremental_breakpoint_re_set (struct ui_file *file, int from_tty,
+				    struct cmd_list_element *c,
+				    const char *value)
+{
+  gdb_printf (file, _("Incremental breakpoint re-set is %s.\n"), value);
+}
+
+/* Counters reported by "maint print breakpoint-re-set-statistics".  */
+
+struct breakpoint_re_set_stats
+{
+  /* Number of re-sets that re-resolved every breakpoint.  */
+  unsigned int full = 0;
+
+  /* Number of re-sets that only considered new objfiles.  */
+  unsigned int incremental = 0;
+
+  /* During incremental re-sets, the number of breakpoints that were
+     re-resolved, and the number that were left untouched because the
+     new objfiles could not contribute any location to them.  */
+  unsigned int breakpoints_re_set = 0;
+  unsigned int breakpoints_skipped = 0;
+};
+
+static breakpoint_re_set_stats bp_re_set_stats;
+
+/* Per-program-space state used to decide whether a breakpoint re-set
+   can be limited to the objfiles added since the previous one.  */
+
+struct breakpoint_re_set_pspace_info
+{
+  /* The objfiles the breakpoints of the program space were last
+     re-set against.  */
+  std::unordered_set<objfile *> known_objfiles;
+
+  /* True if something other than adding objfiles happened since the
+     last re-set, e.g. an objfile was freed or the symbol tables were
+     invalidated, so that only a full re-set gives correct results.  */
+  bool need_full_re_set = true;
+};
+
+/* Per-program-space data key.  */
+
+static const struct program_space_key<breakpoint_re_set_pspace_info>
+  breakpoint_re_set_pspace_data;
+
+/* Get the breakpoint re-set state of PSPACE, creating it if
+   necessary.  */
+
+static breakpoint_re_set_pspace_info *
+get_breakpoint_re_set_pspace_info (struct program_space *pspace)
+{
+  breakpoint_re_set_pspace_info *info
+    = breakpoint_re_set_pspace_data.get (pspace);
+  if (info == nullptr)
+    info = breakpoint_re_set_pspace_data.emplace (pspace);
+  return info;
+}
+
+/* This module's 'new_objfile' observer.  A NULL OBJFILE means the
+   symbol tables were invalidated.  New objfiles are found by
+   breakpoint_re_set_new_objfiles itself, because some callers re-set
+   breakpoints before the observer is notified.  */
+
+static void
+breakpoint_re_set_new_objfile (struct objfile *objfile)
+{
+  if (objfile == nullptr)
+    get_breakpoint_re_set_pspace_info (current_program_space)
+      ->need_full_re_set = true;
+}
+
+/* This module's 'free_objfile' observer.  */
+
+static void
+breakpoint_re_set_free_objfile (struct objfile *objfile)
+{
+  breakpoint_re_set_pspace_info *info
+    = breakpoint_re_set_pspace_data.get (objfile->pspace);
+
+  if (info != nullptr)
+    {
+      info->known_objfiles.erase (objfile);
+      info->need_full_re_set = true;
+    }
+}
+
+/* Return true if any of the objfiles in NEW_OBJFILES may change the
+   locations of breakpoint B, in which case B must be re-set.
+
+   For breakpoints set on a linespec or explicit location, adding an
+   objfile that contains no match for the location spec leaves the
+   result of a full re-set unchanged, so we look for matches in the
+   new objfiles only.  Any other kind of breakpoint is always re-set.  */
+
+static bool
+new_objfiles_affect_breakpoint_p
+  (breakpoint *b, const std::unordered_set<objfile *> &new_objfiles)
+{
+  if (b->number <= 0
+      || !(is_breakpoint (b)
+	   || b->type == bp_tracepoint
+	   || b->type == bp_fast_tracepoint)
+      || b->locspec == nullptr
+      || b->locspec_range_end != nullptr
+      || (b->locspec->type () != LINESPEC_LOCATION_SPEC
+	  && b->locspec->type () != EXPLICIT_LOCATION_SPEC))
+    return true;
+
+  /* A condition that failed to parse may become valid once new
+     symbols are available.  */
+  for (bp_location *loc : b->locations ())
+    if (loc->disabled_by_cond)
+      return true;
+
+  scoped_linespec_objfile_filter filter (new_objfiles);
+  try
+    {
+      std::vector<symtab_and_line> sals
+	= b->decode_location_spec (b->locspec.get (), current_program_space);
+      return !sals.empty ();
+    }
+  catch (const gdb_exception_error &e)
+    {
+      /* Any error other than not finding the location is left for the
+	 full re-set to report.  */
+      return e.error != NOT_FOUND_ERROR;
+    }
+}
+
+/* Reset a breakpoint.  If NEW_OBJFILES is not NULL, B is only re-set
+   if those objfiles may change its locations.  */
 
 static void
-breakpoint_re_set_one (breakpoint *b)
+breakpoint_re_set_one (breakpoint *b,
+		       const std::unordered_set<objfile *> *new_objfiles)
 {
   input_radix = b->input_radix;
   set_language (b->language);
 
+  if (new_objfiles != nullptr)
+    {
+      if (!new_objfiles_affect_breakpoint_p (b, *new_objfiles))
+	{
+	  bp_re_set_stats.breakpoints_skipped++;
+	  return;
+	}
+      bp_re_set_stats.breakpoints_re_set++;
+    }
+
   b->re_set ();
 }
 
-/* Re-set breakpoint locations for the current program space.
-   Locations bound to other program spaces are left untouched.  */
+/* Re-set breakpoint locations for the current program space.  If
+   NEW_OBJFILES is not NULL, only breakpoints whose locations may be
+   changed by those objfiles are re-set.  */
 
-void
-breakpoint_re_set (void)
+static void
+breakpoint_re_set_1 (const std::unordered_set<objfile *> *new_objfiles)
 {
   {
     scoped_restore_current_language save_language;
@@ -12797,7 +12949,7 @@ breakpoint_re_set (void)
       {
 	try
 	  {
-	    breakpoint_re_set_one (b);
+	    breakpoint_re_set_one (b, new_objfiles);
 	  }
 	catch (const gdb_exception &ex)
 	  {
@@ -12817,6 +12969,89 @@ breakpoint_re_set (void)
 
   /* Now we can insert.  */
   update_global_location_list (UGLL_MAY_INSERT);
+
+  /* Remember what the breakpoints were resolved against.  */
+  breakpoint_re_set_pspace_info *info
+    = get_breakpoint_re_set_pspace_info (current_program_space);
+  info->known_objfiles.clear ();
+  for (objfile *objfile : current_program_space->objfiles ())
+    info->known_objfiles.insert (objfile);
+  info->need_full_re_set = false;
+}
+
+/* Re-set breakpoint locations for the current program space.
+   Locations bound to other program spaces are left untouched.  */
+
+void
+breakpoint_re_set (void)
+{
+  bp_re_set_stats.full++;
+  breakpoint_re_set_1 (nullptr);
+}
+
+/* See breakpoint.h.  */
+
+void
+breakpoint_re_set_new_objfiles ()
+{
+  breakpoint_re_set_pspace_info *info
+    = get_breakpoint_re_set_pspace_info (current_program_space);
+
+  if (!incremental_breakpoint_re_set || info->need_full_re_set)
+    {
+      breakpoint_re_set ();
+      return;
+    }
+
+  std::unordered_set<objfile *> new_objfiles;
+  size_t n_objfiles = 0;
+  for (objfile *objfile : current_program_space->objfiles ())
+    {
+      n_objfiles++;
+      if (info->known_objfiles.count (objfile) == 0)
+	new_objfiles.insert (objfile);
+    }
+
+  for (objfile *objfile : new_objfiles)
+    {
+      /* A separate debug objfile added for an objfile we already know
+	 about can turn minimal symbol locations into full symbol
+	 locations, which only a full re-set handles.  */
+      struct objfile *parent = objfile->separate_debug_objfile_backlink;
+      if (parent != nullptr && new_objfiles.count (parent) == 0)
+	{
+	  breakpoint_re_set ();
+	  return;
+	}
+    }
+
+  /* When most objfiles are new, e.g. right after attaching, looking
+     for matches in the new objfiles costs about as much as a full
+     re-set.  */
+  if (new_objfiles.size () * 2 > n_objfiles)
+    {
+      breakpoint_re_set ();
+      return;
+    }
+
+  bp_re_set_stats.incremental++;
+  breakpoint_re_set_1 (&new_objfiles);
+}
+
+/* The "maint print breakpoint-re-set-statistics" command.  */
+
+static void
+maintenance_print_breakpoint_re_set_statistics (const char *args,
+						int from_tty)
+{
+  gdb_printf (_("Breakpoint re-set statistics:\n"));
+  gdb_printf (_("  full re-sets:          %u\n"), bp_re_set_stats.full);
+  gdb_printf (_("  incremental re-sets:   %u\n"),
+	      bp_re_set_stats.incremental);
+  gdb_printf (_("  breakpoints re-set:    %u\n"),
+	      bp_re_set_stats.breakpoints_re_set);
+  gdb_printf (_("  breakpoints skipped:   %u\n"),
+	      bp_re_set_stats.breakpoints_skipped);
 }
 
 /* Reset the thread number of this breakpoint:
@@ -14189,6 +14424,10 @@ _initialize_breakpoint ()
 				       "breakpoint");
   gdb::observers::memory_changed.attach (invalidate_bp_value_on_memory_change,
 					 "breakpoint");
+  gdb::observers::new_objfile.attach (breakpoint_re_set_new_objfile,
+				      "breakpoint");
+  gdb::observers::free_objfile.attach (breakpoint_re_set_free_objfile,
+				       "breakpoint-re-set");
 
   breakpoint_chain = 0;
   /* Don't bother to call set_breakpoint_count.  $bpnum isn't useful
@@ -14624,6 +14863,26 @@ a warning will be emitted for such breakpoints."),
 			   &breakpoint_set_cmdlist,
 			   &breakpoint_show_cmdlist);
 
+  add_setshow_boolean_cmd ("incremental-breakpoint-re-set",
+			   class_maintenance,
+			   &incremental_breakpoint_re_set, _("\
+Set whether breakpoints are re-set incrementally when objfiles are added."),
+			   _("\
+Show whether breakpoints are re-set incrementally when objfiles are added."),
+			   _("\
+If on (the default), loading new shared libraries or symbol files only\n\
+re-resolves the breakpoints that may have locations in the new objfiles.\n\
+If off, every breakpoint is re-resolved against every objfile."),
+			   NULL,
+			   show_incremental_breakpoint_re_set,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+
+  add_cmd ("breakpoint-re-set-statistics", class_maintenance,
+	   maintenance_print_breakpoint_re_set_statistics,
+	   _("Print statistics about full and incremental breakpoint re-sets."),
+	   &maintenanceprintlist);
+
   add_setshow_boolean_cmd ("always-inserted", class_support,
 			   &always_inserted_mode, _("\
 Set mode for inserting breakpoints."), _("\
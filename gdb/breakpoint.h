@@ -1392,6 +1392,13 @@ extern void update_breakpoint_locations
 
 extern void breakpoint_re_set (void);
 
+/* Like breakpoint_re_set, but called after objfiles were added to
+   the current program space.  When that is known to give the same
+   result, only the breakpoints that may have locations in the new
+   objfiles are re-set; otherwise, this does a full re-set.  */
+
+extern void breakpoint_re_set_new_objfiles ();
+
 extern void breakpoint_re_set_thread (struct breakpoint *);
 
 extern void delete_breakpoint (struct breakpoint *);
@@ -25,6 +25,7 @@
 #include "inferior.h"
 #include "splay-tree.h"
 #include "gdbarch.h"
+#include "perf-counters.h"
 
 /* Commands with a prefix of `{set,show} dcache'.  */
 static struct cmd_list_element *dcache_set_list = NULL;
@@ -132,6 +133,15 @@ static struct dcache_block *dcache_alloc (DCACHE *dcache, CORE_ADDR addr);
 
 static bool dcache_enabled_p = false; /* OBSOLETE */
 
+/* Performance counters for reads through the cache.  */
+
+static perf_counter dcache_hits
+  ("dcache.hits", N_("Data cache byte reads satisfied from the cache"));
+static perf_counter dcache_misses
+  ("dcache.misses", N_("Data cache byte reads that needed a line fill"));
+static perf_counter dcache_bytes_read
+  ("dcache.bytes-read", N_("Bytes read from the target to fill the cache"));
+
 static void
 show_dcache_enabled_p (struct ui_file *file, int from_tty,
 		       struct cmd_list_element *c, const char *value)
@@ -341,6 +351,7 @@ dcache_read_line (DCACHE *dcache, struct dcache_block *db)
       res = target_read_raw_memory (memaddr, myaddr, reg_len);
       if (res != 0)
 	return 0;
+      dcache_bytes_read.add (reg_len);
 
       memaddr += reg_len;
       myaddr += reg_len;
@@ -403,11 +414,14 @@ dcache_peek_byte (DCACHE *dcache, CORE_ADDR addr, gdb_byte *ptr)
 
   if (!db)
     {
+      dcache_misses.add ();
       db = dcache_alloc (dcache, addr);
 
       if (!dcache_read_line (dcache, db))
 	 return 0;
     }
+  else
+    dcache_hits.add ();
 
   *ptr = db->data[XFORM (dcache, addr)];
   return 1;
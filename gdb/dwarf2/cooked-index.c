@@ -115,8 +115,9 @@ cooked_index::add (sect_offset die_offset, enum dwarf_tag tag,
 /* See cooked-index.h.  */
 
 void
-cooked_index::finalize ()
+cooked_index::finalize (gdb::concurrent_bcache *names)
 {
+  m_names = names;
   m_future = gdb::thread_pool::g_thread_pool->post_task ([this] ()
     {
       do_finalize ();
@@ -125,13 +126,13 @@ cooked_index::finalize ()
 
 /* See cooked-index.h.  */
 
-gdb::unique_xmalloc_ptr<char>
+const char *
 cooked_index::handle_gnat_encoded_entry (cooked_index_entry *entry,
 					 htab_t gnat_entries)
 {
   std::string canonical = ada_decode (entry->name, false, false);
   if (canonical.empty ())
-    return {};
+    return nullptr;
   std::vector<gdb::string_view> names = split_name (canonical.c_str (),
 						    split_style::DOT);
   gdb::string_view tail = names.back ();
@@ -148,13 +149,11 @@ cooked_index::handle_gnat_encoded_entry (cooked_index_entry *entry,
       cooked_index_entry *last = (cooked_index_entry *) *slot;
       if (last == nullptr || last->per_cu != entry->per_cu)
 	{
-	  gdb::unique_xmalloc_ptr<char> new_name
-	    = make_unique_xstrndup (name.data (), name.length ());
+	  std::string new_name (name.data (), name.length ());
 	  last = create (entry->die_offset, DW_TAG_namespace,
-			 0, new_name.get (), parent,
+			 0, m_names->insert (new_name.c_str ()), parent,
 			 entry->per_cu);
 	  last->canonical = last->name;
-	  m_names.push_back (std::move (new_name));
 	  *slot = last;
 	}
 
@@ -162,7 +161,8 @@ cooked_index::handle_gnat_encoded_entry (cooked_index_entry *entry,
     }
 
   entry->parent_entry = parent;
-  return make_unique_xstrndup (tail.data (), tail.length ());
+  std::string tail_name (tail.data (), tail.length ());
+  return m_names->insert (tail_name.c_str ());
 }
 
 /* See cooked-index.h.  */
@@ -204,15 +204,12 @@ cooked_index::do_finalize ()
 	{
 	  if (entry->per_cu->lang () == language_ada)
 	    {
-	      gdb::unique_xmalloc_ptr<char> canon_name
+	      const char *canon_name
 		= handle_gnat_encoded_entry (entry, gnat_entries.get ());
 	      if (canon_name == nullptr)
 		entry->canonical = entry->name;
 	      else
-		{
-		  entry->canonical = canon_name.get ();
-		  m_names.push_back (std::move (canon_name));
-		}
+		entry->canonical = canon_name;
 	    }
 	  else
 	    {
@@ -225,10 +222,7 @@ cooked_index::do_finalize ()
 		  if (canon_name == nullptr)
 		    entry->canonical = entry->name;
 		  else
-		    {
-		      entry->canonical = canon_name.get ();
-		      m_names.push_back (std::move (canon_name));
-		    }
+		    entry->canonical = m_names->insert (canon_name.get ());
 		}
 	      else
 		{
@@ -240,7 +234,6 @@ cooked_index::do_finalize ()
 	}
     }
 
-  m_names.shrink_to_fit ();
   m_entries.shrink_to_fit ();
   std::sort (m_entries.begin (), m_entries.end (),
 	     [] (const cooked_index_entry *a, const cooked_index_entry *b)
@@ -285,7 +278,7 @@ cooked_index_vector::cooked_index_vector (vec_type &&vec)
   : m_vector (std::move (vec))
 {
   for (auto &idx : m_vector)
-    idx->finalize ();
+    idx->finalize (&m_names);
 }
 
 /* See cooked-index.h.  */
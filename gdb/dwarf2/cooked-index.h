@@ -29,6 +29,7 @@
 #include "quick-symbol.h"
 #include "gdbsupport/gdb_obstack.h"
 #include "addrmap.h"
+#include "bcache.h"
 #include "gdbsupport/iterator-range.h"
 #include "gdbsupport/thread-pool.h"
 #include "dwarf2/mapped-index.h"
@@ -193,8 +194,10 @@ class cooked_index
 
   /* Finalize the index.  This should be called a single time, when
      the index has been fully populated.  It enters all the entries
-     into the internal table.  */
-  void finalize ();
+     into the internal table.  The canonical names it computes are
+     interned in NAMES, which may be shared with other indexes that
+     are finalized at the same time, and must outlive this index.  */
+  void finalize (gdb::concurrent_bcache *names);
 
   /* Wait for this index's finalization to be complete.  */
   void wait ()
@@ -254,9 +257,10 @@ class cooked_index
      not emit the module structure.  However, we need this structure
      to do lookups.  This function recreates that structure for an
      existing entry.  It returns the base name (last element) of the
-     full decoded name.  */
-  gdb::unique_xmalloc_ptr<char> handle_gnat_encoded_entry
-       (cooked_index_entry *entry, htab_t gnat_entries);
+     full decoded name, or nullptr if the name could not be
+     decoded.  */
+  const char *handle_gnat_encoded_entry (cooked_index_entry *entry,
+					 htab_t gnat_entries);
 
   /* A helper method that does the work of 'finalize'.  */
   void do_finalize ();
@@ -271,8 +275,9 @@ class cooked_index
   /* The addrmap.  This maps address ranges to dwarf2_per_cu_data
      objects.  */
   addrmap *m_addrmap = nullptr;
-  /* Storage for canonical names.  */
-  std::vector<gdb::unique_xmalloc_ptr<char>> m_names;
+  /* Storage for canonical names, shared with the other indexes of
+     the same cooked_index_vector.  */
+  gdb::concurrent_bcache *m_names = nullptr;
   /* A future that tracks when the 'finalize' method is done.  Note
      that the 'get' method is never called on this future, only
      'wait'.  */
@@ -352,8 +357,21 @@ class cooked_index_vector : public dwarf_scanner_base
 
   quick_symbol_functions_up make_quick_functions () const override;
 
+  /* Print statistics about the canonical names of the entries, for
+     "maint print statistics".  */
+  void print_statistics ()
+  {
+    wait ();
+    m_names.print_statistics ("canonical names");
+  }
+
 private:
 
+  /* The canonical names computed while finalizing the indexes.  The
+     indexes are finalized concurrently, and identical names from
+     different indexes share storage.  */
+  gdb::concurrent_bcache m_names;
+
   /* The vector of cooked_index objects.  This is stored because the
      entries are stored on the obstacks in those objects.  */
   vec_type m_vector;
@@ -93,6 +93,7 @@
 #include "split-name.h"
 #include "gdbsupport/parallel-for.h"
 #include "gdbsupport/thread-pool.h"
+#include "perf-counters.h"
 
 /* When == 1, print basic high level tracing messages.
    When > 1, be more verbose.
@@ -114,6 +115,15 @@ static unsigned int dwarf_read_debug = 0;
 /* When non-zero, dump DIEs after they are read in.  */
 static unsigned int dwarf_die_debug = 0;
 
+/* Performance counters for reading DWARF.  */
+
+static perf_counter dwarf2_full_die_reads
+  ("dwarf2.full-die-reads", N_("DIEs fully read when expanding symtabs"));
+static perf_counter dwarf2_indexed_dies
+  ("dwarf2.indexed-dies", N_("DIEs scanned when building the index"));
+static perf_timer dwarf2_cu_expansions
+  ("dwarf2.cu-expansions", N_("Compilation units expanded to symtabs"));
+
 /* When non-zero, dump line number entries as they are read in.  */
 unsigned int dwarf_line_debug = 0;
 
@@ -2032,6 +2042,8 @@ static void
 dw2_do_instantiate_symtab (dwarf2_per_cu_data *per_cu,
 			   dwarf2_per_objfile *per_objfile, bool skip_partial)
 {
+  scoped_perf_timer timer (dwarf2_cu_expansions);
+
   {
     /* The destructor of dwarf2_queue_guard frees any entries left on
        the queue.  After this point we're guaranteed to leave this function
@@ -7028,12 +7040,45 @@ process_skeletonless_type_units (dwarf2_per_objfile *per_objfile,
     }
 }
 
-/* Build the partial symbol table by doing a quick pass through the
-   .debug_info and .debug_abbrev sections.  */
+/* The state of building the cooked index of one objfile.  The index
+   is built in three steps: start_cooked_index_build prepares the
+   build on the main thread, scan_cooked_index_builds scans the CUs in
+   the worker threads, and finish_cooked_index_build installs the
+   result on the main thread.  Splitting it up this way lets the CUs
+   of several objfiles be scanned in a single parallel pass.  */
+
+struct cooked_index_build
+{
+  explicit cooked_index_build (dwarf2_per_objfile *per_objfile)
+    : per_objfile (per_objfile)
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (cooked_index_build);
+
+  /* The objfile whose index is being built.  */
+  dwarf2_per_objfile *per_objfile;
+
+  /* The storage used on the main thread.  */
+  cooked_index_storage index_storage;
+
+  /* The indexes created while scanning the CUs.  */
+  std::vector<std::unique_ptr<cooked_index>> indexes;
+
+  /* The errors seen while scanning the CUs.  These are printed by
+     finish_cooked_index_build, because GDB's I/O system is not
+     thread-safe.  run_on_main_thread could be used, but that would
+     mean the messages are printed after the prompt, which looks
+     weird.  */
+  std::vector<gdb_exception> errors;
+};
+
+/* Prepare BUILD for scanning its CUs.  */
 
 static void
-dwarf2_build_psymtabs_hard (dwarf2_per_objfile *per_objfile)
+start_cooked_index_build (cooked_index_build *build)
 {
+  dwarf2_per_objfile *per_objfile = build->per_objfile;
   struct objfile *objfile = per_objfile->objfile;
   dwarf2_per_bfd *per_bfd = per_objfile->per_bfd;
 
@@ -7042,71 +7087,129 @@ dwarf2_build_psymtabs_hard (dwarf2_per_objfile *per_objfile)
 
   per_bfd->map_info_sections (objfile);
 
-  cooked_index_storage index_storage;
   create_all_comp_units (per_objfile);
-  build_type_psymtabs (per_objfile, &index_storage);
-  std::vector<std::unique_ptr<cooked_index>> indexes;
+  build_type_psymtabs (per_objfile, &build->index_storage);
 
   per_bfd->quick_file_names_table
     = create_quick_file_names_table (per_bfd->all_comp_units.size ());
   if (!per_bfd->debug_aranges.empty ())
     read_addrmap_from_aranges (per_objfile, &per_bfd->debug_aranges,
-			       index_storage.get_addrmap ());
+			       build->index_storage.get_addrmap ());
+}
 
+/* Scan the CUs of all of BUILDS.  The CUs of all the objfiles are put
+   in a single range, so that the work is spread over the worker
+   threads however it is distributed among the objfiles.  */
+
+static void
+scan_cooked_index_builds (gdb::array_view<cooked_index_build *> builds)
+{
+  using work_item = std::pair<cooked_index_build *, dwarf2_per_cu_data *>;
+  std::vector<work_item> items;
+  for (cooked_index_build *build : builds)
+    for (const auto &per_cu : build->per_objfile->per_bfd->all_comp_units)
+      items.emplace_back (build, per_cu.get ());
+
+  /* What a thread produced for one of BUILDS.  */
+  struct scan_result
   {
-    /* Ensure that complaints are handled correctly.  */
-    complaint_interceptor complaint_handler;
-
-    using iter_type = decltype (per_bfd->all_comp_units.begin ());
-
-    /* Each thread returns a pair holding a cooked index, and a vector
-       of errors that should be printed.  The latter is done because
-       GDB's I/O system is not thread-safe.  run_on_main_thread could be
-       used, but that would mean the messages are printed after the
-       prompt, which looks weird.  */
-    using result_type = std::pair<std::unique_ptr<cooked_index>,
-				  std::vector<gdb_exception>>;
-    std::vector<result_type> results
-      = gdb::parallel_for_each (1, per_bfd->all_comp_units.begin (),
-				per_bfd->all_comp_units.end (),
-				[=] (iter_type iter, iter_type end)
-      {
-	std::vector<gdb_exception> errors;
-	cooked_index_storage thread_storage;
-	for (; iter != end; ++iter)
-	  {
-	    dwarf2_per_cu_data *per_cu = iter->get ();
-	    try
-	      {
-		process_psymtab_comp_unit (per_cu, per_objfile,
-					   &thread_storage);
-	      }
-	    catch (gdb_exception &except)
-	      {
-		errors.push_back (std::move (except));
-	      }
-	  }
-	return result_type (thread_storage.release (), std::move (errors));
-      });
+    cooked_index_build *build;
+    std::unique_ptr<cooked_index> index;
+    std::vector<gdb_exception> errors;
+  };
+
+  /* Ensure that complaints are handled correctly.  */
+  complaint_interceptor complaint_handler;
 
-    /* Only show a given exception a single time.  */
-    std::unordered_set<gdb_exception> seen_exceptions;
-    for (auto &one_result : results)
+  using iter_type = decltype (items.begin ());
+
+  /* The sizes of CUs vary enormously, so split the work by their
+     length rather than by their number.  */
+  auto task_size_ = [] (iter_type iter)
+    {
+      return (size_t) iter->second->length ();
+    };
+  gdb::function_view<size_t (iter_type)> task_size = task_size_;
+
+  /* Each task returns a cooked index and a vector of errors for each
+     objfile whose CUs it scanned.  Since ITEMS is ordered by objfile,
+     each task sees the CUs of an objfile in a row.  */
+  std::vector<std::vector<scan_result>> results
+    = gdb::parallel_for_each (1, items.begin (), items.end (),
+			      [] (iter_type iter, iter_type end)
+    {
+      std::vector<scan_result> thread_results;
+      gdb::optional<cooked_index_storage> thread_storage;
+      cooked_index_build *current = nullptr;
+      std::vector<gdb_exception> errors;
+
+      auto flush = [&] ()
+	{
+	  if (current != nullptr)
+	    thread_results.push_back ({ current, thread_storage->release (),
+					std::move (errors) });
+	  thread_storage.reset ();
+	  errors.clear ();
+	};
+
+      for (; iter != end; ++iter)
+	{
+	  if (iter->first != current)
+	    {
+	      flush ();
+	      current = iter->first;
+	      thread_storage.emplace ();
+	    }
+
+	  try
+	    {
+	      process_psymtab_comp_unit (iter->second, current->per_objfile,
+					 &*thread_storage);
+	    }
+	  catch (gdb_exception &except)
+	    {
+	      errors.push_back (std::move (except));
+	    }
+	}
+      flush ();
+
+      return thread_results;
+    }, task_size);
+
+  for (auto &thread_results : results)
+    for (auto &one_result : thread_results)
       {
-	indexes.push_back (std::move (one_result.first));
-	for (auto &one_exc : one_result.second)
-	  if (seen_exceptions.insert (one_exc).second)
-	    exception_print (gdb_stderr, one_exc);
+	cooked_index_build *build = one_result.build;
+	build->indexes.push_back (std::move (one_result.index));
+	for (auto &one_exc : one_result.errors)
+	  build->errors.push_back (std::move (one_exc));
       }
-  }
+}
+
+/* Finish BUILD after its CUs were scanned, and install the resulting
+   index.  */
+
+static void
+finish_cooked_index_build (cooked_index_build *build)
+{
+  dwarf2_per_objfile *per_objfile = build->per_objfile;
+  struct objfile *objfile = per_objfile->objfile;
+  dwarf2_per_bfd *per_bfd = per_objfile->per_bfd;
+
+  /* Only show a given exception a single time.  */
+  std::unordered_set<gdb_exception> seen_exceptions;
+  for (auto &one_exc : build->errors)
+    if (seen_exceptions.insert (one_exc).second)
+      exception_print (gdb_stderr, one_exc);
 
   /* This has to wait until we read the CUs, we need the list of DWOs.  */
-  process_skeletonless_type_units (per_objfile, &index_storage);
+  process_skeletonless_type_units (per_objfile, &build->index_storage);
 
   if (dwarf_read_debug > 0)
     print_tu_stats (per_objfile);
 
-  indexes.push_back (index_storage.release ());
+  std::vector<std::unique_ptr<cooked_index>> &indexes = build->indexes;
+  indexes.push_back (build->index_storage.release ());
   /* Remove any NULL entries.  This might happen if parallel-for
      decides to throttle the number of threads that were used.  */
   indexes.erase
@@ -7131,6 +7234,77 @@ dwarf2_build_psymtabs_hard (dwarf2_per_objfile *per_objfile)
 			   objfile_name (objfile));
 }
 
+/* Build the partial symbol table by doing a quick pass through the
+   .debug_info and .debug_abbrev sections.  */
+
+static void
+dwarf2_build_psymtabs_hard (dwarf2_per_objfile *per_objfile)
+{
+  cooked_index_build build (per_objfile);
+  cooked_index_build *builds[] = { &build };
+
+  start_cooked_index_build (&build);
+  scan_cooked_index_builds (builds);
+  finish_cooked_index_build (&build);
+}
+
+/* Like dwarf2_build_psymtabs, but for all of OBJFILES at once.  The
+   CUs of all the objfiles are scanned in a single parallel pass; only
+   the preparation and the installation of each index are done one
+   objfile at a time.  */
+
+static void
+dwarf2_build_psymtabs_batch (gdb::array_view<objfile *> objfiles)
+{
+  std::vector<std::unique_ptr<cooked_index_build>> builds;
+  std::unordered_set<dwarf2_per_bfd *> seen_per_bfd;
+
+  for (objfile *objfile : objfiles)
+    {
+      if (!dwarf2_has_info (objfile, nullptr))
+	continue;
+
+      dwarf2_per_objfile *per_objfile = get_dwarf2_per_objfile (objfile);
+
+      /* Objfiles that share a BFD share its index too.  */
+      if (per_objfile->per_bfd->index_table != nullptr
+	  || !seen_per_bfd.insert (per_objfile->per_bfd).second)
+	continue;
+
+      std::unique_ptr<cooked_index_build> build
+	(new cooked_index_build (per_objfile));
+      try
+	{
+	  start_cooked_index_build (build.get ());
+	  builds.push_back (std::move (build));
+	}
+      catch (const gdb_exception_error &except)
+	{
+	  exception_print (gdb_stderr, except);
+	}
+    }
+
+  std::vector<cooked_index_build *> to_scan;
+  for (const auto &build : builds)
+    to_scan.push_back (build.get ());
+  scan_cooked_index_builds (to_scan);
+
+  for (const auto &build : builds)
+    {
+      try
+	{
+	  finish_cooked_index_build (build.get ());
+
+	  /* (maybe) store an index in the cache.  */
+	  global_index_cache.store (build->per_objfile);
+	}
+      catch (const gdb_exception_error &except)
+	{
+	  exception_print (gdb_stderr, except);
+	}
+    }
+}
+
 static void
 read_comp_units_from_section (dwarf2_per_objfile *per_objfile,
 			      struct dwarf2_section_info *section,
@@ -17789,6 +17963,7 @@ read_full_die_1 (const struct die_reader_specs *reader,
 	   bfd_get_filename (abfd));
 
   die = dwarf_alloc_die (cu, abbrev->num_attrs + num_extra_attrs);
+  dwarf2_full_die_reads.add ();
   die->sect_off = sect_off;
   die->tag = abbrev->tag;
   die->abbrev = abbrev_number;
@@ -18274,6 +18449,8 @@ cooked_indexer::index_dies (cutu_reader *reader,
   const gdb_byte *end_ptr = (reader->buffer
 			     + to_underlying (reader->cu->header.sect_off)
 			     + reader->cu->header.get_length ());
+  /* Counted locally, as this runs in worker threads.  */
+  unsigned long long n_scanned = 0;
 
   while (info_ptr < end_ptr)
     {
@@ -18309,6 +18486,7 @@ cooked_indexer::index_dies (cutu_reader *reader,
 				  info_ptr, abbrev, &name, &linkage_name,
 				  &flags, &sibling, &this_parent_entry,
 				  &defer, false);
+      ++n_scanned;
 
       if (abbrev->tag == DW_TAG_namespace
 	  && m_language == language_cplus
@@ -18418,6 +18596,7 @@ cooked_indexer::index_dies (cutu_reader *reader,
 	}
     }
 
+  dwarf2_indexed_dies.add (n_scanned);
   return info_ptr;
 }
 
@@ -18456,6 +18635,8 @@ struct cooked_index_functions : public dwarf2_base_index_functions
     gdb_printf ("Cooked index in use\n");
   }
 
+  void print_stats (struct objfile *objfile, bool print_bcache) override;
+
   void expand_matching_symbols
     (struct objfile *,
      const lookup_name_info &lookup_name,
@@ -18483,8 +18664,32 @@ struct cooked_index_functions : public dwarf2_base_index_functions
     if (dwarf2_has_info (objfile, nullptr))
       dwarf2_build_psymtabs (objfile);
   }
+
+  void read_partial_symbols_batch (gdb::array_view<objfile *> objfiles)
+    override
+  {
+    dwarf2_build_psymtabs_batch (objfiles);
+  }
 };
 
+void
+cooked_index_functions::print_stats (struct objfile *objfile,
+				     bool print_bcache)
+{
+  if (!print_bcache)
+    {
+      dwarf2_base_index_functions::print_stats (objfile, print_bcache);
+      return;
+    }
+
+  dwarf2_per_objfile *per_objfile = get_dwarf2_per_objfile (objfile);
+  cooked_index_vector *table
+    = (static_cast<cooked_index_vector *>
+       (per_objfile->per_bfd->index_table.get ()));
+  if (table != nullptr)
+    table->print_statistics ();
+}
+
 dwarf2_per_cu_data *
 cooked_index_functions::find_per_cu (dwarf2_per_bfd *per_bfd,
 				     CORE_ADDR adjusted_pc)
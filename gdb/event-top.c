@@ -588,7 +588,7 @@ command_handler (const char *command)
   if (ui->instream == ui->stdin_stream)
     reinitialize_more_filter ();
 
-  scoped_command_stats stat_reporter (true);
+  scoped_command_stats stat_reporter (true, command);
 
   /* Do not execute commented lines.  */
   for (c = command; *c == ' ' || *c == '\t'; c++)
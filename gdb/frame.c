@@ -43,6 +43,8 @@
 #include "hashtab.h"
 #include "valprint.h"
 #include "cli/cli-option.h"
+#include "perf-counters.h"
+#include "gdbsupport/byte-vector.h"
 
 /* The sentinel frame terminates the innermost end of the frame chain.
    If unwound, it returns the information needed to construct an
@@ -56,6 +58,19 @@ static struct frame_info *sentinel_frame;
 /* Number of calls to reinit_frame_cache.  */
 static unsigned int frame_cache_generation = 0;
 
+/* Performance counters for frame unwinding.  */
+
+static perf_timer frame_unwind_timer
+  ("frame.unwinds", N_("Frames unwound, not counting cached ones"));
+static perf_counter frame_cache_flushes
+  ("frame.cache-flushes", N_("Calls to reinit_frame_cache"));
+static perf_counter frame_reuse_splices
+  ("frame.reuse-splices", N_("Frame chains reused from the previous stop"));
+static perf_counter frame_reuse_frames
+  ("frame.reuse-frames", N_("Frames reused from the previous stop"));
+static perf_counter frame_reuse_misses
+  ("frame.reuse-misses", N_("Reusable frames whose stack had changed"));
+
 /* See frame.h.  */
 
 unsigned int
@@ -187,6 +202,10 @@ struct frame_info
   /* A frame specific string describing the STOP_REASON in more detail.
      Only valid when PREV_P is set, but even then may still be NULL.  */
   const char *stop_string;
+
+  /* The frame cache generation this frame was created in, which
+     identifies the obstack it lives on.  See frame_obstacks.  */
+  unsigned int generation;
 };
 
 /* See frame.h.  */
@@ -1590,14 +1609,32 @@ create_sentinel_frame (struct program_space *pspace, struct regcache *regcache)
 
 /* Cache for frame addresses already read by gdb.  Valid only while
    inferior is stopped.  Control variables for the frame cache should
-   be local to this module.  */
+   be local to this module.
 
-static struct obstack frame_cache_obstack;
+   There is one obstack per generation of the frame cache that still
+   has live frames, oldest first; the last one is where new frames are
+   allocated.  Normally there is just one, but the frames kept for
+   reuse after the next stop (see frame_reuse_chain) keep the
+   obstacks of their generations alive.  */
+
+struct frame_obstack : public auto_obstack
+{
+  explicit frame_obstack (unsigned int generation_)
+    : generation (generation_)
+  {
+  }
+
+  /* The value of frame_cache_generation when this obstack was
+     created.  */
+  unsigned int generation;
+};
+
+static std::vector<std::unique_ptr<frame_obstack>> frame_obstacks;
 
 void *
 frame_obstack_zalloc (unsigned long size)
 {
-  void *data = obstack_alloc (&frame_cache_obstack, size);
+  void *data = obstack_alloc (frame_obstacks.back ().get (), size);
 
   memset (data, 0, size);
   return data;
@@ -1970,11 +2007,440 @@ get_next_frame_sentinel_okay (struct frame_info *this_frame)
   return this_frame->next;
 }
 
+/* Frames reused across stops.
+
+   After a stop, most of the outer frames of a deep stack are usually
+   the same as at the previous stop: a "step" or "next" only changes
+   the innermost frames.  So, when the frame cache is flushed, the
+   chain of frames of the current thread is kept, along with a copy of
+   the stack memory it was unwound from.  At the next stop, while
+   unwinding, as soon as a frame has the ID, stack pointer and unwound
+   PC of a kept frame, and the stack memory from there outwards is
+   unchanged, the kept frames outer to it are linked into the new
+   chain instead of being unwound again.  The memory is checked with
+   target_verify_memory, which remote targets implement with a single
+   qCRC packet.
+
+   Everything the kept frames compute lazily after being reused is
+   computed from the current state, through the frames inner to them,
+   so only what they had cached is reused.  Anything that could change
+   that beyond what is checked, such as loading symbols, bumps
+   frame_reuse_epoch, which makes the kept frames unusable.  */
+
+struct frame_reuse_entry
+{
+  frame_info *frame;
+
+  /* The frame's stack pointer and architecture.  */
+  CORE_ADDR sp;
+  struct gdbarch *arch;
+};
+
+struct frame_reuse_chain
+{
+  /* The frames, innermost (level 0) first.  */
+  std::vector<frame_reuse_entry> frames;
+
+  /* The stack memory, from the lowest stack pointer of FRAMES up to
+     the highest stack address of their IDs.  */
+  CORE_ADDR stack_low = 0;
+  gdb::byte_vector stack;
+
+  /* The thread the frames belong to.  */
+  process_stratum_target *target = nullptr;
+  ptid_t ptid;
+
+  /* The value of frame_reuse_epoch when the chain was recorded.  */
+  unsigned int epoch = 0;
+
+  /* The frame cache generation the chain was recorded in.  The
+     frames may have allocated data on the obstacks of generations up
+     to this one.  */
+  unsigned int generation = 0;
+
+  /* Whether frames of this chain were linked into the current
+     chain.  */
+  bool spliced = false;
+};
+
+/* Whether to reuse frames across stops.  */
+
+static bool frame_reuse_p = true;
+
+/* Bumped whenever kept frames may no longer be reused.  */
+
+static unsigned int frame_reuse_epoch;
+
+/* The chain recorded for the current frame chain, if any.  */
+
+static std::unique_ptr<frame_reuse_chain> frame_reuse_current;
+
+/* The chain kept from a previous generation of the frame cache, if
+   any.  */
+
+static std::unique_ptr<frame_reuse_chain> frame_reuse_kept;
+
+/* The number of times the current generation tried to reuse a kept
+   frame and had to check the stack memory.  */
+
+static int frame_reuse_attempts;
+
+/* Chains shorter than this are not worth keeping.  */
+
+static const size_t frame_reuse_min_frames = 4;
+
+/* The maximum size of the stack memory copy of a chain.  */
+
+static const ULONGEST frame_reuse_max_stack = 1024 * 1024;
+
+/* The maximum number of checks of the stack memory per generation,
+   so that a stack that changed does not cost a check per frame.  */
+
+static const int frame_reuse_max_attempts = 4;
+
+/* The maximum number of frame obstacks kept alive by reused frames.
+   Frames reused again and again keep the obstack of the generation
+   they were created in alive, along with those of all the later
+   generations, so once this many are alive, the chain is unwound
+   afresh.  */
+
+static const size_t frame_reuse_max_generations = 16;
+
+/* Make kept frames unusable.  */
+
+static void
+frame_reuse_invalidate ()
+{
+  ++frame_reuse_epoch;
+}
+
+/* Release the unwinder caches of FI.  */
+
+static void
+frame_dealloc_caches (frame_info *fi)
+{
+  if (fi->prologue_cache && fi->unwind->dealloc_cache)
+    fi->unwind->dealloc_cache (fi, fi->prologue_cache);
+  if (fi->base_cache && fi->base->unwind->dealloc_cache)
+    fi->base->unwind->dealloc_cache (fi, fi->base_cache);
+  fi->prologue_cache = nullptr;
+  fi->base_cache = nullptr;
+}
+
+/* Return true if frames of FI's type can be reused.  */
+
+static bool
+frame_reuse_type_p (frame_info *fi)
+{
+  enum frame_type type = get_frame_type (fi);
+
+  return type == NORMAL_FRAME || type == INLINE_FRAME;
+}
+
+/* Return true if frames of the current thread may be recorded or
+   reused.  */
+
+static bool
+frame_reuse_possible_p ()
+{
+  return (frame_reuse_p
+	  && inferior_ptid != null_ptid
+	  && target_has_execution ()
+	  && !target_record_is_replaying (inferior_ptid));
+}
+
+/* Fill in the entries of CHAIN for the frames from level 0 up to and
+   including LAST.  Return false if any of them can't be reused.  */
+
+static bool
+frame_reuse_add_frames (frame_reuse_chain *chain, frame_info *last)
+{
+  for (frame_info *fi = sentinel_frame->prev; ; fi = fi->prev)
+    {
+      if (fi == nullptr
+	  || fi->this_id.p == frame_id_status::COMPUTING
+	  || !frame_reuse_type_p (fi))
+	return false;
+
+      struct gdbarch *arch = get_frame_arch (fi);
+      if (!gdbarch_inner_than (arch, 1, 2) || gdbarch_sp_regnum (arch) < 0)
+	return false;
+
+      get_frame_id (fi);
+      chain->frames.push_back ({ fi, get_frame_sp (fi), arch });
+
+      if (fi == last)
+	return true;
+    }
+}
+
+/* Return the highest stack address of the IDs of the frames of CHAIN
+   starting at index FIRST, or 0 if none has one.  */
+
+static CORE_ADDR
+frame_reuse_stack_high (const frame_reuse_chain *chain, size_t first)
+{
+  CORE_ADDR high = 0;
+
+  for (size_t i = first; i < chain->frames.size (); ++i)
+    {
+      const frame_id &id = chain->frames[i].frame->this_id.value;
+
+      if (id.stack_status == FID_STACK_VALID)
+	high = std::max (high, id.stack_addr);
+    }
+
+  return high;
+}
+
+/* Finish recording CHAIN, and make it the current chain's record.  */
+
+static void
+frame_reuse_set_current (std::unique_ptr<frame_reuse_chain> chain)
+{
+  chain->target = current_inferior ()->process_target ();
+  chain->ptid = inferior_ptid;
+  chain->epoch = frame_reuse_epoch;
+  chain->generation = frame_cache_generation;
+  frame_reuse_current = std::move (chain);
+}
+
+/* Called when unwinding stops at THIS_FRAME, the outermost frame of
+   the current chain.  Record the chain and the stack memory it was
+   unwound from, so that its frames can be reused after the next
+   stop.  */
+
+static void
+frame_reuse_record (frame_info *this_frame)
+{
+  static bool recording;
+
+  if (recording
+      || frame_reuse_current != nullptr
+      || this_frame->level < 0
+      || (size_t) this_frame->level + 1 < frame_reuse_min_frames
+      || !frame_reuse_possible_p ())
+    return;
+
+  scoped_restore restore_recording = make_scoped_restore (&recording, true);
+  std::unique_ptr<frame_reuse_chain> chain (new frame_reuse_chain);
+
+  try
+    {
+      if (!frame_reuse_add_frames (chain.get (), this_frame))
+	return;
+
+      CORE_ADDR low = chain->frames[0].sp;
+      for (const frame_reuse_entry &entry : chain->frames)
+	low = std::min (low, entry.sp);
+      CORE_ADDR high = frame_reuse_stack_high (chain.get (), 0);
+
+      if (high <= low || high - low > frame_reuse_max_stack)
+	return;
+
+      chain->stack_low = low;
+      chain->stack.resize (high - low);
+      if (target_read_stack (low, chain->stack.data (), high - low) != 0)
+	return;
+    }
+  catch (const gdb_exception_error &ex)
+    {
+      return;
+    }
+
+  frame_debug_printf ("recorded %zu frames, %s stack bytes",
+		      chain->frames.size (), pulongest (chain->stack.size ()));
+  frame_reuse_set_current (std::move (chain));
+}
+
+/* Try to reuse the kept frames outer to the one with THIS_FRAME's
+   ID as THIS_FRAME's previous frames.  Return true if THIS_FRAME->prev
+   was set that way.
+
+   This is not tried for the innermost frame: infrun unwinds it at
+   every internal stop to find the caller's ID, and checking the stack
+   memory there would slow down stepping.  Reuse starts at the caller,
+   which only unwinding the stack further needs.  */
+
+static bool
+frame_reuse_splice (frame_info *this_frame)
+{
+  frame_reuse_chain *kept = frame_reuse_kept.get ();
+
+  if (kept == nullptr
+      || kept->spliced
+      || this_frame->level < 1
+      || kept->epoch != frame_reuse_epoch
+      || frame_reuse_attempts >= frame_reuse_max_attempts
+      || !frame_reuse_possible_p ()
+      || kept->ptid != inferior_ptid
+      || kept->target != current_inferior ()->process_target ()
+      || this_frame->this_id.p == frame_id_status::COMPUTING
+      || !frame_reuse_type_p (this_frame))
+    return false;
+
+  frame_id this_id = get_frame_id (this_frame);
+  if (this_id.stack_status != FID_STACK_VALID)
+    return false;
+
+  /* Frame IDs are unique in a chain, so there is at most one
+     candidate.  The last kept frame has nothing outer to it to
+     reuse.  */
+  size_t i;
+  for (i = 0; i + 1 < kept->frames.size (); ++i)
+    {
+      const frame_id &id = kept->frames[i].frame->this_id.value;
+
+      if (id.stack_addr == this_id.stack_addr && frame_id_eq (id, this_id))
+	break;
+    }
+  if (i + 1 >= kept->frames.size ())
+    return false;
+
+  const frame_reuse_entry &entry = kept->frames[i];
+  frame_info *old_frame = entry.frame;
+
+  if (old_frame->prev != kept->frames[i + 1].frame
+      || old_frame->unwind != this_frame->unwind
+      || old_frame->prev_pc.status != CC_VALUE
+      || entry.arch != get_frame_arch (this_frame))
+    return false;
+
+  for (size_t j = i + 1; j < kept->frames.size (); ++j)
+    if (frame_stash_find (kept->frames[j].frame->this_id.value) != nullptr)
+      return false;
+
+  ++frame_reuse_attempts;
+  try
+    {
+      CORE_ADDR offset = entry.sp - kept->stack_low;
+
+      if (get_frame_sp (this_frame) != entry.sp
+	  || frame_unwind_pc (this_frame) != old_frame->prev_pc.value
+	  || target_verify_memory (kept->stack.data () + offset, entry.sp,
+				   kept->stack.size () - offset) != 1)
+	{
+	  frame_reuse_misses.add ();
+	  return false;
+	}
+    }
+  catch (const gdb_exception_error &ex)
+    {
+      return false;
+    }
+
+  /* The kept frames up to the matching one are not used anymore.  */
+  for (size_t j = 0; j <= i; ++j)
+    frame_dealloc_caches (kept->frames[j].frame);
+
+  frame_info *prev_frame = kept->frames[i + 1].frame;
+  this_frame->prev_p = true;
+  this_frame->stop_reason = UNWIND_NO_REASON;
+  this_frame->prev = prev_frame;
+  prev_frame->next = this_frame;
+
+  int level = this_frame->level;
+  for (size_t j = i + 1; j < kept->frames.size (); ++j)
+    {
+      kept->frames[j].frame->level = ++level;
+      frame_stash_add (kept->frames[j].frame);
+    }
+  kept->spliced = true;
+
+  frame_reuse_splices.add ();
+  frame_reuse_frames.add (kept->frames.size () - i - 1);
+  frame_debug_printf ("reused %zu frames after %s",
+		      kept->frames.size () - i - 1,
+		      this_id.to_string ().c_str ());
+
+  /* Record the new chain right away, so that it can be reused in
+     turn after the next stop.  Only the stack memory inner to the
+     splice point needs to be read.  */
+  std::unique_ptr<frame_reuse_chain> chain (new frame_reuse_chain);
+  try
+    {
+      if (!frame_reuse_add_frames (chain.get (), this_frame))
+	return true;
+
+      CORE_ADDR low = entry.sp;
+      for (const frame_reuse_entry &e : chain->frames)
+	low = std::min (low, e.sp);
+      if (kept->stack_low + kept->stack.size () - low > frame_reuse_max_stack)
+	return true;
+
+      chain->stack_low = low;
+      chain->stack.resize (entry.sp - low);
+      if (target_read_stack (low, chain->stack.data (), entry.sp - low) != 0)
+	return true;
+    }
+  catch (const gdb_exception_error &ex)
+    {
+      return true;
+    }
+
+  chain->stack.insert (chain->stack.end (),
+		       kept->stack.begin () + (entry.sp - kept->stack_low),
+		       kept->stack.end ());
+  chain->frames.insert (chain->frames.end (),
+			kept->frames.begin () + i + 1, kept->frames.end ());
+  frame_reuse_set_current (std::move (chain));
+
+  return true;
+}
+
+/* Observer for events after which kept frames may no longer be
+   reused.  */
+
+static void
+frame_reuse_observer_objfile (struct objfile *objfile)
+{
+  frame_reuse_invalidate ();
+}
+
+static void
+frame_reuse_observer_thread_exit (struct thread_info *thread, int silent)
+{
+  for (const auto &chain : { frame_reuse_current.get (),
+			     frame_reuse_kept.get () })
+    if (chain != nullptr && chain->ptid == thread->ptid)
+      frame_reuse_invalidate ();
+}
+
+static void
+frame_reuse_observer_inferior_exit (struct inferior *inf)
+{
+  frame_reuse_invalidate ();
+}
+
+static void
+frame_reuse_observer_register_changed (struct frame_info *frame, int regnum)
+{
+  frame_reuse_invalidate ();
+}
+
+/* Implement "maint set frame-reuse".  */
+
+static void
+set_frame_reuse (const char *args, int from_tty, struct cmd_list_element *c)
+{
+  frame_reuse_invalidate ();
+}
+
+/* Implement "maint show frame-reuse".  */
+
+static void
+show_frame_reuse (struct ui_file *file, int from_tty,
+		  struct cmd_list_element *c, const char *value)
+{
+  gdb_printf (file, _("Reusing frames across stops is %s.\n"), value);
+}
+
 /* Observer for the target_changed event.  */
 
 static void
 frame_observer_target_changed (struct target_ops *target)
 {
+  frame_reuse_invalidate ();
   reinit_frame_cache ();
 }
 
@@ -1986,19 +2452,79 @@ reinit_frame_cache (void)
   struct frame_info *fi;
 
   ++frame_cache_generation;
-
-  /* Tear down all frame caches.  */
+  frame_cache_flushes.add ();
+
+  /* Keep the chain recorded for the current frames, if any, or else
+     keep the one kept before if it wasn't used.  */
+  std::unique_ptr<frame_reuse_chain> keep;
+  if (frame_reuse_current != nullptr
+      && frame_reuse_current->epoch == frame_reuse_epoch
+      && frame_reuse_p)
+    keep = std::move (frame_reuse_current);
+  else if (frame_reuse_kept != nullptr && !frame_reuse_kept->spliced)
+    keep = std::move (frame_reuse_kept);
+  frame_reuse_current.reset ();
+
+  /* If the chain kept before wasn't used, and isn't kept anymore, its
+     frames are gone.  If it was used, the frames outer to the splice
+     point are part of the current chain, and the others were
+     released when splicing.  */
+  if (frame_reuse_kept != nullptr && !frame_reuse_kept->spliced)
+    for (const frame_reuse_entry &entry : frame_reuse_kept->frames)
+      frame_dealloc_caches (entry.frame);
+  frame_reuse_kept = std::move (keep);
+  frame_reuse_attempts = 0;
+
+  /* Tear down all frame caches, except for the kept frames.  Those
+     are the frames at the start of the current chain, if any.  */
   for (fi = sentinel_frame; fi != NULL; fi = fi->prev)
     {
-      if (fi->prologue_cache && fi->unwind->dealloc_cache)
-	fi->unwind->dealloc_cache (fi, fi->prologue_cache);
-      if (fi->base_cache && fi->base->unwind->dealloc_cache)
-	fi->base->unwind->dealloc_cache (fi, fi->base_cache);
+      if (frame_reuse_kept != nullptr
+	  && fi->level >= 0
+	  && (size_t) fi->level < frame_reuse_kept->frames.size ()
+	  && frame_reuse_kept->frames[fi->level].frame == fi)
+	continue;
+
+      frame_dealloc_caches (fi);
+    }
+
+  if (frame_reuse_kept != nullptr)
+    {
+      /* Frames outer to the last kept one were not kept, and why
+	 unwinding stopped there is found out again when reused.  */
+      frame_info *last = frame_reuse_kept->frames.back ().frame;
+      last->prev = nullptr;
+      last->prev_p = false;
+      last->stop_string = nullptr;
+
+      /* The kept frames, and the data they allocated later, live on
+	 the obstacks of the generations from their oldest up to the
+	 one they were recorded in.  */
+      unsigned int oldest = frame_reuse_kept->generation;
+      for (const frame_reuse_entry &entry : frame_reuse_kept->frames)
+	oldest = std::min (oldest, entry.frame->generation);
+      unsigned int newest = frame_reuse_kept->generation;
+
+      auto unused = [=] (const std::unique_ptr<frame_obstack> &obstack)
+	{
+	  return obstack->generation < oldest || obstack->generation > newest;
+	};
+      frame_obstacks.erase (std::remove_if (frame_obstacks.begin (),
+					    frame_obstacks.end (), unused),
+			    frame_obstacks.end ());
+
+      if (frame_obstacks.size () >= frame_reuse_max_generations)
+	{
+	  for (const frame_reuse_entry &entry : frame_reuse_kept->frames)
+	    frame_dealloc_caches (entry.frame);
+	  frame_reuse_kept.reset ();
+	}
     }
 
   /* Since we can't really be sure what the first object allocated was.  */
-  obstack_free (&frame_cache_obstack, 0);
-  obstack_init (&frame_cache_obstack);
+  if (frame_reuse_kept == nullptr)
+    frame_obstacks.clear ();
+  frame_obstacks.emplace_back (new frame_obstack (frame_cache_generation));
 
   if (sentinel_frame != NULL)
     annotate_frames_invalid ();
@@ -2176,6 +2702,8 @@ get_prev_frame_always_1 (struct frame_info *this_frame)
       return this_frame->prev;
     }
 
+  scoped_perf_timer timer (frame_unwind_timer);
+
   /* If the frame unwinder hasn't been selected yet, we must do so
      before setting prev_p; otherwise the check for misbehaved
      sniffers will think that this frame's sniffer tried to unwind
@@ -2183,6 +2711,11 @@ get_prev_frame_always_1 (struct frame_info *this_frame)
   if (this_frame->unwind == NULL)
     frame_unwind_find_by_frame (this_frame, &this_frame->prologue_cache);
 
+  /* If the frames outer to this one did not change since the
+     previous stop, reuse them.  */
+  if (frame_reuse_splice (this_frame))
+    return this_frame->prev;
+
   this_frame->prev_p = true;
   this_frame->stop_reason = UNWIND_NO_REASON;
 
@@ -2336,6 +2869,9 @@ get_prev_frame_always (struct frame_info *this_frame)
 	throw;
     }
 
+  if (prev_frame == NULL)
+    frame_reuse_record (this_frame);
+
   return prev_frame;
 }
 
@@ -2359,6 +2895,7 @@ get_prev_frame_raw (struct frame_info *this_frame)
      allocation calls.  */
   prev_frame = FRAME_OBSTACK_ZALLOC (struct frame_info);
   prev_frame->level = this_frame->level + 1;
+  prev_frame->generation = frame_cache_generation;
 
   /* For now, assume we don't have frame chains crossing address
      spaces.  */
@@ -2503,6 +3040,7 @@ get_prev_frame (struct frame_info *this_frame)
        automatically happen.  */
     {
       frame_debug_got_null_frame (this_frame, "inside main func");
+      frame_reuse_record (this_frame);
       return NULL;
     }
 
@@ -2546,6 +3084,7 @@ get_prev_frame (struct frame_info *this_frame)
       && inside_entry_func (this_frame))
     {
       frame_debug_got_null_frame (this_frame, "inside entry func");
+      frame_reuse_record (this_frame);
       return NULL;
     }
 
@@ -3120,12 +3659,20 @@ void _initialize_frame ();
 void
 _initialize_frame ()
 {
-  obstack_init (&frame_cache_obstack);
+  frame_obstacks.emplace_back (new frame_obstack (frame_cache_generation));
 
   frame_stash_create ();
 
   gdb::observers::target_changed.attach (frame_observer_target_changed,
 					 "frame");
+  gdb::observers::new_objfile.attach (frame_reuse_observer_objfile, "frame");
+  gdb::observers::free_objfile.attach (frame_reuse_observer_objfile, "frame");
+  gdb::observers::thread_exit.attach (frame_reuse_observer_thread_exit,
+				      "frame");
+  gdb::observers::inferior_exit.attach (frame_reuse_observer_inferior_exit,
+					"frame");
+  gdb::observers::register_changed.attach
+    (frame_reuse_observer_register_changed, "frame");
 
   add_setshow_prefix_cmd ("backtrace", class_maintenance,
 			  _("\
@@ -3160,4 +3707,16 @@ When non-zero, frame specific internal debugging is enabled."),
 			   NULL,
 			   show_frame_debug,
 			   &setdebuglist, &showdebuglist);
+
+  add_setshow_boolean_cmd ("frame-reuse", class_maintenance,
+			   &frame_reuse_p, _("\
+Set whether to reuse frames across stops."), _("\
+Show whether to reuse frames across stops."), _("\
+When on, after a stop, the frames outer to the first frame that is\n\
+the same as at the previous stop are reused instead of being unwound\n\
+again, if the stack memory they were unwound from did not change."),
+			   set_frame_reuse,
+			   show_frame_reuse,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
 }
@@ -1144,6 +1144,43 @@ maybe_add_address (htab_t set, struct program_space *pspace, CORE_ADDR addr)
   return 1;
 }
 
+/* If not NULL, linespec only searches the objfiles in this set.  See
+   scoped_linespec_objfile_filter.  */
+
+static const std::unordered_set<objfile *> *linespec_objfile_filter;
+
+/* See linespec.h.  */
+
+scoped_linespec_objfile_filter::scoped_linespec_objfile_filter
+  (const std::unordered_set<objfile *> &objfiles)
+  : m_saved (linespec_objfile_filter)
+{
+  linespec_objfile_filter = &objfiles;
+}
+
+/* See linespec.h.  */
+
+scoped_linespec_objfile_filter::~scoped_linespec_objfile_filter ()
+{
+  linespec_objfile_filter = m_saved;
+}
+
+/* Return true if linespec should search OBJFILE, taking the current
+   linespec_objfile_filter into account.  */
+
+static bool
+linespec_search_objfile_p (struct objfile *objfile)
+{
+  if (linespec_objfile_filter == nullptr)
+    return true;
+
+  /* A separate debug objfile is searched along with its parent.  */
+  if (objfile->separate_debug_objfile_backlink != nullptr)
+    objfile = objfile->separate_debug_objfile_backlink;
+
+  return linespec_objfile_filter->count (objfile) != 0;
+}
+
 /* A helper that walks over all matching symtabs in all objfiles and
    calls CALLBACK for each symbol matching NAME.  If SEARCH_PSPACE is
    not NULL, then the search is restricted to just that program
@@ -1170,6 +1207,9 @@ iterate_over_all_matching_symtabs
 
       for (objfile *objfile : current_program_space->objfiles ())
 	{
+	  if (!linespec_search_objfile_p (objfile))
+	    continue;
+
 	  objfile->expand_symtabs_matching (NULL, &lookup_name, NULL, NULL,
 					    (SEARCH_GLOBAL_BLOCK
 					     | SEARCH_STATIC_BLOCK),
@@ -3712,7 +3752,17 @@ collect_symtabs_from_filename (const char *file,
       iterate_over_symtabs (file, collector);
     }
 
-  return collector.release_symtabs ();
+  std::vector<symtab *> result = collector.release_symtabs ();
+  if (linespec_objfile_filter != nullptr)
+    result.erase (std::remove_if (result.begin (), result.end (),
+				  [] (symtab *s)
+				  {
+				    objfile *objfile = s->compunit ()->objfile ();
+				    return !linespec_search_objfile_p (objfile);
+				  }),
+		  result.end ());
+
+  return result;
 }
 
 /* Return all the symtabs associated to the FILENAME.  If SEARCH_PSPACE is
@@ -4224,6 +4274,9 @@ search_minsyms_for_name (struct collect_info *info,
 
 	  for (objfile *objfile : current_program_space->objfiles ())
 	    {
+	      if (!linespec_search_objfile_p (objfile))
+		continue;
+
 	      iterate_over_minimal_symbols (objfile, name,
 					    [&] (struct minimal_symbol *msym)
 					    {
@@ -4239,7 +4292,8 @@ search_minsyms_for_name (struct collect_info *info,
     {
       program_space *pspace = symtab->compunit ()->objfile ()->pspace;
 
-      if (search_pspace == NULL || pspace == search_pspace)
+      if ((search_pspace == NULL || pspace == search_pspace)
+	  && linespec_search_objfile_p (symtab->compunit ()->objfile ()))
 	{
 	  set_current_program_space (pspace);
 	  iterate_over_minimal_symbols
@@ -18,8 +18,10 @@
 #define LINESPEC_H 1
 
 struct symtab;
+struct objfile;
 
 #include "location.h"
+#include <unordered_set>
 
 /* Flags to pass to decode_line_1 and decode_line_full.  */
 
@@ -131,6 +133,26 @@ extern void decode_line_full (struct location_spec *locspec, int flags,
 			      const char *select_mode,
 			      const char *filter);
 
+/* While an instance of this class is live, linespec only searches
+   the objfiles in the given set (and their separate debug objfiles)
+   for symbols, minimal symbols and symtabs.  This is used to find out
+   cheaply whether some newly loaded objfiles can contribute locations
+   to an existing breakpoint.  */
+
+class scoped_linespec_objfile_filter
+{
+public:
+  explicit scoped_linespec_objfile_filter
+    (const std::unordered_set<objfile *> &objfiles);
+  ~scoped_linespec_objfile_filter ();
+
+  DISABLE_COPY_AND_ASSIGN (scoped_linespec_objfile_filter);
+
+private:
+  /* The filter that was in effect when this object was created.  */
+  const std::unordered_set<objfile *> *m_saved;
+};
+
 /* Given a string, return the line specified by it, using the current
    source symtab and line as defaults.
    This is for commands like "list" and "breakpoint".  */
@@ -900,6 +900,11 @@ static bool per_command_space;
 
 static bool per_command_symtab;
 
+/* If true, display the performance counters for each command, as a
+   line of JSON.  */
+
+static bool per_command_perf;
+
 /* mt per-command commands.  */
 
 static struct cmd_list_element *per_command_setlist;
@@ -970,7 +975,8 @@ scoped_command_stats::~scoped_command_stats ()
   if (m_msg_type
       && !per_command_time
       && !per_command_space
-      && !per_command_symtab)
+      && !per_command_symtab
+      && !per_command_perf)
     return;
 
   if (m_time_enabled && per_command_time)
@@ -1030,9 +1036,30 @@ scoped_command_stats::~scoped_command_stats ()
 		  nr_blocks,
 		  nr_blocks - m_start_nr_blocks);
     }
+
+  if (m_perf_start.has_value () && per_command_perf)
+    {
+      using namespace std::chrono;
+
+      run_time_clock::duration cmd_time
+	= run_time_clock::now () - m_start_cpu_time;
+      steady_clock::duration wall_time
+	= (steady_clock::now () - m_start_wall_time
+	   - get_prompt_for_continue_wait_time ());
+
+      std::string json = "{\"command\": ";
+      perf_json_append_string (json, m_command.c_str ());
+      string_appendf (json, ", \"cpu\": %.6f, \"wall\": %.6f, ",
+		      duration<double> (cmd_time).count (),
+		      duration<double> (wall_time).count ());
+      m_perf_start->append_json_delta (json);
+      json += "}\n";
+      gdb_puts (json.c_str (), gdb_stdlog);
+    }
 }
 
-scoped_command_stats::scoped_command_stats (bool msg_type)
+scoped_command_stats::scoped_command_stats (bool msg_type,
+					    const char *command)
 : m_msg_type (msg_type)
 {
   if (!m_msg_type || per_command_space)
@@ -1073,6 +1100,19 @@ scoped_command_stats::scoped_command_stats (bool msg_type)
   else
     m_symtab_enabled = 0;
 
+  if (msg_type && per_command_perf)
+    {
+      m_perf_enable.emplace ();
+      m_perf_start.emplace ();
+      if (command != nullptr)
+	m_command = command;
+      if (!m_time_enabled)
+	{
+	  m_start_cpu_time = run_time_clock::now ();
+	  m_start_wall_time = std::chrono::steady_clock::now ();
+	}
+    }
+
   /* Initialize timer to keep track of how long we waited for the user.  */
   reset_prompt_for_continue_wait_time ();
 }
@@ -1364,6 +1404,17 @@ displayed following the command's output."),
 			   NULL, NULL,
 			   &per_command_setlist, &per_command_showlist);
 
+  add_setshow_boolean_cmd ("perf", class_maintenance,
+			   &per_command_perf, _("\
+Set whether to display per-command performance counters."), _("\
+Show whether to display per-command performance counters."),
+			   _("\
+If enabled, the performance counters and timers that changed while\n\
+each command ran are displayed following the command's output, as a\n\
+single line of JSON.  See \"maintenance perf show\"."),
+			   NULL, NULL,
+			   &per_command_setlist, &per_command_showlist);
+
   /* This is equivalent to "mt set per-command time on".
      Kept because some people are used to typing "mt time 1".  */
   add_cmd ("time", class_maintenance, maintenance_time_display, _("\
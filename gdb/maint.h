@@ -20,6 +20,8 @@
 #define MAINT_H
 
 #include "gdbsupport/run-time-clock.h"
+#include "gdbsupport/gdb_optional.h"
+#include "perf-counters.h"
 #include <chrono>
 
 extern void set_per_command_time (int);
@@ -33,7 +35,11 @@ class scoped_command_stats
 {
  public:
 
-  explicit scoped_command_stats (bool msg_type);
+  /* COMMAND is the text of the command being run, if MSG_TYPE is
+     true.  It is only used for the per-command performance counter
+     report.  */
+  explicit scoped_command_stats (bool msg_type,
+				 const char *command = nullptr);
   ~scoped_command_stats ();
 
  private:
@@ -61,6 +67,13 @@ class scoped_command_stats
   int m_start_nr_compunit_symtabs;
   /* Total number of blocks.  */
   int m_start_nr_blocks;
+  /* The performance counters when the command started, if reporting
+     them.  */
+  gdb::optional<perf_snapshot> m_perf_start;
+  /* Keep performance counters collected while the command runs.  */
+  gdb::optional<scoped_perf_counters_enable> m_perf_enable;
+  /* The command, for the performance counter report.  */
+  std::string m_command;
 };
 
 extern obj_section *maint_obj_section_from_bfd_section (bfd *abfd,
@@ -0,0 +1,272 @@
+/* Performance counters and timers for GDB.
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "defs.h"
+#include "perf-counters.h"
+#include "gdbcmd.h"
+#include "cli/cli-utils.h"
+
+std::atomic<int> perf_detail::enabled { 0 };
+
+/* All the counters, in registration order.  These are function-local
+   statics because counters are registered by static constructors in
+   other files.  */
+
+static std::vector<perf_counter *> &
+all_perf_counters ()
+{
+  static std::vector<perf_counter *> counters;
+  return counters;
+}
+
+/* All the timers, in registration order.  */
+
+static std::vector<perf_timer *> &
+all_perf_timers ()
+{
+  static std::vector<perf_timer *> timers;
+  return timers;
+}
+
+perf_counter::perf_counter (const char *name, const char *doc)
+  : m_name (name),
+    m_doc (doc)
+{
+  all_perf_counters ().push_back (this);
+}
+
+perf_timer::perf_timer (const char *name, const char *doc)
+  : m_name (name),
+    m_doc (doc)
+{
+  all_perf_timers ().push_back (this);
+}
+
+/* See perf-counters.h.  */
+
+void
+perf_json_append_string (std::string &out, const char *s)
+{
+  out += '"';
+  for (; *s != '\0'; ++s)
+    {
+      unsigned char c = *s;
+
+      if (c == '"' || c == '\\')
+	{
+	  out += '\\';
+	  out += c;
+	}
+      else if (c == '\n')
+	out += "\\n";
+      else if (c == '\t')
+	out += "\\t";
+      else if (c < 0x20)
+	string_appendf (out, "\\u%04x", c);
+      else
+	out += c;
+    }
+  out += '"';
+}
+
+perf_snapshot::perf_snapshot (bool record)
+{
+  if (!record)
+    return;
+
+  for (const perf_counter *counter : all_perf_counters ())
+    m_counters.push_back (counter->value ());
+  for (const perf_timer *timer : all_perf_timers ())
+    m_timers.emplace_back (timer->count (), timer->nanoseconds ());
+}
+
+/* Return the change from BASE to VALUE.  A counter that was reset in
+   between counts from zero.  */
+
+static unsigned long long
+perf_delta (unsigned long long base, unsigned long long value)
+{
+  return value >= base ? value - base : value;
+}
+
+/* See perf-counters.h.  */
+
+void
+perf_snapshot::append_json_delta (std::string &out) const
+{
+  const std::vector<perf_counter *> &counters = all_perf_counters ();
+  const std::vector<perf_timer *> &timers = all_perf_timers ();
+
+  out += "\"counters\": {";
+  for (size_t i = 0; i < counters.size (); ++i)
+    {
+      if (i > 0)
+	out += ", ";
+      perf_json_append_string (out, counters[i]->name ());
+      unsigned long long base = i < m_counters.size () ? m_counters[i] : 0;
+      string_appendf (out, ": %llu",
+		      perf_delta (base, counters[i]->value ()));
+    }
+
+  out += "}, \"timers\": {";
+  for (size_t i = 0; i < timers.size (); ++i)
+    {
+      std::pair<unsigned long long, unsigned long long> base (0, 0);
+      if (i < m_timers.size ())
+	base = m_timers[i];
+      unsigned long long count = perf_delta (base.first, timers[i]->count ());
+      unsigned long long ns = perf_delta (base.second,
+					  timers[i]->nanoseconds ());
+
+      if (i > 0)
+	out += ", ";
+      perf_json_append_string (out, timers[i]->name ());
+      string_appendf (out, ": {\"count\": %llu, \"seconds\": %.6f}",
+		      count, ns / 1e9);
+    }
+  out += "}";
+}
+
+/* The value of "maint set perf-counters".  */
+
+static bool perf_counters_collect;
+
+/* Implement "maint set perf-counters".  */
+
+static void
+set_perf_counters_collect (const char *args, int from_tty,
+			   struct cmd_list_element *c)
+{
+  /* Whether this setting currently holds a reference on the enabled
+     count.  */
+  static bool collecting;
+
+  if (perf_counters_collect != collecting)
+    {
+      perf_detail::enabled.fetch_add (perf_counters_collect ? 1 : -1,
+				      std::memory_order_relaxed);
+      collecting = perf_counters_collect;
+    }
+}
+
+/* Implement "maint show perf-counters".  */
+
+static void
+show_perf_counters_collect (struct ui_file *file, int from_tty,
+			    struct cmd_list_element *c, const char *value)
+{
+  gdb_printf (file, _("Collection of performance counters is %s.\n"),
+	      value);
+}
+
+/* Implement "maint perf show".  With "-json", print the totals as a
+   single JSON object.  */
+
+static void
+maintenance_perf_show (const char *args, int from_tty)
+{
+  bool json = false;
+
+  if (args != nullptr)
+    {
+      args = skip_spaces (args);
+      if (check_for_argument (&args, "-json"))
+	json = true;
+      if (*args != '\0')
+	error (_("Unrecognized argument: %s"), args);
+    }
+
+  const std::vector<perf_counter *> &counters = all_perf_counters ();
+  const std::vector<perf_timer *> &timers = all_perf_timers ();
+
+  if (json)
+    {
+      perf_snapshot zero (false);
+      std::string out = "{";
+      zero.append_json_delta (out);
+      out += "}\n";
+      gdb_puts (out.c_str ());
+      return;
+    }
+
+  if (!perf_counters_enabled ())
+    gdb_printf (_("Performance counters are not being collected; "
+		  "use \"maintenance set perf-counters on\".\n"));
+
+  gdb_printf ("%-32s %14s  %s\n", _("Counter"), _("Value"),
+	      _("Description"));
+  for (const perf_counter *counter : counters)
+    gdb_printf ("%-32s %14s  %s\n", counter->name (),
+		pulongest (counter->value ()), counter->doc ());
+
+  gdb_printf ("\n%-32s %14s %12s  %s\n", _("Timer"), _("Count"),
+	      _("Seconds"), _("Description"));
+  for (const perf_timer *timer : timers)
+    gdb_printf ("%-32s %14s %12.6f  %s\n", timer->name (),
+		pulongest (timer->count ()), timer->nanoseconds () / 1e9,
+		timer->doc ());
+}
+
+/* Implement "maint perf reset".  */
+
+static void
+maintenance_perf_reset (const char *args, int from_tty)
+{
+  for (perf_counter *counter : all_perf_counters ())
+    counter->reset ();
+  for (perf_timer *timer : all_perf_timers ())
+    timer->reset ();
+}
+
+static struct cmd_list_element *maint_perf_cmdlist;
+
+void _initialize_perf_counters ();
+void
+_initialize_perf_counters ()
+{
+  add_basic_prefix_cmd ("perf", class_maintenance,
+			_("Commands for GDB's performance counters."),
+			&maint_perf_cmdlist, 0, &maintenancelist);
+
+  add_cmd ("show", class_maintenance, maintenance_perf_show, _("\
+Show the values of GDB's performance counters and timers.\n\
+Usage: maintenance perf show [-json]\n\
+The counters count events in GDB's hot paths, such as DWARF DIE reads,\n\
+symbol lookups or remote packets.  The timers count how many times some\n\
+operation ran and the total time it took.  With -json, print the values\n\
+as a single JSON object.\n\
+Values are only collected while \"maintenance set perf-counters\" or\n\
+\"maintenance set per-command perf\" is on."),
+	   &maint_perf_cmdlist);
+
+  add_cmd ("reset", class_maintenance, maintenance_perf_reset, _("\
+Reset GDB's performance counters and timers to zero."),
+	   &maint_perf_cmdlist);
+
+  add_setshow_boolean_cmd ("perf-counters", class_maintenance,
+			   &perf_counters_collect, _("\
+Set whether to collect performance counters."), _("\
+Show whether to collect performance counters."), _("\
+If enabled, GDB counts events in some of its hot paths, and times some\n\
+operations.  Use \"maintenance perf show\" to display the results."),
+			   set_perf_counters_collect,
+			   show_perf_counters_collect,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+}
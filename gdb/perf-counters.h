@@ -0,0 +1,226 @@
+/* Performance counters and timers for GDB.
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/* Performance counters count events in GDB's hot paths, such as DIE
+   reads or remote packets, and performance timers additionally
+   accumulate the time spent in them.  Both are defined as static
+   objects next to the code they instrument, and register themselves
+   by name so that "maint perf show" and the per-command statistics
+   can report them.  They may be updated from worker threads.
+
+   Collecting them is cheap but not free, so it only happens while
+   enabled, see "maint set perf-counters" and "maint set per-command
+   perf".  */
+
+namespace perf_detail
+{
+/* Nonzero if counters are being collected.  This is a count rather
+   than a flag because collection can be requested for more than one
+   reason.  */
+extern std::atomic<int> enabled;
+}
+
+/* Return true if performance counters are being collected.  */
+
+static inline bool
+perf_counters_enabled ()
+{
+  return perf_detail::enabled.load (std::memory_order_relaxed) != 0;
+}
+
+/* A named event counter.  */
+
+class perf_counter
+{
+public:
+
+  /* NAME is a dotted name like "dwarf2.die-reads", used as is in the
+     JSON output.  DOC is a short description.  Both must be static
+     strings.  */
+  perf_counter (const char *name, const char *doc);
+
+  DISABLE_COPY_AND_ASSIGN (perf_counter);
+
+  /* Count N more events.  */
+  void add (unsigned long long n = 1)
+  {
+    if (perf_counters_enabled ())
+      m_value.fetch_add (n, std::memory_order_relaxed);
+  }
+
+  unsigned long long value () const
+  {
+    return m_value.load (std::memory_order_relaxed);
+  }
+
+  void reset ()
+  {
+    m_value.store (0, std::memory_order_relaxed);
+  }
+
+  const char *name () const
+  { return m_name; }
+
+  const char *doc () const
+  { return m_doc; }
+
+private:
+
+  const char *m_name;
+  const char *m_doc;
+  std::atomic<unsigned long long> m_value { 0 };
+};
+
+/* A named timer, counting how many times some code ran and the total
+   wall time it took.  Use scoped_perf_timer to time a scope.  */
+
+class perf_timer
+{
+public:
+
+  /* See perf_counter.  */
+  perf_timer (const char *name, const char *doc);
+
+  DISABLE_COPY_AND_ASSIGN (perf_timer);
+
+  /* Record one more run, which took DURATION.  */
+  void add (std::chrono::steady_clock::duration duration)
+  {
+    m_count.fetch_add (1, std::memory_order_relaxed);
+    m_nanoseconds.fetch_add
+      (std::chrono::duration_cast<std::chrono::nanoseconds>
+	 (duration).count (),
+       std::memory_order_relaxed);
+  }
+
+  unsigned long long count () const
+  {
+    return m_count.load (std::memory_order_relaxed);
+  }
+
+  unsigned long long nanoseconds () const
+  {
+    return m_nanoseconds.load (std::memory_order_relaxed);
+  }
+
+  void reset ()
+  {
+    m_count.store (0, std::memory_order_relaxed);
+    m_nanoseconds.store (0, std::memory_order_relaxed);
+  }
+
+  const char *name () const
+  { return m_name; }
+
+  const char *doc () const
+  { return m_doc; }
+
+private:
+
+  const char *m_name;
+  const char *m_doc;
+  std::atomic<unsigned long long> m_count { 0 };
+  std::atomic<unsigned long long> m_nanoseconds { 0 };
+};
+
+/* Time the enclosing scope with TIMER.  Nested scopes using the same
+   timer are each counted, so the total time is inclusive.  */
+
+class scoped_perf_timer
+{
+public:
+
+  explicit scoped_perf_timer (perf_timer &timer)
+    : m_timer (perf_counters_enabled () ? &timer : nullptr)
+  {
+    if (m_timer != nullptr)
+      m_start = std::chrono::steady_clock::now ();
+  }
+
+  ~scoped_perf_timer ()
+  {
+    if (m_timer != nullptr)
+      m_timer->add (std::chrono::steady_clock::now () - m_start);
+  }
+
+  DISABLE_COPY_AND_ASSIGN (scoped_perf_timer);
+
+private:
+
+  perf_timer *m_timer;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/* While an instance of this class is live, performance counters are
+   collected.  */
+
+class scoped_perf_counters_enable
+{
+public:
+
+  scoped_perf_counters_enable ()
+  {
+    perf_detail::enabled.fetch_add (1, std::memory_order_relaxed);
+  }
+
+  ~scoped_perf_counters_enable ()
+  {
+    perf_detail::enabled.fetch_sub (1, std::memory_order_relaxed);
+  }
+
+  DISABLE_COPY_AND_ASSIGN (scoped_perf_counters_enable);
+};
+
+/* The values of all the counters and timers at some point in time,
+   used to report what happened in between two points.  */
+
+class perf_snapshot
+{
+public:
+
+  /* Record the current values.  If RECORD is false, use zero for
+     all values instead, so that the deltas are the totals.  */
+  explicit perf_snapshot (bool record = true);
+
+  /* Append to OUT the members of a JSON object describing the
+     changes from this snapshot to the current values: a "counters"
+     member, mapping counter names to event counts, and a "timers"
+     member, mapping timer names to objects with "count" and "seconds"
+     members.  */
+  void append_json_delta (std::string &out) const;
+
+private:
+
+  std::vector<unsigned long long> m_counters;
+  std::vector<std::pair<unsigned long long, unsigned long long>> m_timers;
+};
+
+/* Append S to OUT as a JSON string, quoted and escaped.  */
+
+extern void perf_json_append_string (std::string &out, const char *s);
+
+#endif /* PERF_COUNTERS_H */
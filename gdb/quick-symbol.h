@@ -20,6 +20,8 @@
 #ifndef GDB_QUICK_SYMBOL_H
 #define GDB_QUICK_SYMBOL_H
 
+#include "gdbsupport/array-view.h"
+
 /* Like block_enum, but used as flags to pass to lookup functions.  */
 
 enum block_search_flag_values
@@ -232,6 +234,18 @@ struct quick_symbol_functions
   virtual void read_partial_symbols (struct objfile *objfile)
   {
   }
+
+  /* Read the partial symbols for all of OBJFILES, each of which has
+     quick functions of the same kind as this object.  This will only
+     ever be called if can_lazily_read_symbols returns true.  The
+     default reads the objfiles one at a time; readers that can spread
+     the work of several objfiles over the thread pool override it.  */
+  virtual void read_partial_symbols_batch
+    (gdb::array_view<struct objfile *> objfiles)
+  {
+    for (struct objfile *objfile : objfiles)
+      read_partial_symbols (objfile);
+  }
 };
 
 typedef std::unique_ptr<quick_symbol_functions> quick_symbol_functions_up;
@@ -39,8 +39,15 @@
 #include "gdbsupport/gdb_unlinker.h"
 #include "gdbsupport/byte-vector.h"
 #include "async-event.h"
+#include "perf-counters.h"
+#include "gdbsupport/filestuff.h"
+#include "gdbsupport/pathstuff.h"
+#include "gdbsupport/scoped_fd.h"
+#include "leb128.h"
 
 #include <signal.h>
+#include <deque>
+#include <map>
 
 /* This module implements "target record-full", also known as "process
    record and replay".  This target sits on top of a "normal" target
@@ -65,97 +72,115 @@
 #define DEFAULT_RECORD_FULL_INSN_MAX_NUM	200000
 
 #define RECORD_FULL_IS_REPLAY \
-  (record_full_list->next || ::execution_direction == EXEC_REVERSE)
+  (record_full_pos != record_full_log_end () \
+   || ::execution_direction == EXEC_REVERSE)
 
 #define RECORD_FULL_FILE_MAGIC	netorder32(0x20091016)
 
 /* These are the core structs of the process record functionality.
 
-   A record_full_entry is a record of the value change of a register
-   ("record_full_reg") or a part of memory ("record_full_mem").  And each
-   instruction must have a struct record_full_entry ("record_full_end")
-   that indicates that this is the last struct record_full_entry of this
-   instruction.
+   The execution log is a sequence of instructions.  Each instruction
+   is recorded as the value change of the registers ("record_full_reg")
+   and the parts of memory ("record_full_mem") it modifies, including
+   the PC in every case.  An entry holds the value its register or
+   memory had on the other side of the instruction: executing the
+   instruction, in either direction, swaps the entry's value with the
+   current one.
+
+   Instructions are not allocated individually.  They are encoded back
+   to back into chunks of the log (struct record_full_chunk), each
+   entry as:
+
+     1 byte:  entry type (enum record_full_type), or'ed with
+	      RECORD_FULL_MEM_NOT_ACCESSIBLE once target memory for
+	      a memory entry can no longer be accessed.
+     record_full_reg:
+       uleb128: register number.
+       uleb128: register size.
+       n bytes: register value.
+     record_full_mem:
+       sleb128: memory address, relative to the chunk's MEM_BASE.
+       uleb128: memory length.
+       n bytes: memory value.
 
-   Each struct record_full_entry is linked to "record_full_list" by "prev"
-   and "next" pointers.  */
+   The instruction boundaries are kept in an array in each chunk, so
+   that the log can be walked in either direction and the chunk of any
+   instruction can be found with a binary search.  The signal delivered
+   after an instruction, which is rarely set, is kept on the side in
+   record_full_signals.  */
 
-struct record_full_mem_entry
+enum record_full_type
 {
-  CORE_ADDR addr;
-  int len;
-  /* Set this flag if target memory for this entry
-     can no longer be accessed.  */
-  int mem_entry_not_accessible;
-  union
-  {
-    gdb_byte *ptr;
-    gdb_byte buf[sizeof (gdb_byte *)];
-  } u;
+  record_full_end = 0,
+  record_full_reg,
+  record_full_mem
 };
 
-struct record_full_reg_entry
-{
-  unsigned short num;
-  unsigned short len;
-  union 
-  {
-    gdb_byte *ptr;
-    gdb_byte buf[2 * sizeof (gdb_byte *)];
-  } u;
-};
+#define RECORD_FULL_MEM_NOT_ACCESSIBLE	0x80
 
-struct record_full_end_entry
+/* A decoded entry of the execution log.  VAL points into the chunk
+   holding the entry, so that the value can be swapped in place.  */
+
+struct record_full_entry
 {
-  enum gdb_signal sigval;
-  ULONGEST insn_num;
+  enum record_full_type type;
+  /* The type byte of the entry, to flag inaccessible memory.  */
+  gdb_byte *tag;
+  /* The register number (record_full_reg).  */
+  int num;
+  /* The memory address (record_full_mem).  */
+  CORE_ADDR addr;
+  int len;
+  gdb_byte *val;
 };
 
-enum record_full_type
+/* The size above which a chunk of the log stops receiving new
+   instructions.  */
+
+#define RECORD_FULL_CHUNK_SIZE	(64 * 1024)
+
+/* A chunk of the execution log.  */
+
+struct record_full_chunk
 {
-  record_full_end = 0,
-  record_full_reg,
-  record_full_mem
-};
+  /* The number of the instruction at INSNS[0].  */
+  ULONGEST first_insn = 0;
 
-/* This is the data structure that makes up the execution log.
+  /* The index in INSNS of the first instruction still in the log.
+     Instructions are released from the start of the log one at a time,
+     but their storage is only freed along with the whole chunk.  */
+  size_t live = 0;
 
-   The execution log consists of a single linked list of entries
-   of type "struct record_full_entry".  It is doubly linked so that it
-   can be traversed in either direction.
+  /* The offset in DATA where each instruction starts.  An instruction
+     ends where the next one starts, or at SIZE.  */
+  std::vector<uint32_t> insns;
 
-   The start of the list is anchored by a struct called
-   "record_full_first".  The pointer "record_full_list" either points
-   to the last entry that was added to the list (in record mode), or to
-   the next entry in the list that will be executed (in replay mode).
+  /* The address memory entries are encoded relative to, if
+     HAVE_MEM_BASE.  It is the address of the first memory entry of the
+     chunk, which may well be zero.  */
+  CORE_ADDR mem_base = 0;
+  bool have_mem_base = false;
 
-   Each list element (struct record_full_entry), in addition to next
-   and prev pointers, consists of a union of three entry types: mem,
-   reg, and end.  A field called "type" determines which entry type is
-   represented by a given list element.
+  /* The encoded instructions.  This is empty while the chunk is
+     spilled to disk.  */
+  gdb::byte_vector data;
 
-   Each instruction that is added to the execution log is represented
-   by a variable number of list elements ('entries').  The instruction
-   will have one "reg" entry for each register that is changed by 
-   executing the instruction (including the PC in every case).  It 
-   will also have one "mem" entry for each memory change.  Finally,
-   each instruction will have an "end" entry that separates it from
-   the changes associated with the next instruction.  */
+  /* The size of the encoded instructions, also when spilled.  */
+  size_t size = 0;
 
-struct record_full_entry
-{
-  struct record_full_entry *prev;
-  struct record_full_entry *next;
-  enum record_full_type type;
-  union
-  {
-    /* reg */
-    struct record_full_reg_entry reg;
-    /* mem */
-    struct record_full_mem_entry mem;
-    /* end */
-    struct record_full_end_entry end;
-  } u;
+  /* Whether DATA is in memory.  */
+  bool resident = true;
+
+  /* Whether DATA differs from the copy in the spill file.  */
+  bool dirty = true;
+
+  /* The location of the copy in the spill file, if SPILL_SIZE is not
+     zero.  */
+  off_t spill_offset = 0;
+  size_t spill_size = 0;
+
+  /* When the chunk was last used, to choose which chunk to spill.  */
+  ULONGEST last_use = 0;
 };
 
 /* If true, query if PREC cannot record memory
@@ -174,27 +199,58 @@ static detached_regcache *record_full_core_regbuf = NULL;
 static target_section_table record_full_core_sections;
 static struct record_full_core_buf_entry *record_full_core_buf_list = NULL;
 
-/* The following variables are used for managing the linked list that
-   represents the execution log.
+/* The following variables are used for managing the execution log.
+
+   record_full_chunks holds the log, oldest instruction first.
+
+   record_full_pos is the number of the instruction that would be
+   executed next going forward.  In record mode, it is the end of the
+   log.  In replay mode, it moves within the log as instructions are
+   emulated.
 
-   record_full_first is the anchor that holds down the beginning of
-   the list.
+   record_full_arch_list is used to build up the change entries of the
+   currently executing instruction during record mode, with the values
+   in record_full_arch_vals.  When this instruction has been completely
+   annotated in the "arch list", it is appended to the log.  */
 
-   record_full_list serves two functions:
-     1) In record mode, it anchors the end of the list.
-     2) In replay mode, it traverses the list and points to
-	the next instruction that must be emulated.
+static std::deque<record_full_chunk> record_full_chunks;
+static ULONGEST record_full_pos = 1;
+static std::map<ULONGEST, enum gdb_signal> record_full_signals;
 
-   record_full_arch_list_head and record_full_arch_list_tail are used
-   to manage a separate list, which is used to build up the change
-   elements of the currently executing instruction during record mode.
-   When this instruction has been completely annotated in the "arch
-   list", it will be appended to the main execution log.  */
+struct record_full_arch_entry
+{
+  enum record_full_type type;
+  int num;
+  CORE_ADDR addr;
+  int len;
+  /* The offset of the value in record_full_arch_vals.  */
+  size_t val;
+};
 
-static struct record_full_entry record_full_first;
-static struct record_full_entry *record_full_list = &record_full_first;
-static struct record_full_entry *record_full_arch_list_head = NULL;
-static struct record_full_entry *record_full_arch_list_tail = NULL;
+static std::vector<record_full_arch_entry> record_full_arch_list;
+static gdb::byte_vector record_full_arch_vals;
+
+/* Chunks of the log are written to the spill file once the chunks in
+   memory take more than record_full_spill_threshold kilobytes.  -1
+   means unlimited.  */
+static int record_full_spill_threshold = -1;
+/* The directory of the spill file.  Empty means the system's
+   temporary directory.  */
+static std::string record_full_spill_directory;
+/* The spill file, which is unlinked as soon as it is created.  */
+static scoped_fd record_full_spill_fd;
+static off_t record_full_spill_file_size = 0;
+/* Freed areas of the spill file, as (offset, size) pairs.  */
+static std::vector<std::pair<off_t, size_t>> record_full_spill_holes;
+/* Incremented each time a chunk is used, for LRU spilling.  */
+static ULONGEST record_full_chunk_clock = 0;
+
+static perf_counter record_full_spilled_chunks
+  ("record-full.spilled-chunks",
+   "Chunks of the record-full log written to the spill file");
+static perf_counter record_full_loaded_chunks
+  ("record-full.loaded-chunks",
+   "Chunks of the record-full log read back from the spill file");
 
 /* true ask user. false auto delete the last struct record_full_entry.  */
 static bool record_full_stop_at_limit = true;
@@ -207,6 +263,30 @@ static unsigned int record_full_insn_num = 0;
    than count of insns presently in execution log).  */
 static ULONGEST record_full_insn_count;
 
+/* Return the number of the first instruction in the log.  */
+
+static ULONGEST
+record_full_log_begin (void)
+{
+  if (record_full_chunks.empty ())
+    return record_full_insn_count + 1;
+
+  const record_full_chunk &chunk = record_full_chunks.front ();
+  return chunk.first_insn + chunk.live;
+}
+
+/* Return the number following the last instruction in the log.  */
+
+static ULONGEST
+record_full_log_end (void)
+{
+  if (record_full_chunks.empty ())
+    return record_full_insn_count + 1;
+
+  const record_full_chunk &chunk = record_full_chunks.back ();
+  return chunk.first_insn + chunk.insns.size ();
+}
+
 static const char record_longname[]
   = N_("Process record and replay target");
 static const char record_doc[]
@@ -374,234 +454,524 @@ static struct cmd_list_element *show_record_full_cmdlist;
 /* Command list for "record full".  */
 static struct cmd_list_element *record_full_cmdlist;
 
-static void record_full_goto_insn (struct record_full_entry *entry,
+static void record_full_goto_insn (ULONGEST pos,
 				   enum exec_direction_kind dir);
 
-/* Alloc and free functions for record_full_reg, record_full_mem, and
-   record_full_end entries.  */
+/* Spill file functions.  */
 
-/* Alloc a record_full_reg record entry.  */
+/* Open the spill file, if not open yet.  */
 
-static inline struct record_full_entry *
-record_full_reg_alloc (struct regcache *regcache, int regnum)
+static void
+record_full_spill_open (void)
 {
-  struct record_full_entry *rec;
-  struct gdbarch *gdbarch = regcache->arch ();
+  if (record_full_spill_fd.get () >= 0)
+    return;
+
+  std::string dir = record_full_spill_directory;
+  if (dir.empty ())
+    dir = get_standard_temp_dir ();
 
-  rec = XCNEW (struct record_full_entry);
-  rec->type = record_full_reg;
-  rec->u.reg.num = regnum;
-  rec->u.reg.len = register_size (gdbarch, regnum);
-  if (rec->u.reg.len > sizeof (rec->u.reg.u.buf))
-    rec->u.reg.u.ptr = (gdb_byte *) xmalloc (rec->u.reg.len);
+  gdb::char_vector name
+    = make_temp_filename (path_join (dir.c_str (), "gdb-record"));
+  scoped_fd fd = gdb_mkostemp_cloexec (name.data ());
+  if (fd.get () < 0)
+    perror_with_name (_("Process record: cannot create spill file"));
 
-  return rec;
+  /* Nobody else needs to see the file.  */
+  unlink (name.data ());
+  record_full_spill_fd = std::move (fd);
+  record_full_spill_file_size = 0;
+  record_full_spill_holes.clear ();
 }
 
-/* Free a record_full_reg record entry.  */
+/* Find room for SIZE bytes in the spill file, preferably in a hole left
+   by a released chunk.  */
 
-static inline void
-record_full_reg_release (struct record_full_entry *rec)
+static off_t
+record_full_spill_alloc (size_t size)
 {
-  gdb_assert (rec->type == record_full_reg);
-  if (rec->u.reg.len > sizeof (rec->u.reg.u.buf))
-    xfree (rec->u.reg.u.ptr);
-  xfree (rec);
-}
+  for (auto &hole : record_full_spill_holes)
+    if (hole.second >= size)
+      {
+	off_t offset = hole.first;
 
-/* Alloc a record_full_mem record entry.  */
+	hole.first += size;
+	hole.second -= size;
+	return offset;
+      }
 
-static inline struct record_full_entry *
-record_full_mem_alloc (CORE_ADDR addr, int len)
-{
-  struct record_full_entry *rec;
+  off_t offset = record_full_spill_file_size;
+  record_full_spill_file_size += size;
+  return offset;
+}
 
-  rec = XCNEW (struct record_full_entry);
-  rec->type = record_full_mem;
-  rec->u.mem.addr = addr;
-  rec->u.mem.len = len;
-  if (rec->u.mem.len > sizeof (rec->u.mem.u.buf))
-    rec->u.mem.u.ptr = (gdb_byte *) xmalloc (len);
+/* Give back the spill file copy of CHUNK.  */
 
-  return rec;
+static void
+record_full_spill_free (record_full_chunk &chunk)
+{
+  if (chunk.spill_size != 0)
+    record_full_spill_holes.emplace_back (chunk.spill_offset,
+					  chunk.spill_size);
+  chunk.spill_size = 0;
 }
 
-/* Free a record_full_mem record entry.  */
+/* Write LEN bytes of BUF at OFFSET in the spill file.  */
 
-static inline void
-record_full_mem_release (struct record_full_entry *rec)
+static void
+record_full_spill_write (off_t offset, const gdb_byte *buf, size_t len)
 {
-  gdb_assert (rec->type == record_full_mem);
-  if (rec->u.mem.len > sizeof (rec->u.mem.u.buf))
-    xfree (rec->u.mem.u.ptr);
-  xfree (rec);
+  int fd = record_full_spill_fd.get ();
+
+  if (lseek (fd, offset, SEEK_SET) != offset)
+    perror_with_name (_("Process record: cannot seek in spill file"));
+
+  while (len > 0)
+    {
+      ssize_t n = write (fd, buf, len);
+
+      if (n < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  perror_with_name (_("Process record: cannot write spill file"));
+	}
+      buf += n;
+      len -= n;
+    }
 }
 
-/* Alloc a record_full_end record entry.  */
+/* Read LEN bytes at OFFSET in the spill file into BUF.  */
 
-static inline struct record_full_entry *
-record_full_end_alloc (void)
+static void
+record_full_spill_read (off_t offset, gdb_byte *buf, size_t len)
 {
-  struct record_full_entry *rec;
+  int fd = record_full_spill_fd.get ();
+
+  if (lseek (fd, offset, SEEK_SET) != offset)
+    perror_with_name (_("Process record: cannot seek in spill file"));
 
-  rec = XCNEW (struct record_full_entry);
-  rec->type = record_full_end;
+  while (len > 0)
+    {
+      ssize_t n = read (fd, buf, len);
 
-  return rec;
+      if (n < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  perror_with_name (_("Process record: cannot read spill file"));
+	}
+      if (n == 0)
+	error (_("Process record: spill file is truncated."));
+      buf += n;
+      len -= n;
+    }
 }
 
-/* Free a record_full_end record entry.  */
+/* Write CHUNK to the spill file, if its copy there is out of date, and
+   free its memory.  */
 
-static inline void
-record_full_end_release (struct record_full_entry *rec)
+static void
+record_full_chunk_spill (record_full_chunk &chunk)
 {
-  xfree (rec);
+  gdb_assert (chunk.resident);
+
+  if (chunk.dirty || chunk.spill_size < chunk.size)
+    {
+      record_full_spill_open ();
+      if (chunk.spill_size < chunk.size)
+	{
+	  record_full_spill_free (chunk);
+	  chunk.spill_offset = record_full_spill_alloc (chunk.size);
+	  chunk.spill_size = chunk.size;
+	}
+      record_full_spill_write (chunk.spill_offset, chunk.data.data (),
+			       chunk.size);
+      chunk.dirty = false;
+    }
+
+  chunk.data = gdb::byte_vector ();
+  chunk.resident = false;
+  record_full_spilled_chunks.add ();
 }
 
-/* Free one record entry, any type.
-   Return entry->type, in case caller wants to know.  */
+/* Read CHUNK back from the spill file.  */
 
-static inline enum record_full_type
-record_full_entry_release (struct record_full_entry *rec)
+static void
+record_full_chunk_load (record_full_chunk &chunk)
 {
-  enum record_full_type type = rec->type;
+  gdb_assert (!chunk.resident);
 
-  switch (type) {
-  case record_full_reg:
-    record_full_reg_release (rec);
-    break;
-  case record_full_mem:
-    record_full_mem_release (rec);
-    break;
-  case record_full_end:
-    record_full_end_release (rec);
-    break;
-  }
-  return type;
+  gdb::byte_vector data (chunk.size);
+  record_full_spill_read (chunk.spill_offset, data.data (), chunk.size);
+
+  chunk.data = std::move (data);
+  chunk.resident = true;
+  chunk.dirty = false;
+  record_full_loaded_chunks.add ();
 }
 
-/* Free all record entries in list pointed to by REC.  */
+/* Spill chunks of the log, least recently used first, until the chunks
+   in memory fit in record_full_spill_threshold.  The last chunk, which
+   receives new instructions, and KEEP are never spilled.  */
 
 static void
-record_full_list_release (struct record_full_entry *rec)
+record_full_spill (const record_full_chunk *keep)
 {
-  if (!rec)
+  if (record_full_spill_threshold < 0 || record_full_chunks.empty ())
     return;
 
-  while (rec->next)
-    rec = rec->next;
+  size_t limit = (size_t) record_full_spill_threshold * 1024;
+  size_t resident = 0;
+  std::vector<record_full_chunk *> candidates;
 
-  while (rec->prev)
+  for (record_full_chunk &chunk : record_full_chunks)
+    if (chunk.resident)
+      {
+	resident += chunk.data.capacity ();
+	if (&chunk != keep && &chunk != &record_full_chunks.back ())
+	  candidates.push_back (&chunk);
+      }
+
+  if (resident <= limit)
+    return;
+
+  std::sort (candidates.begin (), candidates.end (),
+	     [] (const record_full_chunk *a, const record_full_chunk *b)
+	     {
+	       return a->last_use < b->last_use;
+	     });
+
+  for (record_full_chunk *chunk : candidates)
     {
-      rec = rec->prev;
-      record_full_entry_release (rec->next);
+      if (resident <= limit)
+	break;
+      resident -= chunk->data.capacity ();
+      record_full_chunk_spill (*chunk);
     }
+}
+
+/* Execution log functions.  */
+
+/* Return the chunk holding instruction NUM, reading it back from the
+   spill file if needed.  */
+
+static record_full_chunk &
+record_full_chunk_get (ULONGEST num)
+{
+  auto it = std::upper_bound (record_full_chunks.begin (),
+			      record_full_chunks.end (), num,
+			      [] (ULONGEST n, const record_full_chunk &chunk)
+			      {
+				return n < chunk.first_insn;
+			      });
+  gdb_assert (it != record_full_chunks.begin ());
+
+  record_full_chunk &chunk = *--it;
+  gdb_assert (num >= chunk.first_insn + chunk.live
+	      && num < chunk.first_insn + chunk.insns.size ());
 
-  if (rec == &record_full_first)
+  chunk.last_use = ++record_full_chunk_clock;
+  if (!chunk.resident)
     {
-      record_full_insn_num = 0;
-      record_full_first.next = NULL;
+      record_full_chunk_load (chunk);
+      record_full_spill (&chunk);
     }
-  else
-    record_full_entry_release (rec);
+
+  return chunk;
 }
 
-/* Free all record entries forward of the given list position.  */
+/* Decode the entries of instruction NUM into ENTRIES, and return the
+   chunk holding them.  */
 
-static void
-record_full_list_release_following (struct record_full_entry *rec)
+static record_full_chunk &
+record_full_decode_insn (ULONGEST num,
+			 std::vector<record_full_entry> &entries)
 {
-  struct record_full_entry *tmp = rec->next;
+  record_full_chunk &chunk = record_full_chunk_get (num);
+  size_t idx = num - chunk.first_insn;
+  gdb_byte *p = chunk.data.data () + chunk.insns[idx];
+  gdb_byte *end = chunk.data.data () + (idx + 1 < chunk.insns.size ()
+					? chunk.insns[idx + 1] : chunk.size);
 
-  rec->next = NULL;
-  while (tmp)
+  entries.clear ();
+  while (p < end)
     {
-      rec = tmp->next;
-      if (record_full_entry_release (tmp) == record_full_end)
+      record_full_entry entry {};
+      uint64_t value = 0;
+
+      entry.tag = p;
+      entry.type = (enum record_full_type) (*p++
+					    & ~RECORD_FULL_MEM_NOT_ACCESSIBLE);
+      if (entry.type == record_full_reg)
 	{
-	  record_full_insn_num--;
-	  record_full_insn_count--;
+	  p += read_uleb128_to_uint64 (p, end, &value);
+	  entry.num = value;
 	}
-      tmp = rec;
+      else
+	{
+	  int64_t offset = 0;
+
+	  gdb_assert (entry.type == record_full_mem);
+	  p += read_sleb128_to_int64 (p, end, &offset);
+	  entry.addr = chunk.mem_base + (CORE_ADDR) offset;
+	}
+      p += read_uleb128_to_uint64 (p, end, &value);
+      entry.len = value;
+      entry.val = p;
+      p += entry.len;
+
+      entries.push_back (entry);
     }
+  gdb_assert (p == end);
+
+  return chunk;
 }
 
-/* Delete the first instruction from the beginning of the log, to make
-   room for adding a new instruction at the end of the log.
+/* Append VALUE to DATA as an unsigned LEB128 number.  */
 
-   Note -- this function does not modify record_full_insn_num.  */
+static void
+record_full_put_uleb128 (gdb::byte_vector &data, ULONGEST value)
+{
+  do
+    {
+      gdb_byte byte = value & 0x7f;
+
+      value >>= 7;
+      if (value != 0)
+	byte |= 0x80;
+      data.push_back (byte);
+    }
+  while (value != 0);
+}
+
+/* Append VALUE to DATA as a signed LEB128 number.  */
 
 static void
-record_full_list_release_first (void)
+record_full_put_sleb128 (gdb::byte_vector &data, LONGEST value)
 {
-  struct record_full_entry *tmp;
+  bool more;
 
-  if (!record_full_first.next)
-    return;
+  do
+    {
+      gdb_byte byte = value & 0x7f;
+
+      value >>= 7;
+      more = !((value == 0 && (byte & 0x40) == 0)
+	       || (value == -1 && (byte & 0x40) != 0));
+      if (more)
+	byte |= 0x80;
+      data.push_back (byte);
+    }
+  while (more);
+}
+
+/* Clear record_full_arch_list.  */
+
+static void
+record_full_arch_list_clear (void)
+{
+  record_full_arch_list.clear ();
+  record_full_arch_vals.clear ();
+}
+
+/* Append the instruction built up in record_full_arch_list to the end
+   of the log, and move record_full_pos past it.  */
+
+static void
+record_full_log_append (void)
+{
+  ULONGEST num = record_full_log_end ();
 
-  /* Loop until a record_full_end.  */
-  while (1)
+  if (record_full_chunks.empty ()
+      || record_full_chunks.back ().size >= RECORD_FULL_CHUNK_SIZE)
     {
-      /* Cut record_full_first.next out of the linked list.  */
-      tmp = record_full_first.next;
-      record_full_first.next = tmp->next;
-      tmp->next->prev = &record_full_first;
+      if (!record_full_chunks.empty ())
+	record_full_chunks.back ().data.shrink_to_fit ();
+
+      record_full_chunks.emplace_back ();
+      record_full_chunks.back ().first_insn = num;
+      record_full_chunks.back ().data.reserve (RECORD_FULL_CHUNK_SIZE);
+
+      /* The previous chunk is complete, see if it should go to disk.  */
+      record_full_spill (nullptr);
+    }
 
-      /* tmp is now isolated, and can be deleted.  */
-      if (record_full_entry_release (tmp) == record_full_end)
-	break;	/* End loop at first record_full_end.  */
+  record_full_chunk &chunk = record_full_chunks.back ();
+  if (!chunk.resident)
+    record_full_chunk_load (chunk);
 
-      if (!record_full_first.next)
+  chunk.insns.push_back (chunk.size);
+  for (const record_full_arch_entry &entry : record_full_arch_list)
+    {
+      if (entry.type == record_full_reg)
 	{
-	  gdb_assert (record_full_insn_num == 1);
-	  break;	/* End loop when list is empty.  */
+	  chunk.data.push_back (record_full_reg);
+	  record_full_put_uleb128 (chunk.data, entry.num);
 	}
+      else
+	{
+	  /* Memory addresses stored in one chunk tend to be close to
+	     each other, so encode them relative to the first one.  */
+	  if (!chunk.have_mem_base)
+	    {
+	      chunk.mem_base = entry.addr;
+	      chunk.have_mem_base = true;
+	    }
+	  chunk.data.push_back (record_full_mem);
+	  record_full_put_sleb128 (chunk.data,
+				   (LONGEST) (entry.addr - chunk.mem_base));
+	}
+      record_full_put_uleb128 (chunk.data, entry.len);
+      chunk.data.insert (chunk.data.end (),
+			 record_full_arch_vals.begin () + entry.val,
+			 record_full_arch_vals.begin () + entry.val
+			 + entry.len);
     }
+  chunk.size = chunk.data.size ();
+  chunk.dirty = true;
+  chunk.last_use = ++record_full_chunk_clock;
+
+  record_full_arch_list_clear ();
+  record_full_insn_num++;
+  record_full_pos = num + 1;
 }
 
-/* Add a struct record_full_entry to record_full_arch_list.  */
+/* Release CHUNK's storage.  */
 
 static void
-record_full_arch_list_add (struct record_full_entry *rec)
+record_full_chunk_release (record_full_chunk &chunk)
 {
-  if (record_debug > 1)
-    gdb_printf (gdb_stdlog,
-		"Process record: record_full_arch_list_add %s.\n",
-		host_address_to_string (rec));
+  record_full_spill_free (chunk);
+}
+
+/* Free the whole execution log.  */
+
+static void
+record_full_list_release (void)
+{
+  record_full_chunks.clear ();
+  record_full_signals.clear ();
+  record_full_arch_list_clear ();
+  record_full_spill_fd = scoped_fd ();
+  record_full_spill_file_size = 0;
+  record_full_spill_holes.clear ();
+  record_full_insn_num = 0;
+}
+
+/* Free all instructions of the log from instruction number POS
+   on.  */
+
+static void
+record_full_list_release_following (ULONGEST pos)
+{
+  ULONGEST end = record_full_log_end ();
+
+  if (pos >= end)
+    return;
 
-  if (record_full_arch_list_tail)
+  record_full_insn_num -= end - pos;
+  record_full_insn_count -= end - pos;
+  record_full_signals.erase (record_full_signals.lower_bound (pos),
+			     record_full_signals.end ());
+
+  /* Drop the chunks that are entirely past POS, but keep one so that
+     the log remembers where it ends.  */
+  while (record_full_chunks.size () > 1
+	 && (record_full_chunks.back ().first_insn
+	     + record_full_chunks.back ().live) >= pos)
     {
-      record_full_arch_list_tail->next = rec;
-      rec->prev = record_full_arch_list_tail;
-      record_full_arch_list_tail = rec;
+      record_full_chunk_release (record_full_chunks.back ());
+      record_full_chunks.pop_back ();
     }
-  else
+
+  record_full_chunk &chunk = record_full_chunks.back ();
+  size_t idx = pos - chunk.first_insn;
+  if (idx < chunk.insns.size ())
     {
-      record_full_arch_list_head = rec;
-      record_full_arch_list_tail = rec;
+      if (!chunk.resident)
+	record_full_chunk_load (chunk);
+      chunk.size = chunk.insns[idx];
+      chunk.data.resize (chunk.size);
+      chunk.insns.resize (idx);
+      chunk.dirty = true;
     }
 }
 
-/* Return the value storage location of a record entry.  */
-static inline gdb_byte *
-record_full_get_loc (struct record_full_entry *rec)
-{
-  switch (rec->type) {
-  case record_full_mem:
-    if (rec->u.mem.len > sizeof (rec->u.mem.u.buf))
-      return rec->u.mem.u.ptr;
-    else
-      return rec->u.mem.u.buf;
-  case record_full_reg:
-    if (rec->u.reg.len > sizeof (rec->u.reg.u.buf))
-      return rec->u.reg.u.ptr;
-    else
-      return rec->u.reg.u.buf;
-  case record_full_end:
-  default:
-    gdb_assert_not_reached ("unexpected record_full_entry type");
-    return NULL;
-  }
+/* Delete the first instruction from the beginning of the log, to make
+   room for adding a new instruction at the end of the log.  */
+
+static void
+record_full_list_release_first (void)
+{
+  if (record_full_insn_num == 0)
+    return;
+
+  record_full_chunk &chunk = record_full_chunks.front ();
+  ULONGEST num = chunk.first_insn + chunk.live;
+
+  record_full_signals.erase (num);
+  chunk.live++;
+  record_full_insn_num--;
+
+  if (chunk.live == chunk.insns.size () && record_full_chunks.size () > 1)
+    {
+      record_full_chunk_release (chunk);
+      record_full_chunks.pop_front ();
+    }
+
+  /* Stay within the log if replaying from its beginning.  */
+  if (record_full_pos <= num)
+    record_full_pos = num + 1;
+}
+
+/* Return the signal delivered after instruction NUM.  */
+
+static enum gdb_signal
+record_full_get_signal (ULONGEST num)
+{
+  auto it = record_full_signals.find (num);
+
+  if (it == record_full_signals.end ())
+    return GDB_SIGNAL_0;
+  return it->second;
+}
+
+/* Record that SIGNAL was delivered after instruction NUM.  */
+
+static void
+record_full_set_signal (ULONGEST num, enum gdb_signal signal)
+{
+  if (signal == GDB_SIGNAL_0)
+    record_full_signals.erase (num);
+  else
+    record_full_signals[num] = signal;
+}
+
+/* Return the number of the instruction executed last at position POS
+   of the log, or zero at the beginning of the log.  */
+
+static ULONGEST
+record_full_pos_insn (ULONGEST pos)
+{
+  if (pos == record_full_log_begin ())
+    return 0;
+  return pos - 1;
+}
+
+/* Add an entry to record_full_arch_list, and return the storage for
+   its LEN bytes value.  */
+
+static gdb_byte *
+record_full_arch_list_add (enum record_full_type type, int num,
+			   CORE_ADDR addr, int len)
+{
+  size_t val = record_full_arch_vals.size ();
+
+  record_full_arch_vals.resize (val + len);
+  record_full_arch_list.push_back ({type, num, addr, len, val});
+
+  return record_full_arch_vals.data () + val;
 }
 
 /* Record the value of a register NUM to record_full_arch_list.  */
@@ -609,7 +979,7 @@ record_full_get_loc (struct record_full_entry *rec)
 int
 record_full_arch_list_add_reg (struct regcache *regcache, int regnum)
 {
-  struct record_full_entry *rec;
+  gdb_byte *loc;
 
   if (record_debug > 1)
     gdb_printf (gdb_stdlog,
@@ -617,11 +987,9 @@ record_full_arch_list_add_reg (struct regcache *regcache, int regnum)
 		"record list.\n",
 		regnum);
 
-  rec = record_full_reg_alloc (regcache, regnum);
-
-  regcache->raw_read (regnum, record_full_get_loc (rec));
-
-  record_full_arch_list_add (rec);
+  loc = record_full_arch_list_add (record_full_reg, regnum, 0,
+				   register_size (regcache->arch (), regnum));
+  regcache->raw_read (regnum, loc);
 
   return 0;
 }
@@ -632,7 +1000,7 @@ record_full_arch_list_add_reg (struct regcache *regcache, int regnum)
 int
 record_full_arch_list_add_mem (CORE_ADDR addr, int len)
 {
-  struct record_full_entry *rec;
+  gdb_byte *loc;
 
   if (record_debug > 1)
     gdb_printf (gdb_stdlog,
@@ -643,37 +1011,28 @@ record_full_arch_list_add_mem (CORE_ADDR addr, int len)
   if (!addr)	/* FIXME: Why?  Some arch must permit it...  */
     return 0;
 
-  rec = record_full_mem_alloc (addr, len);
+  loc = record_full_arch_list_add (record_full_mem, 0, addr, len);
 
-  if (record_read_memory (target_gdbarch (), addr,
-			  record_full_get_loc (rec), len))
+  if (record_read_memory (target_gdbarch (), addr, loc, len))
     {
-      record_full_mem_release (rec);
+      record_full_arch_vals.resize (record_full_arch_list.back ().val);
+      record_full_arch_list.pop_back ();
       return -1;
     }
 
-  record_full_arch_list_add (rec);
-
   return 0;
 }
 
-/* Add a record_full_end type struct record_full_entry to
-   record_full_arch_list.  */
+/* Mark the end of the instruction in record_full_arch_list.  */
 
 int
 record_full_arch_list_add_end (void)
 {
-  struct record_full_entry *rec;
-
   if (record_debug > 1)
     gdb_printf (gdb_stdlog,
 		"Process record: add end to arch list.\n");
 
-  rec = record_full_end_alloc ();
-  rec->u.end.sigval = GDB_SIGNAL_0;
-  rec->u.end.insn_num = ++record_full_insn_count;
-
-  record_full_arch_list_add (rec);
+  ++record_full_insn_count;
 
   return 0;
 }
@@ -697,9 +1056,9 @@ record_full_check_insn_num (void)
 
 /* Before inferior step (when GDB record the running message, inferior
    only can step), GDB will call this function to record the values to
-   record_full_list.  This function will call gdbarch_process_record to
+   the execution log.  This function will call gdbarch_process_record to
    record the running message of inferior and set them to
-   record_full_arch_list, and add it to record_full_list.  */
+   record_full_arch_list, and add it to the log.  */
 
 static void
 record_full_message (struct regcache *regcache, enum gdb_signal signal)
@@ -709,8 +1068,7 @@ record_full_message (struct regcache *regcache, enum gdb_signal signal)
 
   try
     {
-      record_full_arch_list_head = NULL;
-      record_full_arch_list_tail = NULL;
+      record_full_arch_list_clear ();
 
       /* Check record_full_insn_num.  */
       record_full_check_insn_num ();
@@ -738,12 +1096,8 @@ record_full_message (struct regcache *regcache, enum gdb_signal signal)
 	 if we delivered it during the recording.  Therefore we should
 	 record the signal during record_full_wait, not
 	 record_full_resume.  */
-      if (record_full_list != &record_full_first)  /* FIXME better way
-						      to check */
-	{
-	  gdb_assert (record_full_list->type == record_full_end);
-	  record_full_list->u.end.sigval = signal;
-	}
+      if (record_full_insn_num > 0)
+	record_full_set_signal (record_full_pos - 1, signal);
 
       if (signal == GDB_SIGNAL_0
 	  || !gdbarch_process_record_signal_p (gdbarch))
@@ -762,18 +1116,13 @@ record_full_message (struct regcache *regcache, enum gdb_signal signal)
     }
   catch (const gdb_exception &ex)
     {
-      record_full_list_release (record_full_arch_list_tail);
+      record_full_arch_list_clear ();
       throw;
     }
 
-  record_full_list->next = record_full_arch_list_head;
-  record_full_arch_list_head->prev = record_full_list;
-  record_full_list = record_full_arch_list_tail;
-
-  if (record_full_insn_num == record_full_insn_max_num)
+  record_full_log_append ();
+  if (record_full_insn_num > record_full_insn_max_num)
     record_full_list_release_first ();
-  else
-    record_full_insn_num++;
 }
 
 static bool
@@ -808,70 +1157,64 @@ record_full_gdb_operation_disable_set (void)
 static enum target_stop_reason record_full_stop_reason
   = TARGET_STOPPED_BY_NO_REASON;
 
-/* Execute one instruction from the record log.  Each instruction in
-   the log will be represented by an arbitrary sequence of register
-   entries and memory entries, followed by an 'end' entry.  */
+/* Execute one entry of an instruction from the record log.  */
 
 static inline void
-record_full_exec_insn (struct regcache *regcache,
-		       struct gdbarch *gdbarch,
-		       struct record_full_entry *entry)
+record_full_exec_entry (struct regcache *regcache,
+			struct gdbarch *gdbarch,
+			const record_full_entry &entry)
 {
-  switch (entry->type)
+  switch (entry.type)
     {
     case record_full_reg: /* reg */
       {
-	gdb::byte_vector reg (entry->u.reg.len);
+	gdb::byte_vector reg (entry.len);
 
 	if (record_debug > 1)
 	  gdb_printf (gdb_stdlog,
 		      "Process record: record_full_reg %s to "
 		      "inferior num = %d.\n",
-		      host_address_to_string (entry),
-		      entry->u.reg.num);
+		      host_address_to_string (entry.val),
+		      entry.num);
 
-	regcache->cooked_read (entry->u.reg.num, reg.data ());
-	regcache->cooked_write (entry->u.reg.num, record_full_get_loc (entry));
-	memcpy (record_full_get_loc (entry), reg.data (), entry->u.reg.len);
+	regcache->cooked_read (entry.num, reg.data ());
+	regcache->cooked_write (entry.num, entry.val);
+	memcpy (entry.val, reg.data (), entry.len);
       }
       break;
 
     case record_full_mem: /* mem */
       {
 	/* Nothing to do if the entry is flagged not_accessible.  */
-	if (!entry->u.mem.mem_entry_not_accessible)
+	if ((*entry.tag & RECORD_FULL_MEM_NOT_ACCESSIBLE) == 0)
 	  {
-	    gdb::byte_vector mem (entry->u.mem.len);
+	    gdb::byte_vector mem (entry.len);
 
 	    if (record_debug > 1)
 	      gdb_printf (gdb_stdlog,
 			  "Process record: record_full_mem %s to "
 			  "inferior addr = %s len = %d.\n",
-			  host_address_to_string (entry),
-			  paddress (gdbarch, entry->u.mem.addr),
-			  entry->u.mem.len);
+			  host_address_to_string (entry.val),
+			  paddress (gdbarch, entry.addr),
+			  entry.len);
 
 	    if (record_read_memory (gdbarch,
-				    entry->u.mem.addr, mem.data (),
-				    entry->u.mem.len))
-	      entry->u.mem.mem_entry_not_accessible = 1;
+				    entry.addr, mem.data (), entry.len))
+	      *entry.tag |= RECORD_FULL_MEM_NOT_ACCESSIBLE;
 	    else
 	      {
-		if (target_write_memory (entry->u.mem.addr, 
-					 record_full_get_loc (entry),
-					 entry->u.mem.len))
+		if (target_write_memory (entry.addr, entry.val, entry.len))
 		  {
-		    entry->u.mem.mem_entry_not_accessible = 1;
+		    *entry.tag |= RECORD_FULL_MEM_NOT_ACCESSIBLE;
 		    if (record_debug)
 		      warning (_("Process record: error writing memory at "
 				 "addr = %s len = %d."),
-			       paddress (gdbarch, entry->u.mem.addr),
-			       entry->u.mem.len);
+			       paddress (gdbarch, entry.addr),
+			       entry.len);
 		  }
 		else
 		  {
-		    memcpy (record_full_get_loc (entry), mem.data (),
-			    entry->u.mem.len);
+		    memcpy (entry.val, mem.data (), entry.len);
 
 		    /* We've changed memory --- check if a hardware
 		       watchpoint should trap.  Note that this
@@ -882,8 +1225,7 @@ record_full_exec_insn (struct regcache *regcache,
 		       not doing the change at all if the watchpoint
 		       traps.  */
 		    if (hardware_watchpoint_inserted_in_range
-			(regcache->aspace (),
-			 entry->u.mem.addr, entry->u.mem.len))
+			(regcache->aspace (), entry.addr, entry.len))
 		      record_full_stop_reason = TARGET_STOPPED_BY_WATCHPOINT;
 		  }
 	      }
@@ -893,6 +1235,29 @@ record_full_exec_insn (struct regcache *regcache,
     }
 }
 
+/* Execute instruction NUM of the record log, in direction DIR.  Going
+   backward, the entries of the instruction are executed in reverse
+   order.  */
+
+static void
+record_full_exec_insn (struct regcache *regcache,
+		       struct gdbarch *gdbarch,
+		       ULONGEST num, enum exec_direction_kind dir)
+{
+  /* Reused across calls, to avoid an allocation per instruction.  */
+  static std::vector<record_full_entry> entries;
+
+  record_full_chunk &chunk = record_full_decode_insn (num, entries);
+  chunk.dirty = true;
+
+  if (dir == EXEC_REVERSE)
+    for (auto it = entries.rbegin (); it != entries.rend (); ++it)
+      record_full_exec_entry (regcache, gdbarch, *it);
+  else
+    for (const record_full_entry &entry : entries)
+      record_full_exec_entry (regcache, gdbarch, entry);
+}
+
 static void record_full_restore (void);
 
 /* Asynchronous signal handle registered as event loop source for when
@@ -963,10 +1328,9 @@ record_full_open (const char *name, int from_tty)
   record_preopen ();
 
   /* Reset */
-  record_full_insn_num = 0;
+  record_full_list_release ();
   record_full_insn_count = 0;
-  record_full_list = &record_full_first;
-  record_full_list->next = NULL;
+  record_full_pos = record_full_log_end ();
 
   if (core_bfd)
     record_full_core_open_1 (name, from_tty);
@@ -993,7 +1357,7 @@ record_full_base_target::close ()
   if (record_debug)
     gdb_printf (gdb_stdlog, "Process record: record_full_close\n");
 
-  record_full_list_release (record_full_list);
+  record_full_list_release ();
 
   /* Release record_full_core_regbuf.  */
   if (record_full_core_regbuf)
@@ -1281,165 +1645,126 @@ record_full_wait_1 (struct target_ops *ops,
       struct gdbarch *gdbarch = regcache->arch ();
       const struct address_space *aspace = regcache->aspace ();
       int continue_flag = 1;
-      int first_record_full_end = 1;
+      CORE_ADDR tmp_pc;
 
-      try
+      record_full_stop_reason = TARGET_STOPPED_BY_NO_REASON;
+      status->set_stopped (GDB_SIGNAL_0);
+
+      /* Check breakpoint when forward execute.  */
+      if (execution_direction == EXEC_FORWARD)
 	{
-	  CORE_ADDR tmp_pc;
+	  tmp_pc = regcache_read_pc (regcache);
+	  if (record_check_stopped_by_breakpoint (aspace, tmp_pc,
+						  &record_full_stop_reason))
+	    {
+	      if (record_debug)
+		gdb_printf (gdb_stdlog,
+			    "Process record: break at %s.\n",
+			    paddress (gdbarch, tmp_pc));
+	      goto replay_out;
+	    }
+	}
 
-	  record_full_stop_reason = TARGET_STOPPED_BY_NO_REASON;
-	  status->set_stopped (GDB_SIGNAL_0);
+      /* If GDB is in terminal_inferior mode, it will not get the
+	 signal.  And in GDB replay mode, GDB doesn't need to be
+	 in terminal_inferior mode, because inferior will not
+	 executed.  Then set it to terminal_ours to make GDB get
+	 the signal.  */
+      target_terminal::ours ();
 
-	  /* Check breakpoint when forward execute.  */
-	  if (execution_direction == EXEC_FORWARD)
+      /* Loop over the execution log, one instruction at a time, looking
+	 for the next place to stop.  */
+      do
+	{
+	  /* Check for beginning and end of log.  */
+	  if (execution_direction == EXEC_REVERSE
+	      && record_full_pos == record_full_log_begin ())
 	    {
-	      tmp_pc = regcache_read_pc (regcache);
-	      if (record_check_stopped_by_breakpoint (aspace, tmp_pc,
-						      &record_full_stop_reason))
-		{
-		  if (record_debug)
-		    gdb_printf (gdb_stdlog,
-				"Process record: break at %s.\n",
-				paddress (gdbarch, tmp_pc));
-		  goto replay_out;
-		}
+	      /* Hit beginning of record log in reverse.  */
+	      status->set_no_history ();
+	      break;
 	    }
-
-	  /* If GDB is in terminal_inferior mode, it will not get the
-	     signal.  And in GDB replay mode, GDB doesn't need to be
-	     in terminal_inferior mode, because inferior will not
-	     executed.  Then set it to terminal_ours to make GDB get
-	     the signal.  */
-	  target_terminal::ours ();
-
-	  /* In EXEC_FORWARD mode, record_full_list points to the tail of prev
-	     instruction.  */
-	  if (execution_direction == EXEC_FORWARD && record_full_list->next)
-	    record_full_list = record_full_list->next;
-
-	  /* Loop over the record_full_list, looking for the next place to
-	     stop.  */
-	  do
+	  if (execution_direction != EXEC_REVERSE
+	      && record_full_pos == record_full_log_end ())
 	    {
-	      /* Check for beginning and end of log.  */
-	      if (execution_direction == EXEC_REVERSE
-		  && record_full_list == &record_full_first)
-		{
-		  /* Hit beginning of record log in reverse.  */
-		  status->set_no_history ();
-		  break;
-		}
-	      if (execution_direction != EXEC_REVERSE
-		  && !record_full_list->next)
-		{
-		  /* Hit end of record log going forward.  */
-		  status->set_no_history ();
-		  break;
-		}
+	      /* Hit end of record log going forward.  */
+	      status->set_no_history ();
+	      break;
+	    }
 
-	      record_full_exec_insn (regcache, gdbarch, record_full_list);
+	  if (execution_direction == EXEC_REVERSE)
+	    {
+	      record_full_exec_insn (regcache, gdbarch, record_full_pos - 1,
+				     EXEC_REVERSE);
+	      record_full_pos--;
+	    }
+	  else
+	    {
+	      record_full_exec_insn (regcache, gdbarch, record_full_pos,
+				     EXEC_FORWARD);
+	      record_full_pos++;
+	    }
 
-	      if (record_full_list->type == record_full_end)
-		{
-		  if (record_debug > 1)
-		    gdb_printf
-		      (gdb_stdlog,
-		       "Process record: record_full_end %s to "
-		       "inferior.\n",
-		       host_address_to_string (record_full_list));
-
-		  if (first_record_full_end
-		      && execution_direction == EXEC_REVERSE)
-		    {
-		      /* When reverse execute, the first
-			 record_full_end is the part of current
-			 instruction.  */
-		      first_record_full_end = 0;
-		    }
-		  else
-		    {
-		      /* In EXEC_REVERSE mode, this is the
-			 record_full_end of prev instruction.  In
-			 EXEC_FORWARD mode, this is the
-			 record_full_end of current instruction.  */
-		      /* step */
-		      if (record_full_resume_step)
-			{
-			  if (record_debug > 1)
-			    gdb_printf (gdb_stdlog,
-					"Process record: step.\n");
-			  continue_flag = 0;
-			}
+	  /* There is nothing left to look at when reaching either end of
+	     the log; the check at the top of the loop reports it.  */
+	  if (record_full_pos == (execution_direction == EXEC_REVERSE
+				  ? record_full_log_begin ()
+				  : record_full_log_end ()))
+	    continue;
 
-		      /* check breakpoint */
-		      tmp_pc = regcache_read_pc (regcache);
-		      if (record_check_stopped_by_breakpoint
-			  (aspace, tmp_pc, &record_full_stop_reason))
-			{
-			  if (record_debug)
-			    gdb_printf (gdb_stdlog,
-					"Process record: break "
-					"at %s.\n",
-					paddress (gdbarch, tmp_pc));
+	  if (record_debug > 1)
+	    gdb_printf (gdb_stdlog,
+			"Process record: end of insn %s to inferior.\n",
+			pulongest (record_full_pos - 1));
 
-			  continue_flag = 0;
-			}
+	  /* step */
+	  if (record_full_resume_step)
+	    {
+	      if (record_debug > 1)
+		gdb_printf (gdb_stdlog, "Process record: step.\n");
+	      continue_flag = 0;
+	    }
 
-		      if (record_full_stop_reason
-			  == TARGET_STOPPED_BY_WATCHPOINT)
-			{
-			  if (record_debug)
-			    gdb_printf (gdb_stdlog,
-					"Process record: hit hw "
-					"watchpoint.\n");
-			  continue_flag = 0;
-			}
-		      /* Check target signal */
-		      if (record_full_list->u.end.sigval != GDB_SIGNAL_0)
-			/* FIXME: better way to check */
-			continue_flag = 0;
-		    }
-		}
+	  /* check breakpoint */
+	  tmp_pc = regcache_read_pc (regcache);
+	  if (record_check_stopped_by_breakpoint
+	      (aspace, tmp_pc, &record_full_stop_reason))
+	    {
+	      if (record_debug)
+		gdb_printf (gdb_stdlog,
+			    "Process record: break at %s.\n",
+			    paddress (gdbarch, tmp_pc));
 
-	      if (continue_flag)
-		{
-		  if (execution_direction == EXEC_REVERSE)
-		    {
-		      if (record_full_list->prev)
-			record_full_list = record_full_list->prev;
-		    }
-		  else
-		    {
-		      if (record_full_list->next)
-			record_full_list = record_full_list->next;
-		    }
-		}
+	      continue_flag = 0;
 	    }
-	  while (continue_flag);
 
-	replay_out:
-	  if (status->kind () == TARGET_WAITKIND_STOPPED)
+	  if (record_full_stop_reason == TARGET_STOPPED_BY_WATCHPOINT)
 	    {
-	      if (record_full_get_sig)
-		status->set_stopped (GDB_SIGNAL_INT);
-	      else if (record_full_list->u.end.sigval != GDB_SIGNAL_0)
-		/* FIXME: better way to check */
-		status->set_stopped (record_full_list->u.end.sigval);
-	      else
-		status->set_stopped (GDB_SIGNAL_TRAP);
+	      if (record_debug)
+		gdb_printf (gdb_stdlog,
+			    "Process record: hit hw watchpoint.\n");
+	      continue_flag = 0;
 	    }
+	  /* Check target signal */
+	  if (record_full_get_signal (record_full_pos - 1) != GDB_SIGNAL_0)
+	    /* FIXME: better way to check */
+	    continue_flag = 0;
 	}
-      catch (const gdb_exception &ex)
+      while (continue_flag);
+
+    replay_out:
+      if (status->kind () == TARGET_WAITKIND_STOPPED)
 	{
-	  if (execution_direction == EXEC_REVERSE)
-	    {
-	      if (record_full_list->next)
-		record_full_list = record_full_list->next;
-	    }
+	  enum gdb_signal sigval
+	    = record_full_get_signal (record_full_pos_insn (record_full_pos));
+
+	  if (record_full_get_sig)
+	    status->set_stopped (GDB_SIGNAL_INT);
+	  else if (sigval != GDB_SIGNAL_0)
+	    /* FIXME: better way to check */
+	    status->set_stopped (sigval);
 	  else
-	    record_full_list = record_full_list->prev;
-
-	  throw;
+	    status->set_stopped (GDB_SIGNAL_TRAP);
 	}
     }
 
@@ -1527,8 +1852,7 @@ record_full_registers_change (struct regcache *regcache, int regnum)
   /* Check record_full_insn_num.  */
   record_full_check_insn_num ();
 
-  record_full_arch_list_head = NULL;
-  record_full_arch_list_tail = NULL;
+  record_full_arch_list_clear ();
 
   if (regnum < 0)
     {
@@ -1538,7 +1862,7 @@ record_full_registers_change (struct regcache *regcache, int regnum)
 	{
 	  if (record_full_arch_list_add_reg (regcache, i))
 	    {
-	      record_full_list_release (record_full_arch_list_tail);
+	      record_full_arch_list_clear ();
 	      error (_("Process record: failed to record execution log."));
 	    }
 	}
@@ -1547,23 +1871,18 @@ record_full_registers_change (struct regcache *regcache, int regnum)
     {
       if (record_full_arch_list_add_reg (regcache, regnum))
 	{
-	  record_full_list_release (record_full_arch_list_tail);
+	  record_full_arch_list_clear ();
 	  error (_("Process record: failed to record execution log."));
 	}
     }
   if (record_full_arch_list_add_end ())
     {
-      record_full_list_release (record_full_arch_list_tail);
+      record_full_arch_list_clear ();
       error (_("Process record: failed to record execution log."));
     }
-  record_full_list->next = record_full_arch_list_head;
-  record_full_arch_list_head->prev = record_full_list;
-  record_full_list = record_full_arch_list_tail;
-
-  if (record_full_insn_num == record_full_insn_max_num)
+  record_full_log_append ();
+  if (record_full_insn_num > record_full_insn_max_num)
     record_full_list_release_first ();
-  else
-    record_full_insn_num++;
 }
 
 /* "store_registers" method for process record target.  */
@@ -1612,7 +1931,7 @@ record_full_target::store_registers (struct regcache *regcache, int regno)
 	    }
 
 	  /* Destroy the record from here forward.  */
-	  record_full_list_release_following (record_full_list);
+	  record_full_list_release_following (record_full_pos);
 	}
 
       record_full_registers_change (regcache, regno);
@@ -1645,18 +1964,17 @@ record_full_target::xfer_partial (enum target_object object,
 	    error (_("Process record canceled the operation."));
 
 	  /* Destroy the record from here forward.  */
-	  record_full_list_release_following (record_full_list);
+	  record_full_list_release_following (record_full_pos);
 	}
 
       /* Check record_full_insn_num */
       record_full_check_insn_num ();
 
       /* Record registers change to list as an instruction.  */
-      record_full_arch_list_head = NULL;
-      record_full_arch_list_tail = NULL;
+      record_full_arch_list_clear ();
       if (record_full_arch_list_add_mem (offset, len))
 	{
-	  record_full_list_release (record_full_arch_list_tail);
+	  record_full_arch_list_clear ();
 	  if (record_debug)
 	    gdb_printf (gdb_stdlog,
 			"Process record: failed to record "
@@ -1665,21 +1983,16 @@ record_full_target::xfer_partial (enum target_object object,
 	}
       if (record_full_arch_list_add_end ())
 	{
-	  record_full_list_release (record_full_arch_list_tail);
+	  record_full_arch_list_clear ();
 	  if (record_debug)
 	    gdb_printf (gdb_stdlog,
 			"Process record: failed to record "
 			"execution log.");
 	  return TARGET_XFER_E_IO;
 	}
-      record_full_list->next = record_full_arch_list_head;
-      record_full_arch_list_head->prev = record_full_list;
-      record_full_list = record_full_arch_list_tail;
-
-      if (record_full_insn_num == record_full_insn_max_num)
+      record_full_log_append ();
+      if (record_full_insn_num > record_full_insn_max_num)
 	record_full_list_release_first ();
-      else
-	record_full_insn_num++;
     }
 
   return this->beneath ()->xfer_partial (object, annex, readbuf, writebuf,
@@ -1836,8 +2149,7 @@ record_full_base_target::get_bookmark (const char *args, int from_tty)
   char *ret = NULL;
 
   /* Return stringified form of instruction count.  */
-  if (record_full_list && record_full_list->type == record_full_end)
-    ret = xstrdup (pulongest (record_full_list->u.end.insn_num));
+  ret = xstrdup (pulongest (record_full_pos_insn (record_full_pos)));
 
   if (record_debug)
     {
@@ -1893,30 +2205,22 @@ record_full_base_target::record_method (ptid_t ptid)
 void
 record_full_base_target::info_record ()
 {
-  struct record_full_entry *p;
-
   if (RECORD_FULL_IS_REPLAY)
     gdb_printf (_("Replay mode:\n"));
   else
     gdb_printf (_("Record mode:\n"));
 
-  /* Find entry for first actual instruction in the log.  */
-  for (p = record_full_first.next;
-       p != NULL && p->type != record_full_end;
-       p = p->next)
-    ;
-
   /* Do we have a log at all?  */
-  if (p != NULL && p->type == record_full_end)
+  if (record_full_insn_num > 0)
     {
       /* Display instruction number for first instruction in the log.  */
       gdb_printf (_("Lowest recorded instruction number is %s.\n"),
-		  pulongest (p->u.end.insn_num));
+		  pulongest (record_full_log_begin ()));
 
       /* If in replay mode, display where we are in the log.  */
       if (RECORD_FULL_IS_REPLAY)
 	gdb_printf (_("Current instruction number is %s.\n"),
-		    pulongest (record_full_list->u.end.insn_num));
+		    pulongest (record_full_pos_insn (record_full_pos)));
 
       /* Display instruction number for last instruction in the log.  */
       gdb_printf (_("Highest recorded instruction number is %s.\n"),
@@ -1925,6 +2229,22 @@ record_full_base_target::info_record ()
       /* Display log count.  */
       gdb_printf (_("Log contains %u instructions.\n"),
 		  record_full_insn_num);
+
+      /* Display where the log is kept, when it may be spilled.  */
+      if (record_full_spill_threshold >= 0)
+	{
+	  ULONGEST in_memory = 0, on_disk = 0;
+
+	  for (const record_full_chunk &chunk : record_full_chunks)
+	    if (chunk.resident)
+	      in_memory += chunk.data.capacity ();
+	    else
+	      on_disk += chunk.size;
+
+	  gdb_printf (_("Log occupies %s bytes in memory and %s bytes "
+			"in the spill file.\n"),
+		      pulongest (in_memory), pulongest (on_disk));
+	}
     }
   else
     gdb_printf (_("No instructions have been logged.\n"));
@@ -1945,7 +2265,7 @@ record_full_base_target::supports_delete_record ()
 void
 record_full_base_target::delete_record ()
 {
-  record_full_list_release_following (record_full_list);
+  record_full_list_release_following (record_full_pos);
 }
 
 /* The "record_is_replaying" target method.  */
@@ -1968,26 +2288,24 @@ record_full_base_target::record_will_replay (ptid_t ptid, int dir)
   return RECORD_FULL_IS_REPLAY || dir == EXEC_REVERSE;
 }
 
-/* Go to a specific entry.  */
+/* Go to position POS of the log.  */
 
 static void
-record_full_goto_entry (struct record_full_entry *p)
+record_full_goto_entry (ULONGEST pos)
 {
-  if (p == NULL)
-    error (_("Target insn not found."));
-  else if (p == record_full_list)
+  if (pos == record_full_pos)
     error (_("Already at target insn."));
-  else if (p->u.end.insn_num > record_full_list->u.end.insn_num)
+  else if (pos > record_full_pos)
     {
       gdb_printf (_("Go forward to insn number %s\n"),
-		  pulongest (p->u.end.insn_num));
-      record_full_goto_insn (p, EXEC_FORWARD);
+		  pulongest (record_full_pos_insn (pos)));
+      record_full_goto_insn (pos, EXEC_FORWARD);
     }
   else
     {
       gdb_printf (_("Go backward to insn number %s\n"),
-		  pulongest (p->u.end.insn_num));
-      record_full_goto_insn (p, EXEC_REVERSE);
+		  pulongest (record_full_pos_insn (pos)));
+      record_full_goto_insn (pos, EXEC_REVERSE);
     }
 
   registers_changed ();
@@ -2001,13 +2319,7 @@ record_full_goto_entry (struct record_full_entry *p)
 void
 record_full_base_target::goto_record_begin ()
 {
-  struct record_full_entry *p = NULL;
-
-  for (p = &record_full_first; p != NULL; p = p->next)
-    if (p->type == record_full_end)
-      break;
-
-  record_full_goto_entry (p);
+  record_full_goto_entry (record_full_log_begin ());
 }
 
 /* The "goto_record_end" target method.  */
@@ -2015,15 +2327,7 @@ record_full_base_target::goto_record_begin ()
 void
 record_full_base_target::goto_record_end ()
 {
-  struct record_full_entry *p = NULL;
-
-  for (p = record_full_list; p->next != NULL; p = p->next)
-    ;
-  for (; p!= NULL; p = p->prev)
-    if (p->type == record_full_end)
-      break;
-
-  record_full_goto_entry (p);
+  record_full_goto_entry (record_full_log_end ());
 }
 
 /* The "goto_record" target method.  */
@@ -2031,13 +2335,14 @@ record_full_base_target::goto_record_end ()
 void
 record_full_base_target::goto_record (ULONGEST target_insn)
 {
-  struct record_full_entry *p = NULL;
-
-  for (p = &record_full_first; p != NULL; p = p->next)
-    if (p->type == record_full_end && p->u.end.insn_num == target_insn)
-      break;
-
-  record_full_goto_entry (p);
+  /* Instruction number zero is the beginning of the log.  */
+  if (target_insn == 0)
+    record_full_goto_entry (record_full_log_begin ());
+  else if (target_insn >= record_full_log_begin ()
+	   && target_insn < record_full_log_end ())
+    record_full_goto_entry (target_insn + 1);
+  else
+    error (_("Target insn not found."));
 }
 
 /* The "record_stop_replaying" target method.  */
@@ -2309,7 +2614,6 @@ static void
 record_full_restore (void)
 {
   uint32_t magic;
-  struct record_full_entry *rec;
   asection *osec;
   uint32_t osec_size;
   int bfd_offset = 0;
@@ -2321,7 +2625,7 @@ record_full_restore (void)
     return;
 
   /* "record_full_restore" can only be called when record list is empty.  */
-  gdb_assert (record_full_first.next == NULL);
+  gdb_assert (record_full_chunks.empty ());
  
   if (record_debug)
     gdb_printf (gdb_stdlog, "Restoring recording from core file.\n");
@@ -2348,11 +2652,9 @@ record_full_restore (void)
 		"RECORD_FULL_FILE_MAGIC (0x%s)\n",
 		phex_nz (netorder32 (magic), 4));
 
-  /* Restore the entries in recfd into record_full_arch_list_head and
-     record_full_arch_list_tail.  */
-  record_full_arch_list_head = NULL;
-  record_full_arch_list_tail = NULL;
-  record_full_insn_num = 0;
+  /* Restore the entries in recfd into record_full_arch_list, and add
+     each instruction to the log.  */
+  record_full_arch_list_clear ();
 
   try
     {
@@ -2363,6 +2665,7 @@ record_full_restore (void)
 	  uint8_t rectype;
 	  uint32_t regnum, len, signal, count;
 	  uint64_t addr;
+	  gdb_byte *loc;
 
 	  /* We are finished when offset reaches osec_size.  */
 	  if (bfd_offset >= osec_size)
@@ -2377,19 +2680,19 @@ record_full_restore (void)
 			    sizeof (regnum), &bfd_offset);
 	      regnum = netorder32 (regnum);
 
-	      rec = record_full_reg_alloc (regcache, regnum);
+	      len = register_size (regcache->arch (), regnum);
+	      loc = record_full_arch_list_add (record_full_reg, regnum, 0, len);
 
 	      /* Get val.  */
-	      bfdcore_read (core_bfd, osec, record_full_get_loc (rec),
-			    rec->u.reg.len, &bfd_offset);
+	      bfdcore_read (core_bfd, osec, loc, len, &bfd_offset);
 
 	      if (record_debug)
 		gdb_printf (gdb_stdlog,
 			    "  Reading register %d (1 "
 			    "plus %lu plus %d bytes)\n",
-			    rec->u.reg.num,
+			    regnum,
 			    (unsigned long) sizeof (regnum),
-			    rec->u.reg.len);
+			    len);
 	      break;
 
 	    case record_full_mem: /* mem */
@@ -2403,38 +2706,39 @@ record_full_restore (void)
 			    sizeof (addr), &bfd_offset);
 	      addr = netorder64 (addr);
 
-	      rec = record_full_mem_alloc (addr, len);
+	      loc = record_full_arch_list_add (record_full_mem, 0, addr, len);
 
 	      /* Get val.  */
-	      bfdcore_read (core_bfd, osec, record_full_get_loc (rec),
-			    rec->u.mem.len, &bfd_offset);
+	      bfdcore_read (core_bfd, osec, loc, len, &bfd_offset);
 
 	      if (record_debug)
 		gdb_printf (gdb_stdlog,
 			    "  Reading memory %s (1 plus "
 			    "%lu plus %lu plus %d bytes)\n",
-			    paddress (get_current_arch (),
-				      rec->u.mem.addr),
+			    paddress (get_current_arch (), addr),
 			    (unsigned long) sizeof (addr),
 			    (unsigned long) sizeof (len),
-			    rec->u.mem.len);
+			    len);
 	      break;
 
 	    case record_full_end: /* end */
-	      rec = record_full_end_alloc ();
-	      record_full_insn_num ++;
-
 	      /* Get signal value.  */
 	      bfdcore_read (core_bfd, osec, &signal,
 			    sizeof (signal), &bfd_offset);
 	      signal = netorder32 (signal);
-	      rec->u.end.sigval = (enum gdb_signal) signal;
 
 	      /* Get insn count.  */
 	      bfdcore_read (core_bfd, osec, &count,
 			    sizeof (count), &bfd_offset);
 	      count = netorder32 (count);
-	      rec->u.end.insn_num = count;
+
+	      /* Number the first instruction as it was numbered when
+		 saved; the next ones follow it.  */
+	      if (record_full_chunks.empty ())
+		record_full_insn_count = count - 1;
+	      record_full_log_append ();
+	      record_full_set_signal (record_full_pos - 1,
+				      (enum gdb_signal) signal);
 	      record_full_insn_count = count + 1;
 	      if (record_debug)
 		gdb_printf (gdb_stdlog,
@@ -2451,22 +2755,17 @@ record_full_restore (void)
 		     bfd_get_filename (core_bfd));
 	      break;
 	    }
-
-	  /* Add rec to record arch list.  */
-	  record_full_arch_list_add (rec);
 	}
     }
   catch (const gdb_exception &ex)
     {
-      record_full_list_release (record_full_arch_list_tail);
+      record_full_list_release ();
       throw;
     }
 
-  /* Add record_full_arch_list_head to the end of record list.  */
-  record_full_first.next = record_full_arch_list_head;
-  record_full_arch_list_head->prev = &record_full_first;
-  record_full_arch_list_tail->next = NULL;
-  record_full_list = &record_full_first;
+  /* Start replaying from the beginning of the log.  */
+  record_full_arch_list_clear ();
+  record_full_pos = record_full_log_begin ();
 
   /* Update record_full_insn_max_num.  */
   if (record_full_insn_num > record_full_insn_max_num)
@@ -2514,13 +2813,14 @@ cmd_record_full_restore (const char *args, int from_tty)
 void
 record_full_base_target::save_record (const char *recfilename)
 {
-  struct record_full_entry *cur_record_full_list;
+  ULONGEST cur_record_full_pos;
   uint32_t magic;
   struct regcache *regcache;
   struct gdbarch *gdbarch;
   int save_size = 0;
   asection *osec = NULL;
   int bfd_offset = 0;
+  std::vector<record_full_entry> entries;
 
   /* Open the save file.  */
   if (record_debug)
@@ -2533,8 +2833,8 @@ record_full_base_target::save_record (const char *recfilename)
   /* Arrange to remove the output file on failure.  */
   gdb::unlinker unlink_file (recfilename);
 
-  /* Save the current record entry to "cur_record_full_list".  */
-  cur_record_full_list = record_full_list;
+  /* Save the current position in the log to "cur_record_full_pos".  */
+  cur_record_full_pos = record_full_pos;
 
   /* Get the values of regcache and gdbarch.  */
   regcache = get_current_regcache ();
@@ -2545,34 +2845,23 @@ record_full_base_target::save_record (const char *recfilename)
     = record_full_gdb_operation_disable_set ();
 
   /* Reverse execute to the begin of record list.  */
-  while (1)
-    {
-      /* Check for beginning and end of log.  */
-      if (record_full_list == &record_full_first)
-	break;
-
-      record_full_exec_insn (regcache, gdbarch, record_full_list);
-
-      if (record_full_list->prev)
-	record_full_list = record_full_list->prev;
-    }
+  for (; record_full_pos > record_full_log_begin (); record_full_pos--)
+    record_full_exec_insn (regcache, gdbarch, record_full_pos - 1,
+			   EXEC_REVERSE);
 
   /* Compute the size needed for the extra bfd section.  */
   save_size = 4;	/* magic cookie */
-  for (record_full_list = record_full_first.next; record_full_list;
-       record_full_list = record_full_list->next)
-    switch (record_full_list->type)
-      {
-      case record_full_end:
-	save_size += 1 + 4 + 4;
-	break;
-      case record_full_reg:
-	save_size += 1 + 4 + record_full_list->u.reg.len;
-	break;
-      case record_full_mem:
-	save_size += 1 + 4 + 8 + record_full_list->u.mem.len;
-	break;
-      }
+  for (ULONGEST num = record_full_log_begin ();
+       num < record_full_log_end (); num++)
+    {
+      record_full_decode_insn (num, entries);
+      for (const record_full_entry &entry : entries)
+	if (entry.type == record_full_reg)
+	  save_size += 1 + 4 + entry.len;
+	else
+	  save_size += 1 + 4 + 8 + entry.len;
+      save_size += 1 + 4 + 4;
+    }
 
   /* Make the new bfd section.  */
   osec = bfd_make_section_anyway_with_flags (obfd.get (), "precord",
@@ -2601,39 +2890,38 @@ record_full_base_target::save_record (const char *recfilename)
 
   /* Save the entries to recfd and forward execute to the end of
      record list.  */
-  record_full_list = &record_full_first;
-  while (1)
+  for (; record_full_pos < record_full_log_end (); record_full_pos++)
     {
-      /* Save entry.  */
-      if (record_full_list != &record_full_first)
-	{
-	  uint8_t type;
-	  uint32_t regnum, len, signal, count;
-	  uint64_t addr;
+      uint8_t type;
+      uint32_t regnum, len, signal, count;
+      uint64_t addr;
 
-	  type = record_full_list->type;
+      /* Save entries.  */
+      record_full_decode_insn (record_full_pos, entries);
+      for (const record_full_entry &entry : entries)
+	{
+	  type = entry.type;
 	  bfdcore_write (obfd.get (), osec, &type, sizeof (type), &bfd_offset);
 
-	  switch (record_full_list->type)
+	  switch (entry.type)
 	    {
 	    case record_full_reg: /* reg */
 	      if (record_debug)
 		gdb_printf (gdb_stdlog,
 			    "  Writing register %d (1 "
 			    "plus %lu plus %d bytes)\n",
-			    record_full_list->u.reg.num,
+			    entry.num,
 			    (unsigned long) sizeof (regnum),
-			    record_full_list->u.reg.len);
+			    entry.len);
 
 	      /* Write regnum.  */
-	      regnum = netorder32 (record_full_list->u.reg.num);
+	      regnum = netorder32 (entry.num);
 	      bfdcore_write (obfd.get (), osec, &regnum,
 			     sizeof (regnum), &bfd_offset);
 
 	      /* Write regval.  */
-	      bfdcore_write (obfd.get (), osec,
-			     record_full_get_loc (record_full_list),
-			     record_full_list->u.reg.len, &bfd_offset);
+	      bfdcore_write (obfd.get (), osec, entry.val, entry.len,
+			     &bfd_offset);
 	      break;
 
 	    case record_full_mem: /* mem */
@@ -2641,69 +2929,57 @@ record_full_base_target::save_record (const char *recfilename)
 		gdb_printf (gdb_stdlog,
 			    "  Writing memory %s (1 plus "
 			    "%lu plus %lu plus %d bytes)\n",
-			    paddress (gdbarch,
-				      record_full_list->u.mem.addr),
+			    paddress (gdbarch, entry.addr),
 			    (unsigned long) sizeof (addr),
 			    (unsigned long) sizeof (len),
-			    record_full_list->u.mem.len);
+			    entry.len);
 
 	      /* Write memlen.  */
-	      len = netorder32 (record_full_list->u.mem.len);
+	      len = netorder32 (entry.len);
 	      bfdcore_write (obfd.get (), osec, &len, sizeof (len),
 			     &bfd_offset);
 
 	      /* Write memaddr.  */
-	      addr = netorder64 (record_full_list->u.mem.addr);
+	      addr = netorder64 (entry.addr);
 	      bfdcore_write (obfd.get (), osec, &addr, 
 			     sizeof (addr), &bfd_offset);
 
 	      /* Write memval.  */
-	      bfdcore_write (obfd.get (), osec,
-			     record_full_get_loc (record_full_list),
-			     record_full_list->u.mem.len, &bfd_offset);
+	      bfdcore_write (obfd.get (), osec, entry.val, entry.len,
+			     &bfd_offset);
 	      break;
-
-	      case record_full_end:
-		if (record_debug)
-		  gdb_printf (gdb_stdlog,
-			      "  Writing record_full_end (1 + "
-			      "%lu + %lu bytes)\n", 
-			      (unsigned long) sizeof (signal),
-			      (unsigned long) sizeof (count));
-		/* Write signal value.  */
-		signal = netorder32 (record_full_list->u.end.sigval);
-		bfdcore_write (obfd.get (), osec, &signal,
-			       sizeof (signal), &bfd_offset);
-
-		/* Write insn count.  */
-		count = netorder32 (record_full_list->u.end.insn_num);
-		bfdcore_write (obfd.get (), osec, &count,
-			       sizeof (count), &bfd_offset);
-		break;
 	    }
 	}
 
-      /* Execute entry.  */
-      record_full_exec_insn (regcache, gdbarch, record_full_list);
+      /* Execute the instruction.  */
+      record_full_exec_insn (regcache, gdbarch, record_full_pos,
+			     EXEC_FORWARD);
 
-      if (record_full_list->next)
-	record_full_list = record_full_list->next;
-      else
-	break;
+      /* Save the end of the instruction.  */
+      if (record_debug)
+	gdb_printf (gdb_stdlog,
+		    "  Writing record_full_end (1 + "
+		    "%lu + %lu bytes)\n", 
+		    (unsigned long) sizeof (signal),
+		    (unsigned long) sizeof (count));
+      type = record_full_end;
+      bfdcore_write (obfd.get (), osec, &type, sizeof (type), &bfd_offset);
+
+      /* Write signal value.  */
+      signal = netorder32 (record_full_get_signal (record_full_pos));
+      bfdcore_write (obfd.get (), osec, &signal,
+		     sizeof (signal), &bfd_offset);
+
+      /* Write insn count.  */
+      count = netorder32 (record_full_pos);
+      bfdcore_write (obfd.get (), osec, &count,
+		     sizeof (count), &bfd_offset);
     }
 
-  /* Reverse execute to cur_record_full_list.  */
-  while (1)
-    {
-      /* Check for beginning and end of log.  */
-      if (record_full_list == cur_record_full_list)
-	break;
-
-      record_full_exec_insn (regcache, gdbarch, record_full_list);
-
-      if (record_full_list->prev)
-	record_full_list = record_full_list->prev;
-    }
+  /* Reverse execute to cur_record_full_pos.  */
+  for (; record_full_pos > cur_record_full_pos; record_full_pos--)
+    record_full_exec_insn (regcache, gdbarch, record_full_pos - 1,
+			   EXEC_REVERSE);
 
   unlink_file.keep ();
 
@@ -2713,32 +2989,28 @@ record_full_base_target::save_record (const char *recfilename)
 }
 
 /* record_full_goto_insn -- rewind the record log (forward or backward,
-   depending on DIR) to the given entry, changing the program state
+   depending on DIR) to position POS, changing the program state
    correspondingly.  */
 
 static void
-record_full_goto_insn (struct record_full_entry *entry,
-		       enum exec_direction_kind dir)
+record_full_goto_insn (ULONGEST pos, enum exec_direction_kind dir)
 {
   scoped_restore restore_operation_disable
     = record_full_gdb_operation_disable_set ();
   struct regcache *regcache = get_current_regcache ();
   struct gdbarch *gdbarch = regcache->arch ();
 
-  /* Assume everything is valid: we will hit the entry,
+  /* Assume everything is valid: we will hit the position,
      and we will not hit the end of the recording.  */
 
   if (dir == EXEC_FORWARD)
-    record_full_list = record_full_list->next;
-
-  do
-    {
-      record_full_exec_insn (regcache, gdbarch, record_full_list);
-      if (dir == EXEC_REVERSE)
-	record_full_list = record_full_list->prev;
-      else
-	record_full_list = record_full_list->next;
-    } while (record_full_list != entry);
+    for (; record_full_pos < pos; record_full_pos++)
+      record_full_exec_insn (regcache, gdbarch, record_full_pos,
+			     EXEC_FORWARD);
+  else
+    for (; record_full_pos > pos; record_full_pos--)
+      record_full_exec_insn (regcache, gdbarch, record_full_pos - 1,
+			     EXEC_REVERSE);
 }
 
 /* Alias for "target record-full".  */
@@ -2753,15 +3025,18 @@ static void
 set_record_full_insn_max_num (const char *args, int from_tty,
 			      struct cmd_list_element *c)
 {
-  if (record_full_insn_num > record_full_insn_max_num)
-    {
-      /* Count down record_full_insn_num while releasing records from list.  */
-      while (record_full_insn_num > record_full_insn_max_num)
-       {
-	 record_full_list_release_first ();
-	 record_full_insn_num--;
-       }
-    }
+  while (record_full_insn_num > record_full_insn_max_num)
+    record_full_list_release_first ();
+}
+
+/* "set record full spill-threshold" command.  Spill the log right
+   away if it no longer fits.  */
+
+static void
+set_record_full_spill_threshold (const char *args, int from_tty,
+				 struct cmd_list_element *c)
+{
+  record_full_spill (nullptr);
 }
 
 void _initialize_record_full ();
@@ -2770,11 +3045,6 @@ _initialize_record_full ()
 {
   struct cmd_list_element *c;
 
-  /* Init record_full_first.  */
-  record_full_first.prev = NULL;
-  record_full_first.next = NULL;
-  record_full_first.type = record_full_end;
-
   add_target (record_full_target_info, record_full_open);
   add_deprecated_target_alias (record_full_target_info, "record");
   add_target (record_full_core_target_info, record_full_open);
@@ -2868,4 +3138,27 @@ When ON, query if PREC cannot record memory change of next instruction."),
   c = add_alias_cmd ("memory-query", record_full_memory_query_cmds.show,
 		     no_class, 1,&show_record_cmdlist);
   deprecate_cmd (c, "show record full memory-query");
+
+  add_setshow_zuinteger_unlimited_cmd ("spill-threshold", no_class,
+				       &record_full_spill_threshold, _("\
+Set the memory size above which the execution log is spilled to disk."), _("\
+Show the memory size above which the execution log is spilled to disk."), _("\
+The size is in kilobytes.  When the execution log kept in memory grows\n\
+beyond this size, the least recently used parts of the log are written\n\
+to a temporary file, and read back when replaying through them.\n\
+A value of \"unlimited\", the default, keeps the whole log in memory."),
+				       set_record_full_spill_threshold, NULL,
+				       &set_record_full_cmdlist,
+				       &show_record_full_cmdlist);
+
+  add_setshow_optional_filename_cmd ("spill-directory", no_class,
+				     &record_full_spill_directory, _("\
+Set the directory of the execution log spill file."), _("\
+Show the directory of the execution log spill file."), _("\
+The spill file is created when the execution log grows beyond\n\
+\"record full spill-threshold\".  If empty, the default, it is created\n\
+in the system's temporary directory."),
+				     NULL, NULL,
+				     &set_record_full_cmdlist,
+				     &show_record_full_cmdlist);
 }
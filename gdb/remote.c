@@ -80,6 +80,7 @@
 #include <unordered_map>
 #include "async-event.h"
 #include "gdbsupport/selftest.h"
+#include "perf-counters.h"
 
 /* The remote target.  */
 
@@ -92,6 +93,17 @@ Specify the serial device it is connected to\n\
 
 bool remote_debug = false;
 
+/* Performance counters for the remote protocol traffic.  */
+
+static perf_counter remote_packets_sent
+  ("remote.packets-sent", N_("Remote protocol packets sent"));
+static perf_counter remote_bytes_sent
+  ("remote.bytes-sent", N_("Remote protocol bytes sent, with framing"));
+static perf_counter remote_packets_received
+  ("remote.packets-received", N_("Remote protocol packets received"));
+static perf_counter remote_bytes_received
+  ("remote.bytes-received", N_("Remote protocol payload bytes received"));
+
 #define OPAQUETHREADBYTES 8
 
 /* a 64 bit opaque identifier */
@@ -9618,6 +9630,8 @@ remote_target::putpkt_binary (const char *buf, int cnt)
 	    remote_debug_printf_nofunc ("Sending packet: %s", str.c_str ());
 	}
       remote_serial_write (buf2, p - buf2);
+      remote_packets_sent.add ();
+      remote_bytes_sent.add (p - buf2);
 
       /* If this is a no acks version of the remote protocol, send the
 	 packet and move on.  */
@@ -9968,7 +9982,11 @@ remote_target::getpkt_or_notif_sane_1 (gdb::char_vector *buf,
 		 Now collect the data.  */
 	      val = read_frame (buf);
 	      if (val >= 0)
-		break;
+		{
+		  remote_packets_received.add ();
+		  remote_bytes_received.add (val);
+		  break;
+		}
 	    }
 
 	  remote_serial_write ("-", 1);
@@ -1052,6 +1052,10 @@ solib_add (const char *pattern, int from_tty, int readsyms)
     if (from_tty)
 	add_flags |= SYMFILE_VERBOSE;
 
+    /* Read the minimal symbols of each library in turn, and then the
+       debug information of all of them at once.  */
+    scoped_symbol_read_batch read_batch;
+
     for (struct so_list *gdb : current_program_space->solibs ())
       if (! pattern || re_exec (gdb->so_name))
 	{
@@ -1079,8 +1083,10 @@ solib_add (const char *pattern, int from_tty, int readsyms)
 	    }
 	}
 
+    read_batch.finish ();
+
     if (loaded_any_symbols)
-      breakpoint_re_set ();
+      breakpoint_re_set_new_objfiles ();
 
     if (from_tty && pattern && ! any_matches)
       gdb_printf
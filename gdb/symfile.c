@@ -69,6 +69,7 @@
 #include <ctype.h>
 #include <chrono>
 #include <algorithm>
+#include <typeinfo>
 
 int (*deprecated_ui_load_progress_hook) (const char *section,
 					 unsigned long num);
@@ -763,6 +764,123 @@ default_symfile_segments (bfd *abfd)
   return data;
 }
 
+/* True if a scoped_symbol_read_batch defers reading partial symbols
+   so that they can be read for many objfiles at once.  */
+
+static bool parallel_objfile_reading = true;
+
+/* Implement the "maint show parallel-objfile-reading" command.  */
+
+static void
+show_parallel_objfile_reading (struct ui_file *file, int from_tty,
+			       struct cmd_list_element *c, const char *value)
+{
+  gdb_printf (file,
+	      _("Reading the symbols of several objfiles at once is %s.\n"),
+	      value);
+}
+
+/* The active symbol read batch, or NULL.  */
+
+static scoped_symbol_read_batch *current_symbol_read_batch;
+
+/* See symfile.h.  */
+
+scoped_symbol_read_batch::scoped_symbol_read_batch ()
+  : m_saved (current_symbol_read_batch),
+    m_active (parallel_objfile_reading)
+{
+  if (m_active)
+    current_symbol_read_batch = this;
+}
+
+/* See symfile.h.  */
+
+scoped_symbol_read_batch::~scoped_symbol_read_batch ()
+{
+  if (m_active)
+    current_symbol_read_batch = m_saved;
+}
+
+/* See symfile.h.  */
+
+bool
+scoped_symbol_read_batch::defer (struct objfile *objfile)
+{
+  if (current_symbol_read_batch == nullptr)
+    return false;
+
+  current_symbol_read_batch->m_objfiles.push_back (objfile);
+  return true;
+}
+
+/* See symfile.h.  */
+
+void
+scoped_symbol_read_batch::forget (struct objfile *objfile)
+{
+  for (scoped_symbol_read_batch *batch = current_symbol_read_batch;
+       batch != nullptr;
+       batch = batch->m_saved)
+    {
+      auto &objfiles = batch->m_objfiles;
+      objfiles.erase (std::remove (objfiles.begin (), objfiles.end (),
+				   objfile),
+		      objfiles.end ());
+    }
+}
+
+/* See symfile.h.  */
+
+void
+scoped_symbol_read_batch::finish ()
+{
+  if (!m_active)
+    return;
+
+  /* Stop deferring, so that whatever reading the partial symbols
+     triggers is done right away.  */
+  current_symbol_read_batch = m_saved;
+  m_active = false;
+
+  std::vector<struct objfile *> objfiles = std::move (m_objfiles);
+
+  /* Group the objfiles by the kind of symbol reader that will read
+     them, and hand each group over to its reader at once.  */
+  std::vector<std::pair<quick_symbol_functions *,
+			std::vector<struct objfile *>>> groups;
+  for (struct objfile *objfile : objfiles)
+    {
+      /* The symbols may have been read on demand in the meantime.  */
+      if ((objfile->flags & OBJF_PSYMTABS_READ) != 0)
+	continue;
+      objfile->flags |= OBJF_PSYMTABS_READ;
+
+      for (const auto &iter : objfile->qf)
+	{
+	  if (!iter->can_lazily_read_symbols ())
+	    continue;
+
+	  auto group = std::find_if (groups.begin (), groups.end (),
+				     [&] (const auto &g)
+				     {
+				       return (typeid (*g.first)
+					       == typeid (*iter));
+				     });
+	  if (group == groups.end ())
+	    {
+	      groups.emplace_back (iter.get (),
+				   std::vector<struct objfile *> ());
+	      group = groups.end () - 1;
+	    }
+	  group->second.push_back (objfile);
+	}
+    }
+
+  for (auto &group : groups)
+    group.first->read_partial_symbols_batch (group.second);
+}
+
 /* This is a convenience function to call sym_read for OBJFILE and
    possibly force the partial symbols to be read.  */
 
@@ -791,7 +909,8 @@ read_symbols (struct objfile *objfile, symfile_add_flags add_flags)
 				    add_flags | SYMFILE_NOT_FILENAME, objfile);
 	}
     }
-  if ((add_flags & SYMFILE_NO_READ) == 0)
+  if ((add_flags & SYMFILE_NO_READ) == 0
+      && !scoped_symbol_read_batch::defer (objfile))
     objfile->require_partial_symbols (false);
 }
 
@@ -1005,7 +1124,7 @@ finish_new_objfile (struct objfile *objfile, symfile_add_flags add_flags)
     }
   else if ((add_flags & SYMFILE_DEFER_BP_RESET) == 0)
     {
-      breakpoint_re_set ();
+      breakpoint_re_set_new_objfiles ();
     }
 
   /* We're done reading the symbol file; finish off complaints.  */
@@ -3719,6 +3838,8 @@ symfile_free_objfile (struct objfile *objfile)
   /* Remove the target sections owned by this objfile.  */
   if (objfile != NULL)
     current_program_space->remove_target_sections ((void *) objfile);
+
+  scoped_symbol_read_batch::forget (objfile);
 }
 
 /* Wrapper around the quick_symbol_functions expand_symtabs_matching "method".
@@ -3935,6 +4056,20 @@ full  == print messages for the executable,\n\
 			NULL,
 			&setprintlist, &showprintlist);
 
+  add_setshow_boolean_cmd ("parallel-objfile-reading", class_maintenance,
+			   &parallel_objfile_reading, _("\
+Set whether the symbols of several objfiles are read at once."), _("\
+Show whether the symbols of several objfiles are read at once."), _("\
+If on (the default), when several shared libraries are loaded at once,\n\
+e.g. when attaching to a process, their minimal symbols are read one at\n\
+a time, and their debug information is then indexed for all of them at\n\
+once, using the worker threads.  If off, each shared library is read\n\
+completely before the next one."),
+			   NULL,
+			   show_parallel_objfile_reading,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+
   add_setshow_boolean_cmd ("separate-debug-file", no_class,
 			   &separate_debug_file_debug, _("\
 Set printing of separate debug info file search debug."), _("\
@@ -233,6 +233,44 @@ extern void symbol_file_add_separate (bfd *, const char *, symfile_add_flags,
 
 extern std::string find_separate_debug_file_by_debuglink (struct objfile *);
 
+/* While an instance of this class is live, adding a symbol file only
+   reads its minimal symbols, and reading its partial symbols is
+   deferred.  The finish method then reads the partial symbols of all
+   the deferred objfiles at once, which lets a symbol reader spread the
+   work of many objfiles over the thread pool.  Objfiles that are still
+   deferred when this object is destroyed read their partial symbols
+   lazily, as if SYMFILE_NO_READ had been used.  */
+
+class scoped_symbol_read_batch
+{
+public:
+  scoped_symbol_read_batch ();
+  ~scoped_symbol_read_batch ();
+
+  DISABLE_COPY_AND_ASSIGN (scoped_symbol_read_batch);
+
+  /* Read the partial symbols of all the deferred objfiles.  */
+  void finish ();
+
+  /* If a batch is active, defer reading the partial symbols of
+     OBJFILE to it and return true.  Otherwise, return false.  */
+  static bool defer (struct objfile *objfile);
+
+  /* Remove OBJFILE, which is about to be freed, from the active
+     batch.  */
+  static void forget (struct objfile *objfile);
+
+private:
+  /* The objfiles whose partial symbols were deferred.  */
+  std::vector<struct objfile *> m_objfiles;
+
+  /* The batch that was active when this one was created.  */
+  scoped_symbol_read_batch *m_saved;
+
+  /* True if this batch is the active one.  */
+  bool m_active;
+};
+
 /* Build (allocate and populate) a section_addr_info struct from an
    existing section table.  */
 
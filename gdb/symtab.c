@@ -72,6 +72,7 @@
 #include "gdbsupport/gdb_string_view.h"
 #include "gdbsupport/pathstuff.h"
 #include "gdbsupport/common-utils.h"
+#include "perf-counters.h"
 
 /* Forward declarations for local functions.  */
 
@@ -1386,6 +1387,15 @@ set_symbol_cache_size_handler (const char *args, int from_tty,
   set_symbol_cache_size (symbol_cache_size);
 }
 
+/* Performance counters for symbol lookups.  */
+
+static perf_timer lookup_symbol_timer
+  ("symtab.lookup-symbol", N_("Symbol lookups by name"));
+static perf_counter symbol_cache_hits
+  ("symtab.symbol-cache-hits", N_("Symbol cache hits"));
+static perf_counter symbol_cache_misses
+  ("symtab.symbol-cache-misses", N_("Symbol cache misses"));
+
 /* Lookup symbol NAME,DOMAIN in BLOCK in the symbol cache of PSPACE.
    OBJFILE_CONTEXT is the current objfile, which may be NULL.
    The result is the symbol if found, SYMBOL_LOOKUP_FAILED if a previous lookup
@@ -1432,6 +1442,7 @@ symbol_cache_lookup (struct symbol_cache *cache,
 		    ? " (not found)" : "",
 		    name, domain_name (domain));
       ++bsc->hits;
+      symbol_cache_hits.add ();
       if (slot->state == SYMBOL_SLOT_NOT_FOUND)
 	return SYMBOL_LOOKUP_FAILED;
       return slot->value.found;
@@ -1447,6 +1458,7 @@ symbol_cache_lookup (struct symbol_cache *cache,
 		  name, domain_name (domain));
     }
   ++bsc->misses;
+  symbol_cache_misses.add ();
   return {};
 }
 
@@ -2090,6 +2102,7 @@ lookup_symbol_aux (const char *name, symbol_name_match_type match_type,
 {
   struct block_symbol result;
   const struct language_defn *langdef;
+  scoped_perf_timer timer (lookup_symbol_timer);
 
   if (symbol_lookup_debug)
     {
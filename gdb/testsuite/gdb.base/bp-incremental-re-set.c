@@ -0,0 +1,52 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2022 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include <dlfcn.h>
+#include <stdlib.h>
+
+static int
+call_lib (const char *name, const char *func)
+{
+  void *handle = dlopen (name, RTLD_LAZY);
+  int (*fn) (int);
+
+  if (handle == NULL)
+    abort ();
+
+  fn = (int (*) (int)) dlsym (handle, func);
+  if (fn == NULL)
+    abort ();
+
+  return fn (1);
+}
+
+int
+main_func (int x)
+{
+  return x + 1;
+}
+
+int
+main (void)
+{
+  int res = main_func (0);
+
+  res += call_lib (SHLIB_NAME1, "lib1_func");
+  res += call_lib (SHLIB_NAME2, "lib2_func");
+
+  return res == 0;	/* end marker */
+}
@@ -0,0 +1,134 @@
+/* Self tests for concurrent_bcache
+
+   Copyright (C) 2022 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "defs.h"
+#include "bcache.h"
+#include "gdbsupport/selftest.h"
+#include "gdbsupport/parallel-for.h"
+#include "gdbsupport/thread-pool.h"
+#include <atomic>
+
+namespace selftests {
+namespace bcache {
+
+/* Check the basic properties of a concurrent_bcache from a single
+   thread.  */
+
+static void
+test_basic ()
+{
+  gdb::concurrent_bcache cache;
+  bool added;
+
+  const char *a = cache.insert ("hello");
+  const char *b = (const char *) cache.insert ("hello", 6, &added);
+  SELF_CHECK (a == b);
+  SELF_CHECK (!added);
+  SELF_CHECK (strcmp (a, "hello") == 0);
+
+  /* A prefix of a cached string is a different string.  */
+  const char *c = (const char *) cache.insert ("hello", 3, &added);
+  SELF_CHECK (added);
+  SELF_CHECK (c != a);
+  SELF_CHECK (memcmp (c, "hel", 3) == 0);
+
+  /* Empty strings are cached too.  */
+  const char *d = cache.insert ("");
+  SELF_CHECK (d == cache.insert (""));
+  SELF_CHECK (*d == '\0');
+}
+
+/* Insert the same strings from several threads at once, and check
+   that each one was added exactly once and that every insertion
+   returned the same copy.  */
+
+static void
+test_parallel (int n_threads)
+{
+#if CXX_STD_THREAD
+  int saved_n_threads = gdb::thread_pool::g_thread_pool->thread_count ();
+  gdb::thread_pool::g_thread_pool->set_thread_count (n_threads);
+#endif
+
+  const int n_strings = 2000;
+  const int n_copies = 8;
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < n_strings; ++i)
+    strings.push_back (string_printf ("name_%d", i));
+
+  gdb::concurrent_bcache cache;
+  std::vector<std::atomic<const char *>> results (n_strings);
+  std::atomic<int> n_added (0);
+  std::atomic<int> n_mismatches (0);
+
+  gdb::parallel_for_each (1, 0, n_strings * n_copies,
+			  [&] (int start, int end)
+			  {
+			    for (int i = start; i < end; ++i)
+			      {
+				const std::string &str = strings[i % n_strings];
+				bool added;
+				const char *copy
+				  = ((const char *)
+				     cache.insert (str.c_str (),
+						   str.size () + 1, &added));
+				if (added)
+				  ++n_added;
+
+				const char *expected = nullptr;
+				if (!results[i % n_strings]
+				     .compare_exchange_strong (expected, copy)
+				    && expected != copy)
+				  ++n_mismatches;
+			      }
+			  });
+
+#if CXX_STD_THREAD
+  gdb::thread_pool::g_thread_pool->set_thread_count (saved_n_threads);
+#endif
+
+  SELF_CHECK (n_added == n_strings);
+  SELF_CHECK (n_mismatches == 0);
+  for (int i = 0; i < n_strings; ++i)
+    {
+      SELF_CHECK (strings[i] == results[i].load ());
+      SELF_CHECK (cache.insert (strings[i].c_str ()) == results[i]);
+    }
+}
+
+static void
+test_concurrent_bcache ()
+{
+  test_basic ();
+  test_parallel (0);
+  test_parallel (1);
+  test_parallel (3);
+}
+
+}
+}
+
+void _initialize_bcache_selftests ();
+void
+_initialize_bcache_selftests ()
+{
+  selftests::register_test ("concurrent_bcache",
+			    selftests::bcache::test_concurrent_bcache);
+}
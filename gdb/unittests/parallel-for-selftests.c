@@ -20,6 +20,7 @@
 #include "defs.h"
 #include "gdbsupport/selftest.h"
 #include "gdbsupport/parallel-for.h"
+#include <algorithm>
 
 #if CXX_STD_THREAD
 
@@ -60,6 +61,29 @@ test (int n_threads)
 
   SELF_CHECK (counter == NUMBER);
 
+  /* Make one element cost as much as all the others together, and
+     check that every element is still processed exactly once.  */
+  std::vector<std::atomic<int>> seen (NUMBER);
+  auto task_size_ = [] (int iter)
+    {
+      return (size_t) (iter == NUMBER / 2 ? NUMBER : 1);
+    };
+  gdb::function_view<size_t (int)> task_size = task_size_;
+
+  gdb::parallel_for_each (1, 0, NUMBER,
+			  [&] (int start, int end)
+			  {
+			    for (int i = start; i < end; ++i)
+			      ++seen[i];
+			  },
+			  task_size);
+
+  SELF_CHECK (std::all_of (seen.begin (), seen.end (),
+			   [] (const std::atomic<int> &count)
+			   {
+			     return count == 1;
+			   }));
+
 #undef NUMBER
 }
 
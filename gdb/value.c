@@ -49,6 +49,7 @@
 #include "cli/cli-style.h"
 #include "expop.h"
 #include "inferior.h"
+#include "perf-counters.h"
 
 /* Definition of a user function.  */
 struct internal_function
@@ -4046,6 +4047,11 @@ value_fetch_lazy_register (struct value *val)
   value_free_to_mark (mark);
 }
 
+/* Performance timer for fetching lazy values.  */
+
+static perf_timer value_fetch_timer
+  ("value.fetches", N_("Lazy values fetched"));
+
 /* Load the actual content of a lazy value.  Fetch the data from the
    user's process and clear the lazy flag to indicate that the data in
    the buffer is valid.
@@ -4058,6 +4064,8 @@ void
 value_fetch_lazy (struct value *val)
 {
   gdb_assert (value_lazy (val));
+  scoped_perf_timer timer (value_fetch_timer);
+
   allocate_value_contents (val);
   /* A value is either lazy, or fully fetched.  The
      availability/validity is only established as we try to fetch a
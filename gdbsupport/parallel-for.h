@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <type_traits>
+#include "gdbsupport/function-view.h"
 #include "gdbsupport/thread-pool.h"
 
 namespace gdb
@@ -37,20 +38,20 @@ struct par_for_accumulator
 {
 public:
 
-  explicit par_for_accumulator (size_t n_threads)
-    : m_futures (n_threads)
+  explicit par_for_accumulator (size_t n_tasks)
   {
+    m_futures.reserve (n_tasks);
   }
 
   /* The result type that is accumulated.  */
   typedef std::vector<T> result_type;
 
-  /* Post the Ith task to a background thread, and store a future for
+  /* Post a task to a background thread, and store a future for
      later.  */
-  void post (size_t i, std::function<T ()> task)
+  void post (std::function<T ()> task)
   {
-    m_futures[i]
-      = gdb::thread_pool::g_thread_pool->post_task (std::move (task));
+    m_futures.push_back
+      (gdb::thread_pool::g_thread_pool->post_task (std::move (task)));
   }
 
   /* Invoke TASK in the current thread, then compute all the results
@@ -81,18 +82,18 @@ struct par_for_accumulator<void>
 {
 public:
 
-  explicit par_for_accumulator (size_t n_threads)
-    : m_futures (n_threads)
+  explicit par_for_accumulator (size_t n_tasks)
   {
+    m_futures.reserve (n_tasks);
   }
 
   /* This specialization does not compute results.  */
   typedef void result_type;
 
-  void post (size_t i, std::function<void ()> task)
+  void post (std::function<void ()> task)
   {
-    m_futures[i]
-      = gdb::thread_pool::g_thread_pool->post_task (std::move (task));
+    m_futures.push_back
+      (gdb::thread_pool::g_thread_pool->post_task (std::move (task)));
   }
 
   result_type finish (gdb::function_view<void ()> task)
@@ -127,14 +128,23 @@ struct par_for_accumulator<void>
 
    If the function returns a non-void type, then a vector of the
    results is returned.  The size of the resulting vector depends on
-   the number of threads that were used.  */
+   the number of threads that were used.
+
+   TASK_SIZE, if given, estimates the cost of processing an element,
+   for instance the length of a compilation unit.  The range is then
+   cut into several subranges of about the same total cost per
+   thread, rather than into one subrange of the same number of
+   elements per thread.  An element much costlier than the others
+   ends up in a subrange of its own, and the worker threads that
+   finish their own subranges first steal the rest.  */
 
 template<class RandomIt, class RangeFunction>
 typename gdb::detail::par_for_accumulator<
     typename std::result_of<RangeFunction (RandomIt, RandomIt)>::type
   >::result_type
 parallel_for_each (unsigned n, RandomIt first, RandomIt last,
-		   RangeFunction callback)
+		   RangeFunction callback,
+		   gdb::function_view<size_t (RandomIt)> task_size = nullptr)
 {
   using result_type
     = typename std::result_of<RangeFunction (RandomIt, RandomIt)>::type;
@@ -143,11 +153,17 @@ parallel_for_each (unsigned n, RandomIt first, RandomIt last,
      the threads.  */
   const int parallel_for_each_debug = false;
 
+  /* When TASK_SIZE is given, the number of subranges per thread.  */
+  const size_t tasks_per_thread = 4;
+
   size_t n_worker_threads = thread_pool::g_thread_pool->thread_count ();
   size_t n_threads = n_worker_threads;
   size_t n_elements = last - first;
+  size_t n_tasks = n_threads;
   size_t elts_per_thread = 0;
   size_t elts_left_over = 0;
+  size_t total_size = 0;
+  size_t size_per_task = 0;
 
   if (n_threads > 1)
     {
@@ -159,38 +175,79 @@ parallel_for_each (unsigned n, RandomIt first, RandomIt last,
       elts_per_thread = n_elements / n_threads;
       elts_left_over = n_elements % n_threads;
       /* n_elements == n_threads * elts_per_thread + elts_left_over. */
+      n_tasks = n_threads;
+
+      if (task_size != nullptr)
+	{
+	  for (RandomIt i = first; i != last; ++i)
+	    total_size += task_size (i);
+	  n_tasks = std::min (n_threads * tasks_per_thread,
+			      std::max (n_elements / n, (size_t) 1));
+	  size_per_task = (total_size + n_tasks - 1) / n_tasks;
+	}
     }
 
-  size_t count = n_threads == 0 ? 0 : n_threads - 1;
+  size_t count = n_tasks == 0 ? 0 : n_tasks - 1;
   gdb::detail::par_for_accumulator<result_type> results (count);
 
   if (parallel_for_each_debug)
     {
       debug_printf (_("Parallel for: n_elements: %zu\n"), n_elements);
       debug_printf (_("Parallel for: minimum elements per thread: %u\n"), n);
-      debug_printf (_("Parallel for: elts_per_thread: %zu\n"), elts_per_thread);
+      if (task_size != nullptr)
+	debug_printf (_("Parallel for: size_per_task: %zu\n"), size_per_task);
+      else
+	debug_printf (_("Parallel for: elts_per_thread: %zu\n"),
+		      elts_per_thread);
     }
 
   for (int i = 0; i < count; ++i)
     {
-      RandomIt end = first + elts_per_thread;
-      if (i < elts_left_over)
-	/* Distribute the leftovers over the worker threads, to avoid having
-	   to handle all of them in a single thread.  */
-	end++;
+      RandomIt end;
+      size_t chunk_size = 0;
+
+      if (task_size != nullptr)
+	{
+	  /* Leave at least N elements for each of the remaining
+	     subranges, including the one for the main thread.  */
+	  RandomIt limit = last - (count - i) * n;
+
+	  end = first;
+	  while (end < limit
+		 && ((size_t) (end - first) < n || chunk_size < size_per_task))
+	    chunk_size += task_size (end++);
+	}
+      else
+	{
+	  end = first + elts_per_thread;
+	  if (i < elts_left_over)
+	    /* Distribute the leftovers over the worker threads, to avoid
+	       having to handle all of them in a single thread.  */
+	    end++;
+	}
       if (parallel_for_each_debug)
-	debug_printf (_("Parallel for: elements on worker thread %i\t: %zu\n"),
-		      i, (size_t)(end - first));
-      results.post (i, [=] ()
+	{
+	  if (task_size != nullptr)
+	    debug_printf (_("Parallel for: elements in task %i\t: %zu "
+			    "(size %zu)\n"),
+			  i, (size_t)(end - first), chunk_size);
+	  else
+	    debug_printf (_("Parallel for: elements on worker thread %i\t: "
+			    "%zu\n"),
+			  i, (size_t)(end - first));
+	}
+      results.post ([=] ()
         {
 	  return callback (first, end);
 	});
       first = end;
     }
 
-  for (int i = count; i < n_worker_threads; ++i)
-    if (parallel_for_each_debug)
-      debug_printf (_("Parallel for: elements on worker thread %i\t: 0\n"), i);
+  if (task_size == nullptr)
+    for (int i = count; i < n_worker_threads; ++i)
+      if (parallel_for_each_debug)
+	debug_printf (_("Parallel for: elements on worker thread %i\t: 0\n"),
+		      i);
 
   /* Process all the remaining elements in the main thread.  */
   if (parallel_for_each_debug)
@@ -211,7 +268,8 @@ typename gdb::detail::par_for_accumulator<
     typename std::result_of<RangeFunction (RandomIt, RandomIt)>::type
   >::result_type
 sequential_for_each (unsigned n, RandomIt first, RandomIt last,
-		   RangeFunction callback)
+		   RangeFunction callback,
+		   gdb::function_view<size_t (RandomIt)> task_size = nullptr)
 {
   using result_type
     = typename std::result_of<RangeFunction (RandomIt, RandomIt)>::type;
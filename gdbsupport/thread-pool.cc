@@ -141,6 +141,10 @@ namespace gdb
 */
 thread_pool *thread_pool::g_thread_pool = new thread_pool ();
 
+#if CXX_STD_THREAD
+thread_local thread_pool::worker *thread_pool::current_worker;
+#endif
+
 thread_pool::~thread_pool ()
 {
   /* Because this is a singleton, we don't need to clean up.  The
@@ -163,10 +167,21 @@ thread_pool::set_thread_count (size_t num_threads)
       block_signals blocker;
       for (size_t i = m_thread_count; i < num_threads; ++i)
 	{
+	  if (i == m_workers.size ())
+	    m_workers.emplace_back (new worker (i));
+
+	  /* The thread of a worker that an earlier call told to exit
+	     may not have got round to it yet.  If so, it simply
+	     carries on.  */
+	  worker *w = m_workers[i].get ();
+	  if (w->running)
+	    continue;
+
 	  try
 	    {
-	      std::thread thread (&thread_pool::thread_function, this);
+	      std::thread thread (&thread_pool::thread_function, this, w);
 	      thread.detach ();
+	      w->running = true;
 	    }
 	  catch (const std::system_error &)
 	    {
@@ -178,15 +193,13 @@ thread_pool::set_thread_count (size_t num_threads)
 	    }
 	}
     }
-  /* If the new size is smaller, terminate some existing threads.  */
-  if (num_threads < m_thread_count)
-    {
-      for (size_t i = num_threads; i < m_thread_count; ++i)
-	m_tasks.emplace ();
-      m_tasks_cv.notify_all ();
-    }
+  /* If the new size is smaller, the threads of the workers that are
+     no longer needed exit once they find nothing left to do.  */
+  bool shrinking = num_threads < m_thread_count;
 
   m_thread_count = num_threads;
+  if (shrinking)
+    m_tasks_cv.notify_all ();
 #else
   /* No threads available, simply ignore the request.  */
 #endif /* CXX_STD_THREAD */
@@ -199,21 +212,51 @@ thread_pool::do_post_task (std::packaged_task<void ()> &&func)
 {
   std::packaged_task<void ()> t (std::move (func));
 
-  if (m_thread_count != 0)
-    {
-      std::lock_guard<std::mutex> guard (m_tasks_mutex);
-      m_tasks.emplace (std::move (t));
-      m_tasks_cv.notify_one ();
-    }
-  else
+  if (m_thread_count == 0)
     {
       /* Just execute it now.  */
       t ();
+      return;
     }
+
+  {
+    /* A task posted by a task goes to the deque of the worker running
+       it, and any other task to the next worker in turn.  M_PENDING
+       must count the task before anyone can take it.  */
+    std::lock_guard<std::mutex> guard (m_tasks_mutex);
+    worker *w = current_worker;
+    if (w == nullptr)
+      w = m_workers[m_next_worker++ % m_thread_count].get ();
+    ++m_pending;
+    std::lock_guard<std::mutex> worker_guard (w->tasks_mutex);
+    w->tasks.push_back (std::move (t));
+  }
+  m_tasks_cv.notify_one ();
+}
+
+optional<thread_pool::task_t>
+thread_pool::steal_task (worker *thief)
+{
+  size_t n_workers = m_workers.size ();
+
+  for (size_t i = 1; i < n_workers; ++i)
+    {
+      worker *victim = m_workers[(thief->index + i) % n_workers].get ();
+      std::lock_guard<std::mutex> guard (victim->tasks_mutex);
+      if (!victim->tasks.empty ())
+	{
+	  optional<task_t> t (std::move (victim->tasks.back ()));
+	  victim->tasks.pop_back ();
+	  --m_pending;
+	  return t;
+	}
+    }
+
+  return {};
 }
 
 void
-thread_pool::thread_function ()
+thread_pool::thread_function (worker *self)
 {
   /* This must be done here, because on macOS one can only set the
      name of the current thread.  */
@@ -223,22 +266,48 @@ thread_pool::thread_function ()
      stack.  */
   gdb::alternate_signal_stack signal_stack;
 
+  current_worker = self;
+
   while (true)
     {
       optional<task_t> t;
 
       {
-	/* We want to hold the lock while examining the task list, but
-	   not while invoking the task function.  */
-	std::unique_lock<std::mutex> guard (m_tasks_mutex);
-	while (m_tasks.empty ())
-	  m_tasks_cv.wait (guard);
-	t = std::move (m_tasks.front());
-	m_tasks.pop ();
+	std::lock_guard<std::mutex> guard (self->tasks_mutex);
+	if (!self->tasks.empty ())
+	  {
+	    t.emplace (std::move (self->tasks.front ()));
+	    self->tasks.pop_front ();
+	    --m_pending;
+	  }
       }
 
       if (!t.has_value ())
-	break;
+	{
+	  /* We want to hold the lock while looking for a task to steal
+	     and deciding whether to sleep, but not while invoking the
+	     task function.  */
+	  std::unique_lock<std::mutex> guard (m_tasks_mutex);
+	  t = steal_task (self);
+	  if (!t.has_value ())
+	    {
+	      /* Tasks are only queued with M_TASKS_MUTEX held, and
+		 M_PENDING drops as soon as one is taken from a deque, so
+		 it can only be nonzero here if a task was queued for
+		 this worker since it last looked.  */
+	      if (m_pending == 0)
+		{
+		  if (self->index >= m_thread_count)
+		    {
+		      self->running = false;
+		      break;
+		    }
+		  m_tasks_cv.wait (guard);
+		}
+	      continue;
+	    }
+	}
+
       (*t) ();
     }
 }
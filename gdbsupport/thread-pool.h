@@ -20,10 +20,12 @@
 #ifndef GDBSUPPORT_THREAD_POOL_H
 #define GDBSUPPORT_THREAD_POOL_H
 
-#include <queue>
 #include <vector>
 #include <functional>
 #if CXX_STD_THREAD
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -95,7 +97,14 @@ class future<void>
 
    There is a single global thread pool, see g_thread_pool.  Tasks can
    be submitted to the thread pool.  They will be processed in worker
-   threads as time allows.  */
+   threads as time allows.
+
+   Each worker thread has its own deque of tasks.  Tasks posted from
+   outside the pool are dealt out to the workers in turn, while a task
+   posted by a worker goes to that worker's own deque.  A worker takes
+   tasks from the front of its own deque, and once that is empty it
+   steals from the back of the others', so that a thread that was
+   handed less work than the rest does not sit idle.  */
 class thread_pool
 {
 public:
@@ -154,8 +163,42 @@ class thread_pool
   thread_pool () = default;
 
 #if CXX_STD_THREAD
-  /* The callback for each worker thread.  */
-  void thread_function ();
+  /* A convenience typedef for the type of a task.  */
+  typedef std::packaged_task<void ()> task_t;
+
+  /* The state of one worker thread.  */
+  struct worker
+  {
+    explicit worker (size_t index)
+      : index (index)
+    {
+    }
+
+    /* The position of this worker in m_workers.  */
+    const size_t index;
+
+    /* The tasks handed to this worker that nobody has started yet,
+       and the mutex that guards them.  */
+    std::deque<task_t> tasks;
+    std::mutex tasks_mutex;
+
+    /* True if a thread is running for this worker.  This is guarded
+       by m_tasks_mutex.  */
+    bool running = false;
+  };
+
+  /* The worker that the current thread runs, or nullptr if this is
+     not a worker thread.  */
+  static thread_local worker *current_worker;
+
+  /* The callback for each worker thread.  SELF is the worker it
+     runs.  */
+  void thread_function (worker *self);
+
+  /* Take a task from the back of the deque of some worker other than
+     THIEF.  Return an empty optional if there are none.  Must be
+     called with m_tasks_mutex held.  */
+  optional<task_t> steal_task (worker *thief);
 
   /* Post a task to the thread pool.  A future is returned, which can
      be used to wait for the result.  */
@@ -164,14 +207,21 @@ class thread_pool
   /* The current thread count.  */
   size_t m_thread_count = 0;
 
-  /* A convenience typedef for the type of a task.  */
-  typedef std::packaged_task<void ()> task_t;
-
-  /* The tasks that have not been processed yet.  An optional is used
-     to represent a task.  If the optional is empty, then this means
-     that the receiving thread should terminate.  If the optional is
-     non-empty, then it is an actual task to evaluate.  */
-  std::queue<optional<task_t>> m_tasks;
+  /* All the workers ever started.  Those at index M_THREAD_COUNT and
+     above are no longer handed tasks, and their threads exit once
+     there is nothing left to do.  Guarded by m_tasks_mutex.  */
+  std::vector<std::unique_ptr<worker>> m_workers;
+
+  /* The worker that is handed the next task posted from outside the
+     pool.  Guarded by m_tasks_mutex.  */
+  size_t m_next_worker = 0;
+
+  /* The number of tasks queued in the deques of all the workers.  It
+     is incremented with m_tasks_mutex held before a task is queued,
+     and decremented with the deque's mutex held as the task is taken
+     from it, so that it never wraps and a worker that sees it is zero
+     with m_tasks_mutex held can safely go to sleep.  */
+  std::atomic<size_t> m_pending { 0 };
 
   /* A condition variable and mutex that are used for communication
      between the main thread and the worker threads.  */
@@ -733,6 +733,11 @@ struct bfd_link_info
   /* The maximum cache size.  Backend can use cache_size and and
      max_cache_size to decide if keep_memory should be honored.  */
   bfd_size_type max_cache_size;
+
+  /* The number of threads the linker may use for the parts of the
+     final link that can run in parallel, via the parallel_for
+     callback.  0 or 1 means no threads.  */
+  unsigned int threads;
 };
 
 /* Some forward-definitions used by some callbacks.  */
@@ -877,6 +882,13 @@ struct bfd_link_callbacks
      the output BFD named .ctf or a name beginning with ".ctf.".  */
   void (*emit_ctf)
     (void);
+  /* Call FN (DATA, I) for each I from 0 to COUNT - 1, using up to
+     INFO->threads threads.  The calls may run concurrently and in any
+     order.  Other callbacks that FN makes are serialized.  May be
+     NULL if the linker has no thread support.  */
+  void (*parallel_for)
+    (struct bfd_link_info *info, void (*fn) (void *data, size_t i),
+     void *data, size_t count);
 };
 
 /* The linker builds link_order structures which tell the code how to
@@ -532,6 +532,14 @@ typedef int ctf_link_variable_filter_f (ctf_dict_t *, const char *, ctf_id_t,
 					void *);
 extern int ctf_link_set_variable_filter (ctf_dict_t *,
 					 ctf_link_variable_filter_f *, void *);
+/* The parallel-for function should call FN (DATA, I) for every I from 0 to
+   COUNT - 1 and return once all the calls are done.  The calls may run
+   concurrently, on different threads, and in any order.  */
+typedef void ctf_link_parallel_fn_f (void *data, size_t i);
+typedef void ctf_link_parallel_for_f (ctf_link_parallel_fn_f *fn, void *data,
+				      size_t count, void *arg);
+extern int ctf_link_set_parallel_for (ctf_dict_t *,
+				      ctf_link_parallel_for_f *, void *);
 extern int ctf_link (ctf_dict_t *, int flags);
 typedef const char *ctf_link_strtab_string_f (uint32_t *offset, void *arg);
 extern int ctf_link_add_strtab (ctf_dict_t *, ctf_link_strtab_string_f *,
@@ -50,6 +50,7 @@ fragment <<EOF
 #include "elf-bfd.h"
 #include "ldelf.h"
 #include "ldelfgen.h"
+#include "ldbuildid.h"
 
 /* Declare functions used by various EXTRA_EM_FILEs.  */
 static void gld${EMULATION_NAME}_before_parse (void);
@@ -572,6 +573,8 @@ enum elf_options
   OPTION_EXCLUDE_LIBS,
   OPTION_HASH_STYLE,
   OPTION_BUILD_ID,
+  OPTION_BUILD_ID_CHUNK_SIZE,
+  OPTION_BUILD_ID_MIN_FILE_SIZE,
   OPTION_PACKAGE_METADATA,
   OPTION_AUDIT,
   OPTION_COMPRESS_DEBUG
@@ -603,6 +606,10 @@ EOF
 fi
 fragment <<EOF
     {"build-id", optional_argument, NULL, OPTION_BUILD_ID},
+    {"build-id-chunk-size-for-treehash", required_argument, NULL,
+     OPTION_BUILD_ID_CHUNK_SIZE},
+    {"build-id-min-file-size-for-treehash", required_argument, NULL,
+     OPTION_BUILD_ID_MIN_FILE_SIZE},
     {"package-metadata", optional_argument, NULL, OPTION_PACKAGE_METADATA},
     {"compress-debug-sections", required_argument, NULL, OPTION_COMPRESS_DEBUG},
 EOF
@@ -652,6 +659,29 @@ gld${EMULATION_NAME}_handle_option (int optc)
 	ldelf_emit_note_gnu_build_id = xstrdup (optarg);
       break;
 
+    case OPTION_BUILD_ID_CHUNK_SIZE:
+      {
+	char *end;
+
+	build_id_tree_chunk_size = strtoul (optarg, &end, 0);
+	if (*end || end == optarg
+	    || build_id_tree_chunk_size > BUILD_ID_TREE_MAX_CHUNK_SIZE)
+	  einfo (_("%F%P: invalid --build-id-chunk-size-for-treehash \`%s'\n"),
+		 optarg);
+      }
+      break;
+
+    case OPTION_BUILD_ID_MIN_FILE_SIZE:
+      {
+	char *end;
+
+	build_id_tree_min_size = strtoul (optarg, &end, 0);
+	if (*end || end == optarg)
+	  einfo (_("%F%P: invalid --build-id-min-file-size-for-treehash"
+		   " \`%s'\n"), optarg);
+      }
+      break;
+
     case OPTION_PACKAGE_METADATA:
       free ((char *) ldelf_emit_note_fdo_package_metadata);
       ldelf_emit_note_fdo_package_metadata = NULL;
@@ -668,6 +698,15 @@ gld${EMULATION_NAME}_handle_option (int optc)
 	link_info.compress_debug = COMPRESS_DEBUG_GNU_ZLIB;
       else if (strcasecmp (optarg, "zlib-gabi") == 0)
 	link_info.compress_debug = COMPRESS_DEBUG_GABI_ZLIB;
+      else if (strcasecmp (optarg, "zstd") == 0)
+	{
+#ifdef HAVE_ZSTD
+	  link_info.compress_debug = COMPRESS_DEBUG_ZSTD;
+#else
+	  einfo (_("%F%P: --compress-debug-sections=zstd: ld is not built "
+		   "with zstd support\n"));
+#endif
+	}
       else
 	einfo (_("%F%P: invalid --compress-debug-sections option: \`%s'\n"),
 	       optarg);
@@ -20,10 +20,13 @@
 
 #include "sysdep.h"
 #include "bfd.h"
+#include "bfdlink.h"
 #include "safe-ctype.h"
+#include "libiberty.h"
 #include "md5.h"
 #include "sha1.h"
 #include "ldbuildid.h"
+#include "ldmain.h"
 #ifdef __MINGW32__
 #include <windows.h>
 #include <rpcdce.h>
@@ -31,10 +34,17 @@
 
 #define streq(a,b)     strcmp ((a), (b)) == 0
 
+/* For the "tree" style, the size of the chunks hashed separately, and
+   the size of the output below which a plain "sha1" is used instead.
+   The defaults are those of gold.  */
+bfd_size_type build_id_tree_chunk_size = 2 << 20;
+bfd_size_type build_id_tree_min_size = 40 << 20;
+
 bool
 validate_build_id_style (const char *style)
 {
   if ((streq (style, "md5")) || (streq (style, "sha1"))
+      || (streq (style, "tree"))
       || (streq (style, "uuid")) || (startswith (style, "0x")))
     return true;
 
@@ -47,7 +57,7 @@ compute_build_id_size (const char *style)
   if (streq (style, "md5") || streq (style, "uuid"))
     return 128 / 8;
 
-  if (streq (style, "sha1"))
+  if (streq (style, "sha1") || streq (style, "tree"))
     return 160 / 8;
 
   if (startswith (style, "0x"))
@@ -93,6 +103,173 @@ read_hex (const char xdigit)
   return 0;
 }
 
+/* A "tree" build ID is computed as in gold: the contents are split
+   into chunks of build_id_tree_chunk_size bytes, the MD5 of each chunk
+   is computed, and the build ID is the SHA1 of those MD5s.  The
+   chunks are hashed on the linker's threads, a batch at a time.  If
+   the contents are smaller than build_id_tree_min_size the result is
+   their plain SHA1, which is computed alongside until the contents
+   reach that size.  */
+
+#define MD5_DIGEST_SIZE 16
+
+/* Hash up to two chunks per thread at once, as long as they fit in
+   this many bytes.  */
+#define TREE_BATCH_BYTES (64 << 20)
+
+struct tree_hash
+{
+  /* Buffers for BATCH_MAX chunks.  */
+  unsigned char *batch;
+  size_t batch_max;
+  /* The number of chunks in BATCH, the last one possibly partial.  */
+  size_t batch_count;
+  /* The number of bytes in the last chunk of BATCH.  */
+  bfd_size_type last_size;
+  /* The MD5s of the chunks hashed so far.  */
+  unsigned char *digests;
+  size_t digest_count;
+  size_t digest_max;
+  /* The size of the contents seen so far.  */
+  bfd_size_type size;
+  /* Their SHA1, while SIZE is below build_id_tree_min_size.  */
+  struct sha1_ctx flat;
+};
+
+/* Compute the MD5 of chunk I of DATA's batch.  */
+
+static void
+tree_hash_chunk (void *data, size_t i)
+{
+  struct tree_hash *th = (struct tree_hash *) data;
+  bfd_size_type size;
+
+  size = (i + 1 == th->batch_count
+	  ? th->last_size : build_id_tree_chunk_size);
+  md5_buffer ((const char *) th->batch + i * build_id_tree_chunk_size,
+	      size, th->digests + (th->digest_count + i) * MD5_DIGEST_SIZE);
+}
+
+/* Hash the chunks in TH's batch, and empty it.  */
+
+static void
+tree_hash_flush (struct tree_hash *th)
+{
+  size_t i;
+
+  if (th->batch_count == 0)
+    return;
+
+  if (th->digest_count + th->batch_count > th->digest_max)
+    {
+      th->digest_max = (th->digest_count + th->batch_count) * 2;
+      th->digests = (unsigned char *) xrealloc (th->digests,
+						th->digest_max
+						* MD5_DIGEST_SIZE);
+    }
+
+  if (th->batch_count > 1
+      && link_info.threads > 1
+      && link_info.callbacks->parallel_for != NULL)
+    link_info.callbacks->parallel_for (&link_info, tree_hash_chunk, th,
+				       th->batch_count);
+  else
+    for (i = 0; i < th->batch_count; i++)
+      tree_hash_chunk (th, i);
+
+  th->digest_count += th->batch_count;
+  th->batch_count = 0;
+  th->last_size = 0;
+}
+
+/* A sum_fn adding LEN bytes at BUFFER to DATA, a tree_hash.  */
+
+static void
+tree_hash_process (const void *buffer, size_t len, void *data)
+{
+  struct tree_hash *th = (struct tree_hash *) data;
+  const unsigned char *p = (const unsigned char *) buffer;
+
+  if (th->size < build_id_tree_min_size)
+    sha1_process_bytes (buffer, len, &th->flat);
+  th->size += len;
+
+  while (len != 0)
+    {
+      bfd_size_type n;
+
+      if (th->batch_count == 0
+	  || th->last_size == build_id_tree_chunk_size)
+	{
+	  if (th->batch_count == th->batch_max)
+	    tree_hash_flush (th);
+	  th->batch_count++;
+	  th->last_size = 0;
+	}
+
+      n = build_id_tree_chunk_size - th->last_size;
+      if (n > len)
+	n = len;
+      memcpy (th->batch + ((th->batch_count - 1) * build_id_tree_chunk_size
+			   + th->last_size), p, n);
+      th->last_size += n;
+      p += n;
+      len -= n;
+    }
+}
+
+/* Compute a "tree" build ID for ABFD into ID_BITS.  */
+
+static bool
+generate_tree_build_id (bfd *abfd, checksum_fn checksum_contents,
+			unsigned char *id_bits)
+{
+  struct tree_hash th;
+  bool ret;
+
+  /* Without chunks, this is just "sha1".  */
+  if (build_id_tree_chunk_size == 0)
+    {
+      sha1_init_ctx (&th.flat);
+      if (!(*checksum_contents) (abfd, (sum_fn) &sha1_process_bytes,
+				 &th.flat))
+	return false;
+      sha1_finish_ctx (&th.flat, id_bits);
+      return true;
+    }
+
+  memset (&th, 0, sizeof (th));
+  th.batch_max = 1;
+  if (link_info.threads > 1 && link_info.callbacks->parallel_for != NULL)
+    {
+      th.batch_max = (size_t) link_info.threads * 2;
+      if (th.batch_max > TREE_BATCH_BYTES / build_id_tree_chunk_size)
+	th.batch_max = TREE_BATCH_BYTES / build_id_tree_chunk_size;
+      if (th.batch_max == 0)
+	th.batch_max = 1;
+    }
+  th.batch = (unsigned char *) xmalloc (th.batch_max
+					* build_id_tree_chunk_size);
+  sha1_init_ctx (&th.flat);
+
+  ret = (*checksum_contents) (abfd, tree_hash_process, &th);
+  if (ret)
+    {
+      if (th.size != 0 && th.size >= build_id_tree_min_size)
+	{
+	  tree_hash_flush (&th);
+	  sha1_buffer ((const char *) th.digests,
+		       th.digest_count * MD5_DIGEST_SIZE, id_bits);
+	}
+      else
+	sha1_finish_ctx (&th.flat, id_bits);
+    }
+
+  free (th.batch);
+  free (th.digests);
+  return ret;
+}
+
 bool
 generate_build_id (bfd *abfd,
 		   const char *style,
@@ -118,6 +295,11 @@ generate_build_id (bfd *abfd,
 	return false;
       sha1_finish_ctx (&ctx, id_bits);
     }
+  else if (streq (style, "tree"))
+    {
+      if (!generate_tree_build_id (abfd, checksum_contents, id_bits))
+	return false;
+    }
   else if (streq (style, "uuid"))
     {
 #ifndef __MINGW32__
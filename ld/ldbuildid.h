@@ -21,6 +21,13 @@
 #ifndef LDBUILDID_H
 #define LDBUILDID_H
 
+/* The largest chunk size accepted for --build-id=tree.  Each chunk is
+   copied to a buffer of that size before it is hashed.  */
+#define BUILD_ID_TREE_MAX_CHUNK_SIZE ((bfd_size_type) 1 << 30)
+
+extern bfd_size_type build_id_tree_chunk_size;
+extern bfd_size_type build_id_tree_min_size;
+
 extern bool
 validate_build_id_style (const char *);
 
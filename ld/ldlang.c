@@ -59,6 +59,7 @@
 /* Local variables.  */
 static struct obstack stat_obstack;
 static struct obstack map_obstack;
+static struct obstack wild_obstack;
 
 #define obstack_chunk_alloc xmalloc
 #define obstack_chunk_free free
@@ -948,34 +949,364 @@ walk_wild_file (lang_wild_statement_type *s,
     }
 }
 
+/* Matching input sections against the section specs of wild
+   statements one statement at a time costs sections times specs, which
+   gets slow with scripts that have hundreds of rules.  Instead all the
+   specs are put in a trie keyed by their literal names, or for specs
+   with wildcards the literal prefix before the first wildcard.  Each
+   input section is then looked up once, giving the few specs that can
+   match it, and the section is recorded against each statement that
+   it matches.  walk_wild replays those records in the same order the
+   one statement at a time walk would have visited them.  */
+
+/* A section spec in the trie.  */
+
+struct wild_trie_spec
+{
+  struct wild_trie_spec *next;
+  lang_wild_statement_type *stmt;
+  /* NULL for a statement without a section list, which matches every
+     section.  */
+  struct wildcard_list *spec;
+  /* Where the spec comes among all specs of all wild statements.  */
+  unsigned int order;
+  /* Whether finding the spec in the trie is not enough to know that
+     it matches, so name_match must be called.  */
+  bool need_match;
+};
+
+/* A node of the trie, for the string spelled out by the path from the
+   root.  */
+
+struct wild_trie
+{
+  struct wild_trie *child;
+  struct wild_trie *sibling;
+  char c;
+  /* Specs without wildcards equal to this node's string.  */
+  struct wild_trie_spec *exact;
+  /* Specs with wildcards whose literal prefix is this node's
+     string.  */
+  struct wild_trie_spec *prefix;
+};
+
+/* A section matched by a wild statement.  */
+
+struct wild_match
+{
+  asection *section;
+  struct wildcard_list *spec;
+  lang_input_statement_type *file;
+};
+
+/* All the statements created by lang_add_wild.  */
+static lang_wild_statement_type *wild_list_head;
+static lang_wild_statement_type **wild_list_tail = &wild_list_head;
+
+/* The trie of section specs, or NULL if a statement has been added
+   since it was built.  */
+static struct wild_trie *wild_trie_root;
+
+/* Whether the matches of the wild statements are up to date, and the
+   number of input files and sections when they were computed.  */
+static bool wilds_resolved;
+static unsigned int wilds_file_count;
+static unsigned int wilds_section_count;
+
+/* Whether wild statement S is handled using the trie.  Statements
+   naming a single file look it up with lookup_name, which may load
+   it, so they are left to walk that file directly.  */
+
+static bool
+wild_statement_uses_trie (lang_wild_statement_type *s)
+{
+  return (s->filename == NULL
+	  || archive_path (s->filename) != NULL
+	  || wildcardp (s->filename));
+}
+
+/* Return the trie node for the first LEN characters of NAME, creating
+   it if need be.  */
+
+static struct wild_trie *
+wild_trie_node (const char *name, size_t len)
+{
+  struct wild_trie *node = wild_trie_root;
+  size_t i;
+
+  for (i = 0; i < len; i++)
+    {
+      struct wild_trie **link = &node->child;
+
+      while (*link != NULL && (*link)->c != name[i])
+	link = &(*link)->sibling;
+      if (*link == NULL)
+	{
+	  *link = obstack_alloc (&wild_obstack, sizeof (**link));
+	  memset (*link, 0, sizeof (**link));
+	  (*link)->c = name[i];
+	}
+      node = *link;
+    }
+  return node;
+}
+
+/* Add SPEC of wild statement S to the trie.  */
+
 static void
-walk_wild (lang_wild_statement_type *s, callback_t callback, void *data)
+wild_trie_add (lang_wild_statement_type *s, struct wildcard_list *spec,
+	       unsigned int order)
+{
+  struct wild_trie_spec *ts;
+  struct wild_trie_spec **list;
+  const char *name = spec != NULL ? spec->spec.name : NULL;
+
+  ts = obstack_alloc (&wild_obstack, sizeof (*ts));
+  ts->stmt = s;
+  ts->spec = spec;
+  ts->order = order;
+  ts->need_match = false;
+  if (name == NULL)
+    list = &wild_trie_root->prefix;
+  else if (!wildcardp (name))
+    list = &wild_trie_node (name, strlen (name))->exact;
+  else
+    {
+      /* fnmatch treats backslash as an escape, so the literal prefix
+	 stops there too.  A literal prefix followed by a single '*' is
+	 matched by reaching its node.  */
+      size_t len = strcspn (name, "?*[\\");
+
+      ts->need_match = name[len] != '*' || name[len + 1] != '\0';
+      list = &wild_trie_node (name, len)->prefix;
+    }
+  ts->next = *list;
+  *list = ts;
+}
+
+/* Build the trie from all the wild statements.  */
+
+static void
+wild_trie_build (void)
+{
+  lang_wild_statement_type *s;
+  unsigned int order = 0;
+
+  if (wild_trie_root != NULL)
+    obstack_free (&wild_obstack, wild_trie_root);
+  wild_trie_root = obstack_alloc (&wild_obstack, sizeof (*wild_trie_root));
+  memset (wild_trie_root, 0, sizeof (*wild_trie_root));
+
+  for (s = wild_list_head; s != NULL; s = s->next_wild)
+    if (wild_statement_uses_trie (s))
+      {
+	struct wildcard_list *sec;
+
+	if (s->section_list == NULL)
+	  wild_trie_add (s, NULL, order++);
+	for (sec = s->section_list; sec != NULL; sec = sec->next)
+	  wild_trie_add (s, sec, order++);
+      }
+}
+
+/* Return true if wild statement S applies to the sections of F, as
+   walk_wild and walk_wild_file decide it.  */
+
+static bool
+wild_file_matches (lang_wild_statement_type *s, lang_input_statement_type *f)
 {
   const char *file_spec = s->filename;
   char *p;
 
-  if (file_spec == NULL)
+  if (file_spec != NULL)
     {
-      /* Perform the iteration over all files in the list.  */
-      LANG_FOR_EACH_INPUT_STATEMENT (f)
+      if ((p = archive_path (file_spec)) != NULL)
 	{
-	  walk_wild_file (s, f, callback, data);
+	  if (!input_statement_is_archive_path (file_spec, p, f))
+	    return false;
 	}
+      else if (fnmatch (file_spec, f->filename, 0) != 0)
+	return false;
     }
-  else if ((p = archive_path (file_spec)) != NULL)
+  return !walk_wild_file_in_exclude_list (s->exclude_name_list, f);
+}
+
+static int
+wild_trie_spec_compare (const void *a, const void *b)
+{
+  const struct wild_trie_spec *sa = *(const struct wild_trie_spec **) a;
+  const struct wild_trie_spec *sb = *(const struct wild_trie_spec **) b;
+
+  return (sa->order > sb->order) - (sa->order < sb->order);
+}
+
+/* Look up section S of FILE in the trie, and record it against each
+   statement with a spec that matches it.  F is the file named in the
+   statement list, which is FILE's archive if FILE is a member.  */
+
+static void
+resolve_wild_section (lang_input_statement_type *f,
+		      lang_input_statement_type *file, asection *s)
+{
+  static struct wild_trie_spec **found;
+  static size_t found_alloc;
+  size_t found_count = 0;
+  const char *sname = bfd_section_name (s);
+  struct wild_trie *node = wild_trie_root;
+  struct wild_trie_spec *ts;
+  const char *c;
+  size_t i;
+
+  for (c = sname; ; c++)
     {
-      LANG_FOR_EACH_INPUT_STATEMENT (f)
+      for (ts = node->prefix; ts != NULL; ts = ts->next)
+	{
+	  if (found_count == found_alloc)
+	    {
+	      found_alloc = found_alloc * 2 + 16;
+	      found = xrealloc (found, found_alloc * sizeof (*found));
+	    }
+	  found[found_count++] = ts;
+	}
+      if (*c == '\0')
+	{
+	  for (ts = node->exact; ts != NULL; ts = ts->next)
+	    {
+	      if (found_count == found_alloc)
+		{
+		  found_alloc = found_alloc * 2 + 16;
+		  found = xrealloc (found, found_alloc * sizeof (*found));
+		}
+	      found[found_count++] = ts;
+	    }
+	  break;
+	}
+      for (node = node->child; node != NULL; node = node->sibling)
+	if (node->c == *c)
+	  break;
+      if (node == NULL)
+	break;
+    }
+
+  /* Statements must see the specs that match in the order they were
+     written, as walk_wild_section_general would.  */
+  if (found_count > 1)
+    qsort (found, found_count, sizeof (*found), wild_trie_spec_compare);
+
+  for (i = 0; i < found_count; i++)
+    {
+      lang_wild_statement_type *stmt;
+      struct wild_match *m;
+
+      ts = found[i];
+      if (ts->need_match && name_match (ts->spec->spec.name, sname) != 0)
+	continue;
+      stmt = ts->stmt;
+      if (!wild_file_matches (stmt, f))
+	continue;
+      if (stmt->match_count == stmt->match_alloc)
 	{
-	  if (input_statement_is_archive_path (file_spec, p, f))
-	    walk_wild_file (s, f, callback, data);
+	  stmt->match_alloc = stmt->match_alloc * 2 + 16;
+	  stmt->matches = xrealloc (stmt->matches,
+				    stmt->match_alloc * sizeof (*m));
 	}
+      m = &stmt->matches[stmt->match_count++];
+      m->section = s;
+      m->spec = ts->spec;
+      m->file = file;
     }
-  else if (wildcardp (file_spec))
+}
+
+/* Record the sections of FILE matched by each wild statement.  */
+
+static void
+resolve_wild_file (lang_input_statement_type *f,
+		   lang_input_statement_type *file)
+{
+  asection *s;
+
+  if (file->flags.just_syms)
+    return;
+
+  for (s = file->the_bfd->sections; s != NULL; s = s->next)
+    resolve_wild_section (f, file, s);
+}
+
+/* Find the sections matched by every wild statement that uses the
+   trie, unless that has already been done for the current set of
+   statements and input sections.  */
+
+static void
+resolve_wilds (void)
+{
+  lang_wild_statement_type *s;
+  lang_input_statement_type *f;
+  unsigned int file_count = 0;
+  unsigned int section_count = 0;
+
+  for (f = (lang_input_statement_type *) file_chain.head;
+       f != NULL;
+       f = f->next)
     {
-      LANG_FOR_EACH_INPUT_STATEMENT (f)
+      file_count++;
+      if (f->the_bfd != NULL)
+	section_count += f->the_bfd->section_count;
+    }
+
+  if (wilds_resolved
+      && file_count == wilds_file_count
+      && section_count == wilds_section_count)
+    return;
+
+  if (wild_trie_root == NULL)
+    wild_trie_build ();
+
+  for (s = wild_list_head; s != NULL; s = s->next_wild)
+    s->match_count = 0;
+
+  for (f = (lang_input_statement_type *) file_chain.head;
+       f != NULL;
+       f = f->next)
+    {
+      if (f->the_bfd == NULL)
+	continue;
+
+      if (!bfd_check_format (f->the_bfd, bfd_archive))
+	resolve_wild_file (f, f);
+      else
+	{
+	  bfd *member;
+
+	  for (member = bfd_openr_next_archived_file (f->the_bfd, NULL);
+	       member != NULL;
+	       member = bfd_openr_next_archived_file (f->the_bfd, member))
+	    if (bfd_usrdata (member) != NULL)
+	      resolve_wild_file (f, bfd_usrdata (member));
+	}
+    }
+
+  wilds_resolved = true;
+  wilds_file_count = file_count;
+  wilds_section_count = section_count;
+}
+
+static void
+walk_wild (lang_wild_statement_type *s, callback_t callback, void *data)
+{
+  if (wild_statement_uses_trie (s))
+    {
+      size_t i;
+
+      resolve_wilds ();
+      for (i = 0; i < s->match_count; i++)
 	{
-	  if (fnmatch (file_spec, f->filename, 0) == 0)
-	    walk_wild_file (s, f, callback, data);
+	  struct wild_match *m = &s->matches[i];
+
+	  if (m->spec == NULL)
+	    (*callback) (s, NULL, m->section, m->file, data);
+	  else
+	    walk_wild_consider_section (s, m->file, m->section, m->spec,
+					callback, data);
 	}
     }
   else
@@ -983,7 +1314,7 @@ walk_wild (lang_wild_statement_type *s, callback_t callback, void *data)
       lang_input_statement_type *f;
 
       /* Perform the iteration over a single file.  */
-      f = lookup_name (file_spec);
+      f = lookup_name (s->filename);
       if (f)
 	walk_wild_file (s, f, callback, data);
     }
@@ -1291,6 +1622,7 @@ void
 lang_init (void)
 {
   obstack_begin (&stat_obstack, 1000);
+  obstack_begin (&wild_obstack, 1000);
 
   stat_ptr = &statement_list;
 
@@ -1315,7 +1647,12 @@ lang_init (void)
 void
 lang_finish (void)
 {
+  lang_wild_statement_type *s;
+
   output_section_statement_table_free ();
+  for (s = wild_list_head; s != NULL; s = s->next_wild)
+    free (s->matches);
+  obstack_free (&wild_obstack, NULL);
 }
 
 /*----------------------------------------------------------------------
@@ -3796,6 +4133,18 @@ ldlang_open_ctf (void)
     ctf_close (errfile->the_ctf);
 }
 
+/* Let libctf hash the types of its link inputs on the linker's
+   threads.  */
+
+static void
+lang_ctf_parallel_for (ctf_link_parallel_fn_f *fn, void *data, size_t count,
+		       void *arg)
+{
+  struct bfd_link_info *info = (struct bfd_link_info *) arg;
+
+  info->callbacks->parallel_for (info, fn, data, count);
+}
+
 /* Merge together CTF sections.  After this, only the symtab-dependent
    function and data object sections need adjustment.  */
 
@@ -3849,6 +4198,9 @@ lang_merge_ctf (void)
   if (bfd_link_relocatable (&link_info))
     flags |= CTF_LINK_NO_FILTER_REPORTED_SYMS;
 
+  if (link_info.threads > 1 && link_info.callbacks->parallel_for != NULL)
+    ctf_link_set_parallel_for (ctf_output, lang_ctf_parallel_for, &link_info);
+
   if (ctf_link (ctf_output, flags) < 0)
     {
       lang_ctf_errs_warnings (ctf_output);
@@ -7674,6 +8026,24 @@ lang_gc_sections_1 (lang_statement_union_type *s)
     }
 }
 
+/* Count the input sections that are not excluded from the link.  */
+
+static unsigned long
+lang_count_kept_sections (void)
+{
+  unsigned long count = 0;
+
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      asection *sec;
+
+      for (sec = f->the_bfd->sections; sec != NULL; sec = sec->next)
+	if ((sec->flags & SEC_EXCLUDE) == 0)
+	  count++;
+    }
+  return count;
+}
+
 static void
 lang_gc_sections (void)
 {
@@ -7700,7 +8070,30 @@ lang_gc_sections (void)
     }
 
   if (link_info.gc_sections)
-    bfd_gc_sections (link_info.output_bfd, &link_info);
+    {
+      long start_time = 0;
+      unsigned long before = 0;
+
+      if (config.stats)
+	{
+	  start_time = get_run_time ();
+	  before = lang_count_kept_sections ();
+	}
+
+      bfd_gc_sections (link_info.output_bfd, &link_info);
+
+      if (config.stats)
+	{
+	  long run_time = get_run_time () - start_time;
+
+	  fflush (stdout);
+	  fprintf (stderr, _("%s: gc-sections: kept %lu of %lu input sections"
+			     " in %ld.%06ld\n"),
+		   program_name, lang_count_kept_sections (), before,
+		   run_time / 1000000, run_time % 1000000);
+	  fflush (stderr);
+	}
+    }
 }
 
 /* Worker for lang_find_relro_sections_1.  */
@@ -8401,6 +8794,19 @@ lang_add_wild (struct wildcard_spec *filespec,
   new_stmt->keep_sections = keep_sections;
   lang_list_init (&new_stmt->children);
   analyze_walk_wild_section_handler (new_stmt);
+
+  new_stmt->next_wild = NULL;
+  new_stmt->matches = NULL;
+  new_stmt->match_count = 0;
+  new_stmt->match_alloc = 0;
+  *wild_list_tail = new_stmt;
+  wild_list_tail = &new_stmt->next_wild;
+  if (wild_trie_root != NULL)
+    {
+      obstack_free (&wild_obstack, wild_trie_root);
+      wild_trie_root = NULL;
+    }
+  wilds_resolved = false;
 }
 
 void
@@ -391,6 +391,14 @@ struct lang_wild_statement_struct
   struct wildcard_list *handler_data[4];
   lang_section_bst_type *tree;
   struct flag_info *section_flag_list;
+
+  /* The next statement created by lang_add_wild.  */
+  lang_wild_statement_type *next_wild;
+  /* The input sections matched by this statement, in the order in
+     which walk_wild visits them, as found by resolve_wilds.  */
+  struct wild_match *matches;
+  size_t match_count;
+  size_t match_alloc;
 };
 
 typedef struct lang_address_statement_struct
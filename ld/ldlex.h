@@ -168,6 +168,8 @@ enum option_values
   OPTION_NO_WARN_EXECSTACK,
   OPTION_WARN_RWX_SEGMENTS,
   OPTION_NO_WARN_RWX_SEGMENTS,
+  OPTION_THREADS,
+  OPTION_NO_THREADS,
 };
 
 /* The initial parser states.  */
@@ -52,6 +52,10 @@
 
 #include <string.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #ifndef TARGET_SYSTEM_ROOT
 #define TARGET_SYSTEM_ROOT ""
 #endif
@@ -133,6 +137,12 @@ static void unattached_reloc
 static bool notice
   (struct bfd_link_info *, struct bfd_link_hash_entry *,
    struct bfd_link_hash_entry *, bfd *, asection *, bfd_vma, flagword);
+#ifdef HAVE_PTHREAD
+static void ld_parallel_for
+  (struct bfd_link_info *, void (*) (void *, size_t), void *, size_t);
+#else
+#define ld_parallel_for NULL
+#endif
 
 static struct bfd_link_callbacks link_callbacks =
 {
@@ -154,7 +164,8 @@ static struct bfd_link_callbacks link_callbacks =
   ldlang_ctf_acquire_strings,
   NULL,
   ldlang_ctf_new_dynsym,
-  ldlang_write_ctf_late
+  ldlang_write_ctf_late,
+  ld_parallel_for
 };
 
 static bfd_assert_handler_type default_bfd_assert_handler;
@@ -230,15 +241,267 @@ ld_bfd_assert_handler (const char *fmt, const char *bfdver,
   (*default_bfd_assert_handler) (fmt, bfdver, file, line);
 }
 
+#ifdef HAVE_PTHREAD
+/* While ld_parallel_for has worker threads running, this lock
+   serializes diagnostics and the callbacks that report them.
+   PARALLEL_LOCK_DEPTH is the number of times the thread holding the
+   lock has taken it.  */
+static pthread_mutex_t parallel_lock;
+static unsigned int parallel_lock_depth;
+static bool parallel_active;
+
+/* The work of the running ld_parallel_for, and whether one of its
+   workers has reported a fatal error.  */
+static struct parallel_for_data *parallel_current;
+static bool parallel_fatal;
+
+static void
+parallel_lock_acquire (void)
+{
+  pthread_mutex_lock (&parallel_lock);
+  parallel_lock_depth++;
+}
+
+static void
+parallel_lock_release (void)
+{
+  parallel_lock_depth--;
+  pthread_mutex_unlock (&parallel_lock);
+}
+#endif
+
 /* Hook the bfd error/warning handler for --fatal-warnings.  */
 
 static void
 ld_bfd_error_handler (const char *fmt, va_list ap)
 {
+#ifdef HAVE_PTHREAD
+  bool locked = parallel_active;
+  if (locked)
+    parallel_lock_acquire ();
+#endif
   if (config.fatal_warnings)
     config.make_executable = false;
   (*default_bfd_error_handler) (fmt, ap);
+#ifdef HAVE_PTHREAD
+  if (locked)
+    parallel_lock_release ();
+#endif
+}
+
+#ifdef HAVE_PTHREAD
+/* Locked versions of the callbacks that BFD may make from
+   relocate_section while it runs on a worker thread.  */
+
+static void
+locked_warning (struct bfd_link_info *info, const char *warning,
+		const char *symbol, bfd *abfd, asection *section,
+		bfd_vma address)
+{
+  parallel_lock_acquire ();
+  warning_callback (info, warning, symbol, abfd, section, address);
+  parallel_lock_release ();
+}
+
+static void
+locked_undefined_symbol (struct bfd_link_info *info, const char *name,
+			 bfd *abfd, asection *section, bfd_vma address,
+			 bool error)
+{
+  parallel_lock_acquire ();
+  undefined_symbol (info, name, abfd, section, address, error);
+  parallel_lock_release ();
+}
+
+static void
+locked_reloc_overflow (struct bfd_link_info *info,
+		       struct bfd_link_hash_entry *entry, const char *name,
+		       const char *reloc_name, bfd_vma addend, bfd *abfd,
+		       asection *section, bfd_vma address)
+{
+  parallel_lock_acquire ();
+  reloc_overflow (info, entry, name, reloc_name, addend, abfd, section,
+		  address);
+  parallel_lock_release ();
+}
+
+static void
+locked_reloc_dangerous (struct bfd_link_info *info, const char *message,
+			bfd *abfd, asection *section, bfd_vma address)
+{
+  parallel_lock_acquire ();
+  reloc_dangerous (info, message, abfd, section, address);
+  parallel_lock_release ();
+}
+
+static void
+locked_unattached_reloc (struct bfd_link_info *info, const char *name,
+			 bfd *abfd, asection *section, bfd_vma address)
+{
+  parallel_lock_acquire ();
+  unattached_reloc (info, name, abfd, section, address);
+  parallel_lock_release ();
+}
+
+static void
+locked_einfo (const char *fmt, ...)
+{
+  va_list arg;
+
+  parallel_lock_acquire ();
+  fflush (stdout);
+  va_start (arg, fmt);
+  vfinfo (stderr, fmt, arg, true);
+  va_end (arg);
+  fflush (stderr);
+  parallel_lock_release ();
+}
+
+static void
+locked_info_msg (const char *fmt, ...)
+{
+  va_list arg;
+
+  parallel_lock_acquire ();
+  va_start (arg, fmt);
+  vfinfo (stdout, fmt, arg, false);
+  va_end (arg);
+  parallel_lock_release ();
+}
+
+struct parallel_for_data
+{
+  void (*fn) (void *, size_t);
+  void *data;
+  size_t count;
+  size_t next;
+  pthread_mutex_t next_lock;
+};
+
+static void *
+parallel_for_worker (void *arg)
+{
+  struct parallel_for_data *pf = (struct parallel_for_data *) arg;
+
+  for (;;)
+    {
+      size_t i;
+
+      pthread_mutex_lock (&pf->next_lock);
+      i = pf->next++;
+      pthread_mutex_unlock (&pf->next_lock);
+      if (i >= pf->count)
+	break;
+      pf->fn (pf->data, i);
+    }
+  return NULL;
+}
+
+/* Called by vfinfo before it exits for a fatal error.  On a worker
+   thread of ld_parallel_for, this records the error, stops the other
+   workers from starting more work and ends the thread, so that the
+   error is raised on the main thread once the workers are done.
+   Otherwise it returns.  */
+
+void
+ld_parallel_fatal (void)
+{
+  if (!parallel_active)
+    return;
+
+  parallel_lock_acquire ();
+  parallel_fatal = true;
+  pthread_mutex_lock (&parallel_current->next_lock);
+  parallel_current->next = parallel_current->count;
+  pthread_mutex_unlock (&parallel_current->next_lock);
+  while (parallel_lock_depth != 0)
+    parallel_lock_release ();
+  pthread_exit (NULL);
+}
+
+/* Call FN (DATA, I) for each I below COUNT, spreading the calls over
+   up to INFO->threads threads.  Returns once all calls are done.  The
+   calling thread only waits for the workers, so that a fatal error
+   reported by one of them is raised here once the others have
+   stopped.  */
+
+static void
+ld_parallel_for (struct bfd_link_info *info,
+		 void (*fn) (void *, size_t), void *data, size_t count)
+{
+  struct parallel_for_data pf;
+  struct bfd_link_callbacks locked_callbacks;
+  const struct bfd_link_callbacks *saved_callbacks;
+  pthread_mutexattr_t attr;
+  pthread_t *threads;
+  size_t nthreads, started, i;
+
+  nthreads = info->threads < count ? info->threads : count;
+  if (nthreads <= 1)
+    {
+      for (i = 0; i < count; i++)
+	fn (data, i);
+      return;
+    }
+
+  pf.fn = fn;
+  pf.data = data;
+  pf.count = count;
+  pf.next = 0;
+  pthread_mutex_init (&pf.next_lock, NULL);
+
+  /* The reporting callbacks may call one another, so the lock needs
+     to be recursive.  */
+  pthread_mutexattr_init (&attr);
+  pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init (&parallel_lock, &attr);
+  pthread_mutexattr_destroy (&attr);
+
+  saved_callbacks = info->callbacks;
+  locked_callbacks = *saved_callbacks;
+  locked_callbacks.warning = locked_warning;
+  locked_callbacks.undefined_symbol = locked_undefined_symbol;
+  locked_callbacks.reloc_overflow = locked_reloc_overflow;
+  locked_callbacks.reloc_dangerous = locked_reloc_dangerous;
+  locked_callbacks.unattached_reloc = locked_unattached_reloc;
+  locked_callbacks.einfo = locked_einfo;
+  locked_callbacks.info = locked_info_msg;
+  info->callbacks = &locked_callbacks;
+  parallel_current = &pf;
+  parallel_fatal = false;
+  parallel_active = true;
+
+  threads = (pthread_t *) xmalloc (nthreads * sizeof (*threads));
+  for (started = 0; started < nthreads; started++)
+    if (pthread_create (&threads[started], NULL, parallel_for_worker,
+			&pf) != 0)
+      break;
+  for (i = 0; i < started; i++)
+    pthread_join (threads[i], NULL);
+  free (threads);
+
+  parallel_active = false;
+  parallel_current = NULL;
+  info->callbacks = saved_callbacks;
+  pthread_mutex_destroy (&parallel_lock);
+
+  /* Whatever no thread could be started for is done here, with the
+     usual callbacks.  */
+  if (!parallel_fatal)
+    parallel_for_worker (&pf);
+  pthread_mutex_destroy (&pf.next_lock);
+
+  if (parallel_fatal)
+    xexit (1);
+}
+
+#else /* !HAVE_PTHREAD */
+
+void
+ld_parallel_fatal (void)
+{
 }
+#endif /* HAVE_PTHREAD */
 
 int
 main (int argc, char **argv)
@@ -508,6 +771,8 @@ main (int argc, char **argv)
       link_info.output_bfd->flags |= BFD_COMPRESS;
       if (link_info.compress_debug == COMPRESS_DEBUG_GABI_ZLIB)
 	link_info.output_bfd->flags |= BFD_COMPRESS_GABI;
+      else if (link_info.compress_debug == COMPRESS_DEBUG_ZSTD)
+	link_info.output_bfd->flags |= BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD;
     }
 
   ldwrite ();
@@ -584,7 +584,10 @@ vfinfo (FILE *fp, const char *fmt, va_list ap, bool is_warning)
     config.make_executable = false;
 
   if (fatal)
-    xexit (1);
+    {
+      ld_parallel_fatal ();
+      xexit (1);
+    }
 }
 
 /* Format info message and print on stdout.  */
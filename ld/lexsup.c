@@ -438,6 +438,12 @@ static const struct ld_option ld_options[] =
     OPTION_MAX_CACHE_SIZE},
     '\0', NULL, N_("Set the maximum cache size to SIZE bytes"),
     TWO_DASHES },
+  { {"threads", optional_argument, NULL, OPTION_THREADS},
+    '\0', N_("[=COUNT]"),
+    N_("Use COUNT threads for parts of the link that can run in parallel"),
+    TWO_DASHES },
+  { {"no-threads", no_argument, NULL, OPTION_NO_THREADS},
+    '\0', NULL, N_("Do not use multiple threads (default)"), TWO_DASHES },
   { {"relax", no_argument, NULL, OPTION_RELAX},
     '\0', NULL, N_("Reduce code size by using target specific optimizations"), TWO_DASHES },
   { {"no-relax", no_argument, NULL, OPTION_NO_RELAX},
@@ -1653,7 +1659,7 @@ parse_args (unsigned argc, char **argv)
 	case OPTION_REDUCE_MEMORY_OVERHEADS:
 	  link_info.reduce_memory_overheads = true;
 	  if (config.hash_table_size == 0)
-	    config.hash_table_size = 1021;
+	    config.hash_table_size = 1024;
 	  break;
 
 	case OPTION_MAX_CACHE_SIZE:
@@ -1667,6 +1673,30 @@ parse_args (unsigned argc, char **argv)
 	  }
 	  break;
 
+	case OPTION_THREADS:
+	  if (optarg == NULL)
+	    {
+#ifdef _SC_NPROCESSORS_ONLN
+	      long ncpus = sysconf (_SC_NPROCESSORS_ONLN);
+	      link_info.threads = ncpus > 0 ? ncpus : 1;
+#else
+	      link_info.threads = 1;
+#endif
+	    }
+	  else
+	    {
+	      char *end;
+	      unsigned long count = strtoul (optarg, &end, 0);
+	      if (*end != '\0' || count == 0)
+		einfo (_("%F%P: invalid thread count: %s\n"), optarg);
+	      link_info.threads = count;
+	    }
+	  break;
+
+	case OPTION_NO_THREADS:
+	  link_info.threads = 0;
+	  break;
+
 	case OPTION_HASH_SIZE:
 	  {
 	    bfd_size_type new_size;
@@ -2144,10 +2174,17 @@ elf_static_list_options (FILE *file)
   fprintf (file, _("\
   --build-id[=STYLE]          Generate build ID note\n"));
   fprintf (file, _("\
+  --build-id-chunk-size-for-treehash=SIZE\n\
+                              Chunk size for --build-id=tree\n"));
+  fprintf (file, _("\
+  --build-id-min-file-size-for-treehash=SIZE\n\
+                              Minimum output size for --build-id=tree\n\
+                                to differ from --build-id=sha1\n"));
+  fprintf (file, _("\
   --package-metadata[=JSON]   Generate package metadata note\n"));
   fprintf (file, _("\
-  --compress-debug-sections=[none|zlib|zlib-gnu|zlib-gabi]\n\
-                              Compress DWARF debug sections using zlib\n"));
+  --compress-debug-sections=[none|zlib|zlib-gnu|zlib-gabi|zstd]\n\
+                              Compress DWARF debug sections\n"));
 #ifdef DEFAULT_FLAG_COMPRESS_DEBUG
   fprintf (file, _("\
                                 Default: zlib-gabi\n"));
@@ -0,0 +1,40 @@
+# A chain of sections, each of them referenced only by the one before
+# it, which is too long for --gc-sections to mark recursively.  The
+# sections referring to the chain from outside it must be collected.
+
+	.altmacro
+	.macro	live i, j
+	.section .data.live\i,"aw"
+	.global	live\i
+live\i:
+	.dc.a	live\j
+	.endm
+
+	.macro	dead i
+	.section .data.dead\i,"aw"
+	.global	dead\i
+dead\i:
+	.dc.a	live\i
+	.endm
+
+	.text
+	.global	_start
+_start:
+	.dc.a	live1
+
+	i = 0
+	.rept	50000
+	i = i + 1
+	live	%(i), %(i+1)
+	.endr
+
+	.section .data.live50001,"aw"
+	.global	live50001
+live50001:
+	.dc.a	0
+
+	i = 0
+	.rept	100
+	i = i + 500
+	dead	%(i)
+	.endr
@@ -0,0 +1,24 @@
+	.section .rodata.str1.1,"aMS",%progbits,1
+.LC0:
+	.string	"shared string"
+.LC1:
+	.string	"string 1"
+
+	.data
+	.globl	data1
+data1:
+	.dc.a	.LC0
+	.dc.a	.LC1
+	.dc.a	data2
+	.dc.a	local1
+
+	.section .data.a1,"aw",%progbits
+local1:
+	.dc.a	.LC1
+	.dc.a	data1
+	.dc.a	local1
+
+	.section .data.b1,"aw",%progbits
+	.dc.a	.LC0
+	.dc.a	local1 + 4
+	.dc.a	data2
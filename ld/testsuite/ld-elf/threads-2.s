@@ -0,0 +1,24 @@
+	.section .rodata.str1.1,"aMS",%progbits,1
+.LC0:
+	.string	"shared string"
+.LC1:
+	.string	"string 2"
+
+	.data
+	.globl	data2
+data2:
+	.dc.a	.LC0
+	.dc.a	.LC1
+	.dc.a	data3
+	.dc.a	local2
+
+	.section .data.a2,"aw",%progbits
+local2:
+	.dc.a	.LC1
+	.dc.a	data2
+	.dc.a	local2
+
+	.section .data.b2,"aw",%progbits
+	.dc.a	.LC0
+	.dc.a	local2 + 4
+	.dc.a	data3
@@ -0,0 +1,24 @@
+	.section .rodata.str1.1,"aMS",%progbits,1
+.LC0:
+	.string	"shared string"
+.LC1:
+	.string	"string 3"
+
+	.data
+	.globl	data3
+data3:
+	.dc.a	.LC0
+	.dc.a	.LC1
+	.dc.a	data1
+	.dc.a	local3
+
+	.section .data.a3,"aw",%progbits
+local3:
+	.dc.a	.LC1
+	.dc.a	data3
+	.dc.a	local3
+
+	.section .data.b3,"aw",%progbits
+	.dc.a	.LC0
+	.dc.a	local3 + 4
+	.dc.a	data1
@@ -0,0 +1,21 @@
+	.section .text.b,"aw"
+two_b:
+	.byte 2
+	.section .text.abc,"aw"
+one_abc:
+	.byte 3
+	.section .text.a,"aw"
+two_a:
+	.byte 1
+	.section .text.ab,"aw"
+one_ab:
+	.byte 4
+	.section .text.c,"aw"
+two_c:
+	.byte 5
+	.section .data.y,"aw"
+three_y:
+	.byte 7
+	.section .data.x,"aw"
+three_x:
+	.byte 6
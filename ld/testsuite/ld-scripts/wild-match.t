@@ -0,0 +1,7 @@
+SECTIONS
+{
+  .one : { *(.text.ab*) }
+  .two : { *(.text.a .text.b) *(.text.*) }
+  .three : { *(.data.x) *(.dat[a].*) }
+  /DISCARD/ : { *(*) }
+}
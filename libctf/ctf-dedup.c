@@ -149,6 +149,21 @@
    *type hash values*, so it's small: in effect it is automatically
    deduplicated.)
 
+   [ctf_dedup_hash_parallel, ctf_dedup_hash_job, ctf_dedup_merge_job]
+   If the caller has set a parallel-for function with ctf_link_set_parallel_for,
+   the inputs can be hashed concurrently.  Hashing one input never depends on
+   the state left behind by hashing another: cd_type_hashes is keyed by GID, so
+   the entries for one input are only used while hashing that input, and atoms
+   only matter for their pointer identity.  So each job hashes into a scratch
+   dict with its own atoms and hashing tables, and records its calls to the
+   population function rather than making them.  A job covers one input that is
+   not a child, together with all its children, because hashing a child reads
+   (and sets the errno of) its parent.  Once all the jobs are done, their state
+   is merged into the output one job at a time, in input order, re-interning the
+   atoms and replaying the recorded population calls, so that the output
+   mapping, name counts and first GIDs come out exactly as they would if the
+   inputs had been hashed one after another.
+
    2) COLLISIONAL MARKING.
 
    [ctf_dedup_detect_name_ambiguity, ctf_dedup_mark_conflicting_hash]
@@ -1592,54 +1607,68 @@ ctf_dedup_detect_name_ambiguity (ctf_dict_t *fp, ctf_dict_t **inputs)
   return -1; 					/* errno is set for us.  */
 }
 
-/* Initialize the deduplication machinery.  */
+/* Initialize the tables written by the hashing machinery itself, as opposed
+   to its population function.  */
 
 static int
-ctf_dedup_init (ctf_dict_t *fp)
+ctf_dedup_init_hashing (ctf_dict_t *fp)
 {
   ctf_dedup_t *d = &fp->ctf_dedup;
   size_t i;
 
-  if (ctf_dedup_atoms_init (fp) < 0)
-      goto oom;
-
-#if IDS_NEED_ALLOCATION
-  if ((d->cd_id_to_dict_t = ctf_dynhash_create (ctf_hash_type_id_key,
-						ctf_hash_eq_type_id_key,
-						free, NULL)) == NULL)
-    goto oom;
-#endif
-
   for (i = 0; i < 4; i++)
     {
       if ((d->cd_decorated_names[i] = ctf_dynhash_create (ctf_hash_string,
 							  ctf_hash_eq_string,
 							  NULL, NULL)) == NULL)
-	goto oom;
+	return -1;
     }
 
-  if ((d->cd_name_counts
-       = ctf_dynhash_create (ctf_hash_string,
-			     ctf_hash_eq_string, NULL,
-			     (ctf_hash_free_fun) ctf_dynhash_destroy)) == NULL)
-    goto oom;
-
   if ((d->cd_type_hashes
        = ctf_dynhash_create (ctf_hash_integer,
 			     ctf_hash_eq_integer,
 			     NULL, NULL)) == NULL)
-    goto oom;
+    return -1;
 
   if ((d->cd_struct_origin
        = ctf_dynhash_create (ctf_hash_string,
 			     ctf_hash_eq_string,
 			     NULL, NULL)) == NULL)
-    goto oom;
+    return -1;
 
   if ((d->cd_citers
        = ctf_dynhash_create (ctf_hash_string,
 			     ctf_hash_eq_string, NULL,
 			     (ctf_hash_free_fun) ctf_dynset_destroy)) == NULL)
+    return -1;
+
+  return 0;
+}
+
+/* Initialize the deduplication machinery.  */
+
+static int
+ctf_dedup_init (ctf_dict_t *fp)
+{
+  ctf_dedup_t *d = &fp->ctf_dedup;
+
+  if (ctf_dedup_atoms_init (fp) < 0)
+      goto oom;
+
+#if IDS_NEED_ALLOCATION
+  if ((d->cd_id_to_dict_t = ctf_dynhash_create (ctf_hash_type_id_key,
+						ctf_hash_eq_type_id_key,
+						free, NULL)) == NULL)
+    goto oom;
+#endif
+
+  if (ctf_dedup_init_hashing (fp) < 0)
+    goto oom;
+
+  if ((d->cd_name_counts
+       = ctf_dynhash_create (ctf_hash_string,
+			     ctf_hash_eq_string, NULL,
+			     (ctf_hash_free_fun) ctf_dynhash_destroy)) == NULL)
     goto oom;
 
   if ((d->cd_output_mapping
@@ -1882,6 +1911,456 @@ ctf_dedup_conflictify_unshared (ctf_dict_t *output, ctf_dict_t **inputs)
   return ctf_set_errno (output, err);
 }
 
+/* One call to the population function made by a parallel hashing job,
+   recorded so that it can be replayed into the output later.  */
+
+typedef struct ctf_dedup_populate_rec
+{
+  ctf_id_t cdpr_type;
+  void *cdpr_id;
+  const char *cdpr_decorated;
+  const char *cdpr_hval;
+} ctf_dedup_populate_rec_t;
+
+/* The population calls recorded for one input.  */
+
+typedef struct ctf_dedup_populate_log
+{
+  ctf_dedup_populate_rec_t *cdpl_recs;
+  size_t cdpl_nrecs;
+  size_t cdpl_size;
+} ctf_dedup_populate_log_t;
+
+/* The state of a parallel hashing phase.  Job J hashes the inputs from
+   cdhj_first[J] up to (but not including) cdhj_first[J + 1] into the scratch
+   dict cdhj_scratch[J]: the first of these is not a child, and the rest are
+   its children.  */
+
+typedef struct ctf_dedup_hash_jobs
+{
+  ctf_dict_t **cdhj_inputs;
+  uint32_t *cdhj_parents;
+  size_t cdhj_njobs;
+  uint32_t *cdhj_first;
+  ctf_dict_t **cdhj_scratch;
+  int *cdhj_failed;
+  ctf_dedup_populate_log_t *cdhj_logs;
+} ctf_dedup_hash_jobs_t;
+
+/* The population function used by parallel hashing jobs: record the call in
+   the log of this input.  Different jobs never share an input, so no locking
+   is needed.  */
+
+static int
+ctf_dedup_record_populate (ctf_dict_t *fp, ctf_dict_t *input _libctf_unused_,
+			   ctf_dict_t **inputs _libctf_unused_,
+			   int input_num, ctf_id_t type, void *id,
+			   const char *decorated_name, const char *hval)
+{
+  ctf_dedup_populate_log_t *log;
+  ctf_dedup_populate_rec_t *rec;
+
+  log = &fp->ctf_dedup.cd_hash_jobs->cdhj_logs[input_num];
+  if (log->cdpl_nrecs == log->cdpl_size)
+    {
+      size_t size = log->cdpl_size ? log->cdpl_size * 2 : 256;
+      ctf_dedup_populate_rec_t *recs;
+
+      if ((recs = realloc (log->cdpl_recs, size * sizeof (*recs))) == NULL)
+	return ctf_set_errno (fp, ENOMEM);
+      log->cdpl_recs = recs;
+      log->cdpl_size = size;
+    }
+
+  rec = &log->cdpl_recs[log->cdpl_nrecs++];
+  rec->cdpr_type = type;
+  rec->cdpr_id = id;
+  rec->cdpr_decorated = decorated_name;
+  rec->cdpr_hval = hval;
+  return 0;
+}
+
+/* Free a scratch dict used by a parallel hashing job.  Its errors and warnings
+   must already have been moved elsewhere.  */
+
+static void
+ctf_dedup_scratch_free (ctf_dict_t *scratch)
+{
+  if (scratch == NULL)
+    return;
+
+  ctf_dedup_fini (scratch, NULL, 0);
+  ctf_dynset_destroy (scratch->ctf_dedup_atoms_alloc);
+  free (scratch);
+}
+
+/* Create the scratch dict for a parallel hashing job.  Only its dedup state,
+   atoms, errno and error/warning list are ever used.  */
+
+static ctf_dict_t *
+ctf_dedup_scratch_create (ctf_dict_t *output, ctf_dedup_hash_jobs_t *jobs)
+{
+  ctf_dict_t *scratch;
+
+  if ((scratch = calloc (1, sizeof (ctf_dict_t))) == NULL)
+    return NULL;
+
+  scratch->ctf_dedup.cd_link_flags = output->ctf_dedup.cd_link_flags;
+  scratch->ctf_dedup.cd_hash_jobs = jobs;
+
+  if (ctf_dedup_atoms_init (scratch) < 0
+      || ctf_dedup_init_hashing (scratch) < 0)
+    {
+      ctf_dedup_scratch_free (scratch);
+      return NULL;
+    }
+  return scratch;
+}
+
+/* Hash all the types in the inputs of parallel hashing job JOB.  Called via
+   the parallel-for function, possibly on another thread.  */
+
+static void
+ctf_dedup_hash_job (void *data, size_t job)
+{
+  ctf_dedup_hash_jobs_t *jobs = (ctf_dedup_hash_jobs_t *) data;
+  ctf_dict_t *scratch = jobs->cdhj_scratch[job];
+  uint32_t input_num;
+
+  for (input_num = jobs->cdhj_first[job];
+       input_num < jobs->cdhj_first[job + 1]; input_num++)
+    {
+      ctf_dict_t *input = jobs->cdhj_inputs[input_num];
+      ctf_next_t *it = NULL;
+      ctf_id_t id;
+
+      while ((id = ctf_type_next (input, &it, NULL, 1)) != CTF_ERR)
+	{
+	  if (ctf_dedup_hash_type (scratch, input, jobs->cdhj_inputs,
+				   jobs->cdhj_parents, input_num, id, 0, 0,
+				   ctf_dedup_record_populate) == NULL)
+	    {
+	      ctf_next_destroy (it);
+	      jobs->cdhj_failed[job] = 1;
+	      return;				/* errno is set for us.  */
+	    }
+	}
+      if (ctf_errno (input) != ECTF_NEXT_END)
+	{
+	  ctf_set_errno (scratch, ctf_errno (input));
+	  ctf_err_warn (scratch, 0, 0, _("iteration failure "
+					 "computing type hashes"));
+	  jobs->cdhj_failed[job] = 1;
+	  return;
+	}
+    }
+
+  /* Population calls that failed to record anything have set the errno.  */
+  if (ctf_errno (scratch) != 0)
+    jobs->cdhj_failed[job] = 1;
+}
+
+/* Translate an atom of a scratch dict into the corresponding atom of the
+   output, using the XLATE table built by ctf_dedup_merge_job.  Strings that are
+   not atoms, like the fixed hash of type 0, are left alone.  */
+
+static const char *
+ctf_dedup_xlate_atom (ctf_dynhash_t *xlate, const char *atom)
+{
+  const char *out;
+
+  if (atom == NULL)
+    return NULL;
+
+  if ((out = ctf_dynhash_lookup (xlate, atom)) != NULL)
+    return out;
+  return atom;
+}
+
+/* Merge the state left in the scratch dict of parallel hashing job JOB into
+   OUTPUT, as if OUTPUT had hashed the job's inputs itself.  */
+
+static int
+ctf_dedup_merge_job (ctf_dict_t *output, ctf_dedup_hash_jobs_t *jobs,
+		     size_t job)
+{
+  ctf_dedup_t *d = &output->ctf_dedup;
+  ctf_dict_t *scratch = jobs->cdhj_scratch[job];
+  ctf_dedup_t *sd = &scratch->ctf_dedup;
+  ctf_dynhash_t *xlate;
+  ctf_next_t *i = NULL;
+  void *k, *v;
+  uint32_t input_num;
+  int err;
+
+  if ((xlate = ctf_dynhash_create (ctf_hash_integer, ctf_hash_eq_integer,
+				   NULL, NULL)) == NULL)
+    goto oom;
+
+  /* Intern all the atoms of the scratch dict into the output.  */
+  while ((err = ctf_dynset_next (scratch->ctf_dedup_atoms, &i, &k)) == 0)
+    {
+      const void *atom;
+
+      if (!ctf_dynset_exists (output->ctf_dedup_atoms, k, &atom))
+	{
+	  char *copy;
+
+	  if ((copy = strdup (k)) == NULL
+	      || ctf_dynset_insert (output->ctf_dedup_atoms, copy) < 0)
+	    {
+	      free (copy);
+	      ctf_next_destroy (i);
+	      goto oom;
+	    }
+	  atom = copy;
+	}
+      if (ctf_dynhash_cinsert (xlate, k, atom) < 0)
+	{
+	  ctf_next_destroy (i);
+	  goto oom;
+	}
+    }
+  if (err != ECTF_NEXT_END)
+    goto iterr;
+
+  /* Type hashes are keyed by GID, so they cannot collide with those of any
+     other job.  */
+  while ((err = ctf_dynhash_next (sd->cd_type_hashes, &i, &k, &v)) == 0)
+    {
+      if (ctf_dynhash_cinsert (d->cd_type_hashes, k,
+			       ctf_dedup_xlate_atom (xlate, v)) < 0)
+	{
+	  ctf_next_destroy (i);
+	  goto oom;
+	}
+    }
+  if (err != ECTF_NEXT_END)
+    goto iterr;
+
+  /* Replay the population calls, input by input.  */
+  for (input_num = jobs->cdhj_first[job];
+       input_num < jobs->cdhj_first[job + 1]; input_num++)
+    {
+      ctf_dedup_populate_log_t *log = &jobs->cdhj_logs[input_num];
+      size_t j;
+
+      for (j = 0; j < log->cdpl_nrecs; j++)
+	{
+	  ctf_dedup_populate_rec_t *rec = &log->cdpl_recs[j];
+
+	  if (ctf_dedup_populate_mappings
+	      (output, jobs->cdhj_inputs[input_num], jobs->cdhj_inputs,
+	       input_num, rec->cdpr_type, rec->cdpr_id,
+	       ctf_dedup_xlate_atom (xlate, rec->cdpr_decorated),
+	       ctf_dedup_xlate_atom (xlate, rec->cdpr_hval)) < 0)
+	    goto err;				/* errno is set for us.  */
+	}
+      free (log->cdpl_recs);
+      memset (log, 0, sizeof (*log));
+    }
+
+  /* A struct origin recorded by this job is only one of the inputs of this job.
+     If an earlier job saw the same name, the name has several origins.  */
+  while ((err = ctf_dynhash_next (sd->cd_struct_origin, &i, &k, &v)) == 0)
+    {
+      const char *decorated = ctf_dedup_xlate_atom (xlate, k);
+      void *origin = v;
+
+      if (ctf_dynhash_lookup_kv (d->cd_struct_origin, decorated, NULL, NULL))
+	origin = CTF_DEDUP_GID (output, -1, -1);
+
+      if (ctf_dynhash_cinsert (d->cd_struct_origin, decorated, origin) < 0)
+	{
+	  ctf_next_destroy (i);
+	  goto oom;
+	}
+    }
+  if (err != ECTF_NEXT_END)
+    goto iterr;
+
+  while ((err = ctf_dynhash_next (sd->cd_citers, &i, &k, &v)) == 0)
+    {
+      ctf_dynset_t *citers = (ctf_dynset_t *) v;
+      ctf_dynset_t *citer_hashes;
+      ctf_next_t *j = NULL;
+      const void *citer;
+
+      if ((citer_hashes = make_set_element (d->cd_citers,
+					    ctf_dedup_xlate_atom (xlate,
+								  k))) == NULL)
+	{
+	  ctf_next_destroy (i);
+	  goto oom;
+	}
+
+      while ((err = ctf_dynset_cnext (citers, &j, &citer)) == 0)
+	{
+	  if (ctf_dynset_cinsert (citer_hashes,
+				  ctf_dedup_xlate_atom (xlate, citer)) < 0)
+	    {
+	      ctf_next_destroy (j);
+	      ctf_next_destroy (i);
+	      goto oom;
+	    }
+	}
+      if (err != ECTF_NEXT_END)
+	{
+	  ctf_next_destroy (i);
+	  goto iterr;
+	}
+    }
+  if (err != ECTF_NEXT_END)
+    goto iterr;
+
+  ctf_dynhash_destroy (xlate);
+  return 0;
+
+ oom:
+  ctf_set_errno (output, ENOMEM);
+  ctf_err_warn (output, 0, 0, _("out of memory merging type hashes"));
+  ctf_dynhash_destroy (xlate);
+  return -1;
+
+ iterr:
+  ctf_set_errno (output, err);
+  ctf_err_warn (output, 0, 0, _("iteration failure merging type hashes"));
+ err:
+  ctf_dynhash_destroy (xlate);
+  return -1;
+}
+
+/* Hash all the types in all the INPUTS using the parallel-for function of
+   OUTPUT, then merge the results into OUTPUT.  Return 0 on success, -1 on
+   error, or 1 if the inputs cannot be hashed in parallel, in which case
+   nothing has been done.  */
+
+static int
+ctf_dedup_hash_parallel (ctf_dict_t *output, ctf_dict_t **inputs,
+			 uint32_t ninputs, uint32_t *parents)
+{
+  ctf_dedup_hash_jobs_t jobs;
+  uint32_t i;
+  size_t job;
+  int ret = -1;
+
+#ifdef IDS_NEED_ALLOCATION
+  /* GIDs are allocated by the output: a scratch dict would allocate its own.  */
+  return 1;
+#endif
+
+  if (output->ctf_link_parallel_for == NULL || ninputs < 2)
+    return 1;
+
+  memset (&jobs, 0, sizeof (jobs));
+  jobs.cdhj_inputs = inputs;
+  jobs.cdhj_parents = parents;
+
+  if ((jobs.cdhj_first = malloc ((ninputs + 1) * sizeof (uint32_t))) == NULL)
+    goto oom;
+
+  /* Split the inputs into jobs.  Each child must directly follow its parent,
+     or a sibling, so that the job for the parent can hash it too: otherwise,
+     give up and hash serially.  */
+  for (i = 0; i < ninputs; i++)
+    {
+      if (inputs[i]->ctf_flags & LCTF_CHILD && inputs[i]->ctf_parent != NULL)
+	{
+	  if (jobs.cdhj_njobs == 0
+	      || parents[i] != jobs.cdhj_first[jobs.cdhj_njobs - 1]
+	      || inputs[i]->ctf_parent != inputs[parents[i]])
+	    {
+	      free (jobs.cdhj_first);
+	      return 1;
+	    }
+	  continue;
+	}
+      jobs.cdhj_first[jobs.cdhj_njobs++] = i;
+    }
+  jobs.cdhj_first[jobs.cdhj_njobs] = ninputs;
+
+  if (jobs.cdhj_njobs < 2)
+    {
+      free (jobs.cdhj_first);
+      return 1;
+    }
+
+  if ((jobs.cdhj_scratch = calloc (jobs.cdhj_njobs,
+				   sizeof (ctf_dict_t *))) == NULL
+      || (jobs.cdhj_failed = calloc (jobs.cdhj_njobs, sizeof (int))) == NULL
+      || (jobs.cdhj_logs = calloc (ninputs,
+				   sizeof (ctf_dedup_populate_log_t))) == NULL)
+    goto oom;
+
+  for (job = 0; job < jobs.cdhj_njobs; job++)
+    if ((jobs.cdhj_scratch[job] = ctf_dedup_scratch_create (output,
+							    &jobs)) == NULL)
+      goto oom;
+
+  ctf_dprintf ("Hashing %u inputs in %lu parallel jobs\n", ninputs,
+	       (unsigned long) jobs.cdhj_njobs);
+  output->ctf_link_parallel_for (ctf_dedup_hash_job, &jobs, jobs.cdhj_njobs,
+				 output->ctf_link_parallel_for_arg);
+
+  /* Merge in input order, stopping at the first job that failed.  */
+  for (job = 0; job < jobs.cdhj_njobs; job++)
+    {
+      ctf_dict_t *scratch = jobs.cdhj_scratch[job];
+
+      ctf_list_splice (&output->ctf_errs_warnings,
+		       &scratch->ctf_errs_warnings);
+      if (jobs.cdhj_failed[job])
+	{
+	  ctf_set_errno (output, ctf_errno (scratch));
+	  goto out;
+	}
+
+      if (ctf_dedup_merge_job (output, &jobs, job) < 0)
+	goto out;				/* errno is set for us.  */
+
+      ctf_dedup_scratch_free (scratch);
+      jobs.cdhj_scratch[job] = NULL;
+    }
+  ret = 0;
+  goto out;
+
+ oom:
+  ctf_set_errno (output, ENOMEM);
+  ctf_err_warn (output, 0, 0, _("out of memory setting up parallel hashing"));
+ out:
+  if (jobs.cdhj_scratch)
+    for (job = 0; job < jobs.cdhj_njobs; job++)
+      {
+	if (jobs.cdhj_scratch[job] == NULL)
+	  continue;
+	ctf_list_splice (&output->ctf_errs_warnings,
+			 &jobs.cdhj_scratch[job]->ctf_errs_warnings);
+	ctf_dedup_scratch_free (jobs.cdhj_scratch[job]);
+      }
+  if (jobs.cdhj_logs)
+    for (i = 0; i < ninputs; i++)
+      free (jobs.cdhj_logs[i].cdpl_recs);
+  free (jobs.cdhj_logs);
+  free (jobs.cdhj_failed);
+  free (jobs.cdhj_scratch);
+  free (jobs.cdhj_first);
+  return ret;
+}
+
+/* Report the time since *START taken by a deduplication PHASE, if debugging,
+   and reset *START.  */
+
+static void
+ctf_dedup_phase_time (const char *phase, long *start)
+{
+  long now = get_run_time ();
+  long taken = now - *start;
+
+  ctf_dprintf ("%s took %ld.%06ld seconds of CPU time\n", phase,
+	       taken / 1000000, taken % 1000000);
+  *start = now;
+}
+
 /* The core deduplicator.  Populate cd_output_mapping in the output ctf_dedup
    with a mapping of all types that belong in this dictionary and where they
    come from, and cd_conflicting_types with an indication of whether each type
@@ -1903,6 +2382,8 @@ ctf_dedup (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
   ctf_dedup_t *d = &output->ctf_dedup;
   size_t i;
   ctf_next_t *it = NULL;
+  long start = get_run_time ();
+  int serial;
 
   if (ctf_dedup_init (output) < 0)
     return -1; 					/* errno is set for us.  */
@@ -1937,7 +2418,11 @@ ctf_dedup (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
      IDs in cd_output_mapping.  */
 
   ctf_dprintf ("Computing type hashes\n");
-  for (i = 0; i < ninputs; i++)
+  if ((serial = ctf_dedup_hash_parallel (output, inputs, ninputs,
+					 parents)) < 0)
+    goto err;					/* errno is set for us.  */
+
+  for (i = 0; serial && i < ninputs; i++)
     {
       ctf_id_t id;
 
@@ -1956,6 +2441,7 @@ ctf_dedup (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
 	  goto err;
 	}
     }
+  ctf_dedup_phase_time ("Type hashing", &start);
 
   /* Go through the cd_name_counts name->hash->count mapping for all CTF
      namespaces: any name with many hashes associated with it at this stage is
@@ -1965,6 +2451,7 @@ ctf_dedup (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
   ctf_dprintf ("Detecting type name ambiguity\n");
   if (ctf_dedup_detect_name_ambiguity (output, inputs) < 0)
       goto err;					/* errno is set for us.  */
+  ctf_dedup_phase_time ("Name ambiguity detection", &start);
 
   /* If the link mode is CTF_LINK_SHARE_DUPLICATED, we change any unconflicting
      types whose output mapping references only one input dict into a
@@ -1975,6 +2462,7 @@ ctf_dedup (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
       ctf_dprintf ("Conflictifying unshared types\n");
       if (ctf_dedup_conflictify_unshared (output, inputs) < 0)
 	goto err;				/* errno is set for us.  */
+      ctf_dedup_phase_time ("Conflictifying unshared types", &start);
     }
   return 0;
 
@@ -3074,15 +3562,18 @@ ctf_dedup_emit (ctf_dict_t *output, ctf_dict_t **inputs, uint32_t ninputs,
   ctf_dict_t **outputs;
   ctf_dict_t **walk;
   size_t i;
+  long start = get_run_time ();
 
   ctf_dprintf ("Triggering emission.\n");
   if (ctf_dedup_walk_output_mapping (output, inputs, ninputs, parents,
 				     ctf_dedup_emit_type, &cu_mapped) < 0)
     return NULL;				/* errno is set for us.  */
+  ctf_dedup_phase_time ("Type emission", &start);
 
   ctf_dprintf ("Populating struct members.\n");
   if (ctf_dedup_emit_struct_members (output, inputs, ninputs, parents) < 0)
     return NULL;				/* errno is set for us.  */
+  ctf_dedup_phase_time ("Struct member emission", &start);
 
   for (i = 0; i < ninputs; i++)
     {
@@ -351,6 +351,10 @@ typedef struct ctf_dedup
   /* Points to the output counterpart of this input dictionary, at emission
      time.  */
   ctf_dict_t *cd_output;
+
+  /* In the scratch dict of a parallel hashing job, the state of the parallel
+     hashing phase, where the calls to the population function are recorded.  */
+  struct ctf_dedup_hash_jobs *cd_hash_jobs;
 } ctf_dedup_t;
 
 /* The ctf_dict is the structure used to represent a CTF dictionary to library
@@ -480,6 +484,10 @@ struct ctf_dict
   ctf_link_variable_filter_f *ctf_link_variable_filter;
   void *ctf_link_variable_filter_arg;           /* Argument for it. */
 
+  /* Allow the caller to run parts of the link on several threads.  */
+  ctf_link_parallel_for_f *ctf_link_parallel_for;
+  void *ctf_link_parallel_for_arg;              /* Argument for it. */
+
   ctf_dynhash_t *ctf_add_processing; /* Types ctf_add_type is working on now.  */
 
   /* Atoms table for dedup string storage.  All strings in the ctf_dedup_t are
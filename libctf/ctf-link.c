@@ -471,6 +471,18 @@ ctf_link_set_variable_filter (ctf_dict_t *fp, ctf_link_variable_filter_f *filter
   return 0;
 }
 
+/* Set a function which is used to run independent pieces of the link, such as
+   the hashing of each input's types during deduplication, on several threads.
+   Without one, everything is done on the calling thread.  */
+int
+ctf_link_set_parallel_for (ctf_dict_t *fp, ctf_link_parallel_for_f *parallel_for,
+			   void *arg)
+{
+  fp->ctf_link_parallel_for = parallel_for;
+  fp->ctf_link_parallel_for_arg = arg;
+  return 0;
+}
+
 /* Check if we can safely add a variable with the given type to this dict.  */
 
 static int
@@ -1217,6 +1229,8 @@ ctf_link_deduplicating_per_cu (ctf_dict_t *fp)
 
       /* Share the atoms table to reduce memory usage.  */
       out->ctf_dedup_atoms = fp->ctf_dedup_atoms_alloc;
+      out->ctf_link_parallel_for = fp->ctf_link_parallel_for;
+      out->ctf_link_parallel_for_arg = fp->ctf_link_parallel_for_arg;
 
       /* No ctf_imports at this stage: this per-CU dictionary has no parents.
 	 Parent/child deduplication happens in the link's final pass.  However,
@@ -0,0 +1,5 @@
+struct shared { int a; long b; };
+struct conflicting { int c; };
+
+struct shared a_shared;
+struct conflicting a_conflicting;
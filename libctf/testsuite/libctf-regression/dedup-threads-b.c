@@ -0,0 +1,5 @@
+struct shared { int a; long b; };
+struct conflicting { long c; };
+
+struct shared b_shared;
+struct conflicting b_conflicting;
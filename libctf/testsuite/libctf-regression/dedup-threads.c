@@ -0,0 +1,66 @@
+#include <ctf-api.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Deduplicate on several threads, and make sure that shared types still end
+   up in the parent and conflicting ones in the per-CU children.  */
+
+int
+main (int argc, char *argv[])
+{
+  ctf_dict_t *fp;
+  ctf_archive_t *ctf;
+  ctf_next_t *i = NULL;
+  ctf_id_t type;
+  const char *arcname;
+  int err;
+
+  if (argc != 2)
+    {
+      fprintf (stderr, "Syntax: %s PROGRAM\n", argv[0]);
+      exit(1);
+    }
+
+  if ((ctf = ctf_open (argv[1], NULL, &err)) == NULL)
+    goto open_err;
+
+  while ((fp = ctf_archive_next (ctf, &i, &arcname, 0, &err)) != NULL)
+    {
+      if ((type = ctf_lookup_by_name (fp, "struct shared")) != CTF_ERR
+	  && !ctf_type_isparent (fp, type))
+	goto shared_in_child;
+
+      if (!ctf_parent_name (fp))
+	{
+	  if (type == CTF_ERR)
+	    goto err;
+	  printf ("%s: struct shared has size %zi\n", arcname,
+		  ctf_type_size (fp, type));
+	}
+      else
+	{
+	  if ((type = ctf_lookup_by_name (fp, "struct conflicting")) == CTF_ERR)
+	    goto err;
+	  printf ("%s: struct conflicting has size %zi\n", arcname,
+		  ctf_type_size (fp, type));
+	}
+
+      ctf_dict_close (fp);
+    }
+  if (err != ECTF_NEXT_END)
+    goto open_err;
+
+  ctf_close (ctf);
+
+  return 0;
+
+ open_err:
+  fprintf (stderr, "%s: cannot open: %s\n", argv[0], ctf_errmsg (err));
+  return 1;
+ err:
+  fprintf (stderr, "Lookup failed in %s: %s\n", arcname, ctf_errmsg (ctf_errno (fp)));
+  return 1;
+ shared_in_child:
+  fprintf (stderr, "struct shared unexpectedly found in child %s\n", arcname);
+  return 1;
+}
@@ -147,9 +147,10 @@ dnl to see if there are intl libraries we should link against.
 ALL_LINGUAS=
 ZW_GNU_GETTEXT_SISTER_DIR
 
-dnl BFD conditionally uses zlib, so we must link it in if libbfd does, by
-dnl using the same condition.
+dnl BFD conditionally uses zlib and zstd, so we must link them in if libbfd
+dnl does, by using the same conditions.
 AM_ZLIB
+AC_ZSTD
 
 dnl BFD uses libdl when when plugins enabled.
 AC_PLUGINS